@@ -47,14 +47,20 @@ Canvas::Canvas(Gdk::RGBA _background_color) :
   selected_plot(nullptr),
   inside_plot(nullptr),
   inside_plot_current_coords{0.0, 0.0},
-  background_color(_background_color) {
+  background_color(_background_color),
+  redraw_all(false),
+  crosshair_plot(nullptr),
+  crosshair_cairo{-1.0, -1.0},
+  updates_frozen(0),
+  changed_pending(false) {
 
   add_events(Gdk::POINTER_MOTION_MASK |
              Gdk::BUTTON_PRESS_MASK |
              Gdk::BUTTON_RELEASE_MASK |
              Gdk::SCROLL_MASK |
              Gdk::KEY_PRESS_MASK |
-             Gdk::KEY_RELEASE_MASK
+             Gdk::KEY_RELEASE_MASK |
+             Gdk::LEAVE_NOTIFY_MASK
            );
 
   set_can_focus(true);
@@ -102,9 +108,9 @@ void Canvas::add_plot(Plot &plot) {
   plots.push_back(&plot);
 
   // ensure plot signal_changed gets re-emitted by the canvas
-  plots.back()->signal_changed().connect([this](){_signal_changed.emit();});
+  plots.back()->signal_changed().connect([this](){notify_changed();});
 
-  _signal_changed.emit();
+  notify_changed();
 }
 
 Canvas::~Canvas() {
@@ -118,7 +124,40 @@ Canvas::~Canvas() {
 void Canvas::on_changed() {
   //this catches all signal_changed emissions recursively from the Plot and PlotData classes
   //so this is the method that ensures things get redrawn when one of the parameters is changed.
-  this->queue_draw();
+  if (redraw_all) {
+    redraw_all = false;
+    this->queue_draw();
+    return;
+  }
+
+  //plots that changed have lost their cached image: limit the redraw to their areas
+  Gtk::Allocation allocation = get_allocation();
+  const int width = allocation.get_width();
+  const int height = allocation.get_height();
+  bool plot_queued = false, plot_hidden = false;
+
+  for (auto &iter : plots) {
+    if (iter->cache_valid)
+      continue;
+
+    //hidden plots have nothing to draw: their area needs to be cleared only once, after which their cached image can be dropped.
+    //their cache is marked valid to ensure that they are skipped here until they are modified again
+    if (!iter->is_showing()) {
+      iter->cache_valid = true;
+      plot_hidden = true;
+      if (!iter->cache_surface)
+        continue;
+      iter->cache_surface = Cairo::RefPtr<Cairo::ImageSurface>();
+    }
+
+    int x, y, w, h;
+    iter->get_plot_area(width, height, x, y, w, h);
+    this->queue_draw_area(x, y, w, h);
+    plot_queued = true;
+  }
+
+  if (!plot_queued && !plot_hidden)
+    this->queue_draw();
 }
 
 bool Canvas::on_draw(const Cairo::RefPtr<Cairo::Context>& cr) {
@@ -126,8 +165,30 @@ bool Canvas::on_draw(const Cairo::RefPtr<Cairo::Context>& cr) {
   const int width = allocation.get_width();
   const int height = allocation.get_height();
 
-  draw_plot(cr, width, height);
+  //start by drawing the background...
+  cr->rectangle(0.0, 0.0, width, height);
+  Gdk::Cairo::set_source_rgba(cr, background_color);
+  cr->fill();
+
+  //...followed by the plots, which will only go through PLplot if they changed since the last draw.
+  //plots outside of the area that needs redrawing are skipped altogether
+  double clip_x1, clip_y1, clip_x2, clip_y2;
+  cr->get_clip_extents(clip_x1, clip_y1, clip_x2, clip_y2);
 
+  for (auto &iter : plots) {
+    int x, y, w, h;
+    iter->get_plot_area(width, height, x, y, w, h);
+    if (x >= clip_x2 || y >= clip_y2 || x + w <= clip_x1 || y + h <= clip_y1)
+      continue;
+    iter->draw_plot_cached(cr, width, height);
+  }
+
+  draw_overlay(cr, width, height);
+
+  return true;
+}
+
+void Canvas::draw_overlay(const Cairo::RefPtr<Cairo::Context> &cr, int width, int height) {
   if (selecting &&
     start_cairo[0] >= 0.0 &&
     start_cairo[1] >= 0.0 &&
@@ -145,6 +206,18 @@ bool Canvas::on_draw(const Cairo::RefPtr<Cairo::Context>& cr) {
     cr->stroke();
   }
 
+  if (crosshair_plot != nullptr) {
+    RegionSelection *region_selection = dynamic_cast<RegionSelection *>(crosshair_plot);
+
+    cr->set_line_width(region_selection->get_region_crosshair_width());
+    Gdk::Cairo::set_source_rgba(cr, region_selection->get_region_crosshair_color());
+    cr->move_to(crosshair_cairo[0], height - region_selection->cairo_range_y[1]);
+    cr->line_to(crosshair_cairo[0], height - region_selection->cairo_range_y[0]);
+    cr->move_to(region_selection->cairo_range_x[0], height - crosshair_cairo[1]);
+    cr->line_to(region_selection->cairo_range_x[1], height - crosshair_cairo[1]);
+    cr->stroke();
+  }
+
   if (has_focus()) {
     cr->save();
 
@@ -154,8 +227,43 @@ bool Canvas::on_draw(const Cairo::RefPtr<Cairo::Context>& cr) {
 
     cr->restore();
   }
+}
 
-  return true;
+void Canvas::queue_draw_overlay() {
+  Gtk::Allocation allocation = get_allocation();
+  const int height = allocation.get_height();
+
+  if (selecting &&
+    start_cairo[0] >= 0.0 &&
+    start_cairo[1] >= 0.0 &&
+    end_cairo[0] >= 0.0 &&
+    end_cairo[1] >= 0.0) {
+
+    RegionSelection *region_selection = dynamic_cast<RegionSelection *>(selected_plot);
+    const double margin = region_selection->get_region_selection_width() / 2.0 + 1.0;
+
+    const double x = MIN(start_cairo[0], end_cairo[0]) - margin;
+    const double y = MIN(height - start_cairo[1], height - end_cairo[1]) - margin;
+    this->queue_draw_area(floor(x), floor(y),
+                          ceil(fabs(end_cairo[0] - start_cairo[0]) + 2.0 * margin) + 1,
+                          ceil(fabs(end_cairo[1] - start_cairo[1]) + 2.0 * margin) + 1);
+  }
+
+  if (crosshair_plot != nullptr) {
+    RegionSelection *region_selection = dynamic_cast<RegionSelection *>(crosshair_plot);
+    const double margin = region_selection->get_region_crosshair_width() / 2.0 + 1.0;
+
+    // vertical line
+    this->queue_draw_area(floor(crosshair_cairo[0] - margin),
+                          floor(height - region_selection->cairo_range_y[1] - margin),
+                          ceil(2.0 * margin) + 1,
+                          ceil(region_selection->cairo_range_y[1] - region_selection->cairo_range_y[0] + 2.0 * margin) + 1);
+    // horizontal line
+    this->queue_draw_area(floor(region_selection->cairo_range_x[0] - margin),
+                          floor(height - crosshair_cairo[1] - margin),
+                          ceil(region_selection->cairo_range_x[1] - region_selection->cairo_range_x[0] + 2.0 * margin) + 1,
+                          ceil(2.0 * margin) + 1);
+  }
 }
 
 void Canvas::draw_plot(const Cairo::RefPtr<Cairo::Context> &cr, int width, int height) {
@@ -251,6 +359,9 @@ bool Canvas::on_button_release_event(GdkEventButton *event) {
   else if (!selecting)
     return false;
 
+  //the selection box is about to disappear
+  queue_draw_overlay();
+
   Gtk::Allocation allocation = get_allocation();
   const int height = allocation.get_height();
 
@@ -313,9 +424,6 @@ bool Canvas::on_button_release_event(GdkEventButton *event) {
   end_plplot_def[0] = MAX(start_plplot[0], end_plplot[0]);
   end_plplot_def[1] = MAX(start_plplot[1], end_plplot[1]);
 
-  //this is necessary to get rid of the box on the plot, even if the signal_select_region is not caught by the plot
-  _signal_changed.emit();
-
   double start_world[2];
   double end_world[2];
 
@@ -347,6 +455,10 @@ bool Canvas::on_motion_notify_event (GdkEventMotion *event) {
   Gtk::Allocation allocation = get_allocation();
   const int height = allocation.get_height();
 
+  //the selection box and the crosshair will move: invalidate their current position
+  queue_draw_overlay();
+  crosshair_plot = nullptr;
+
   end_event[0] = event->x;
   end_event[1] = event->y;
   end_cairo[0] = event->x;
@@ -382,6 +494,12 @@ bool Canvas::on_motion_notify_event (GdkEventMotion *event) {
 
       inside_plot = *plot;
 
+      if (region_selection->get_region_crosshair()) {
+        crosshair_plot = *plot;
+        crosshair_cairo[0] = end_cairo[0];
+        crosshair_cairo[1] = end_cairo[1];
+      }
+
       // change cursor to crosshair or system default if necessary
       const Glib::RefPtr<Gdk::Window> window = get_window();
       if (window) {
@@ -422,8 +540,10 @@ bool Canvas::on_motion_notify_event (GdkEventMotion *event) {
   }
 
   // if not dragging a selection box, stop here
-  if (!selecting)
+  if (!selecting) {
+    queue_draw_overlay();
     return false;
+  }
 
   RegionSelection *region_selection = dynamic_cast<RegionSelection *>(selected_plot);
 
@@ -446,11 +566,19 @@ bool Canvas::on_motion_notify_event (GdkEventMotion *event) {
     end_cairo[1] = MAX(end_cairo[1], region_selection->cairo_range_y[0]);
   }
 
-  _signal_changed.emit();
+  //only the overlay needs to be redrawn, the plots remain untouched
+  queue_draw_overlay();
 
   return true;
 }
 
+bool Canvas::on_leave_notify_event(GdkEventCrossing *event) {
+  queue_draw_overlay();
+  crosshair_plot = nullptr;
+
+  return false;
+}
+
 bool Canvas::on_key_press_event(GdkEventKey *event) {
 
   if (inside_plot == nullptr || selecting)
@@ -505,6 +633,35 @@ bool Canvas::on_key_release_event(GdkEventKey *event) {
   return false;
 }
 
+void Canvas::notify_changed() {
+  if (updates_frozen > 0) {
+    changed_pending = true;
+    return;
+  }
+  _signal_changed.emit();
+}
+
+void Canvas::freeze_updates() {
+  updates_frozen++;
+}
+
+void Canvas::thaw_updates() {
+  if (updates_frozen == 0)
+    throw Exception("Gtk::PLplot::Canvas::thaw_updates -> updates are not frozen");
+
+  if (--updates_frozen > 0)
+    return;
+
+  if (changed_pending) {
+    changed_pending = false;
+    _signal_changed.emit();
+  }
+}
+
+bool Canvas::get_updates_frozen() const {
+  return updates_frozen > 0;
+}
+
 Plot* Canvas::get_plot(unsigned int index) {
   if (index < plots.size()) {
     return plots[index];
@@ -518,7 +675,8 @@ Gdk::RGBA Canvas::get_background_color() {
 
 void Canvas::set_background_color(Gdk::RGBA _background_color) {
   background_color = _background_color;
-  _signal_changed.emit();
+  redraw_all = true;
+  notify_changed();
 }
 
 void Canvas::remove_plot(unsigned int index) {
@@ -528,10 +686,14 @@ void Canvas::remove_plot(unsigned int index) {
   if (index >= plots.size())
     throw Exception("Gtk::PLplot::Canvas::remove_plot -> Invalid index");
 
+  if (crosshair_plot == plots[index])
+    crosshair_plot = nullptr;
+
   delete plots[index];
 
   plots.erase(plots.begin() + index);
-  _signal_changed.emit();
+  redraw_all = true;
+  notify_changed();
 }
 
 void Canvas::remove_plot(Plot &plot) {
@@ -542,9 +704,13 @@ void Canvas::remove_plot(Plot &plot) {
   if (iter == plots.end())
     throw Exception("Gtk::PLplot::Canvas::remove_plot -> No match for input");
 
+  if (crosshair_plot == *iter)
+    crosshair_plot = nullptr;
+
   if ((*iter)->is_managed_())
     delete *iter;
 
   plots.erase(iter);
-  _signal_changed.emit();
+  redraw_all = true;
+  notify_changed();
 }
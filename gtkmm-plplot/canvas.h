@@ -65,6 +65,32 @@ namespace Gtk {
       Plot *inside_plot; ///< \c pointer to the plot that currently contains the mouse cursor. It will be set to nullptr when it is not above a plot.
       double inside_plot_current_coords[2]; ///< coords of the current cursor position within inside_plot, updated in on_motion_notify_event();
       Gdk::RGBA background_color; ///< the currently used background color of the canvas (default = opaque White)
+      bool redraw_all; ///< set to true when a change affects the complete canvas, instead of just the areas covered by plots that were modified
+      Plot *crosshair_plot; ///< pointer to the plot on which the crosshair is currently drawn, nullptr if no crosshair is shown
+      double crosshair_cairo[2]; ///< cairo coordinates of the crosshair center
+      unsigned int updates_frozen; ///< the number of freeze_updates() calls that have not been matched by thaw_updates() yet
+      bool changed_pending; ///< \c true when signal_changed was postponed because updates were frozen
+
+      /** Draw the overlay on top of the plots
+       *
+       * The overlay consists of the selection box, the crosshair and the focus ring.
+       * These are drawn on top of the (cached) plot images, so they can be moved around without redrawing the plots.
+       * \param cr The cairo context to draw to.
+       * \param width the width of the Canvas widget
+       * \param height the height of the Canvas widget
+       */
+      void draw_overlay(const Cairo::RefPtr<Cairo::Context> &cr, int width, int height);
+
+      /** Emit signal_changed, or postpone it while updates are frozen
+       *
+       */
+      void notify_changed();
+
+      /** Queue a redraw of the areas currently covered by the selection box and the crosshair
+       *
+       */
+      void queue_draw_overlay();
+
       Canvas(const Canvas &) = delete; ///< no copy constructor
       Canvas &operator=(const Canvas &) = delete; ///< no move assignment operator
     protected:
@@ -103,6 +129,15 @@ namespace Gtk {
        */
       virtual bool on_motion_notify_event(GdkEventMotion *event) override;
 
+      /** This is a default handler for signal_leave_notify_event().
+       *
+       * This method removes the crosshair when the mouse leaves the widget.
+       * \param event The GdkEventCrossing which triggered this signal.
+       * \return \c true to stop other handlers from being invoked for the event. \c false to propagate the event further
+       * \since 2.4
+       */
+      virtual bool on_leave_notify_event(GdkEventCrossing *event) override;
+
       /** This is a default handler for signal_scroll_event().
        *
        * This method tracks the scroll movement that may be used to trigger a zoom-in or zoom-out event on a particular plot.
@@ -136,7 +171,9 @@ namespace Gtk {
       /** This is a default handler for signal_changed().
        *
        * This signal is emitted whenever any of the canvas properties changes, or any of the properties of the plots contained therein.
-       * This default handler does one thing only: asking for a redraw of the complete canvas.
+       * This default handler does one thing only: asking for a redraw. If the change originated from one or more plots,
+       * only the areas covered by these plots will be redrawn, while all other plots are painted from their cached images.
+       * Otherwise the complete canvas is redrawn.
        */
       virtual void on_changed();
     public:
@@ -168,7 +205,9 @@ namespace Gtk {
        * Enables drawing the canvas and its plot(s) onto a particular cairo context,
        * whose surface is not necessarily connected to a widget.
        * Use this method if you want to write to PNG, EPS, PDF etc. files or if
-       * you would like to send this to a print job
+       * you would like to send this to a print job.
+       * Unlike the drawing of the widget itself, which reuses cached images of plots that did not change,
+       * this method always renders all plots from scratch to preserve vector output.
        */
       void draw_plot(const Cairo::RefPtr<Cairo::Context> &cr, int width, int height);
 
@@ -202,6 +241,27 @@ namespace Gtk {
         return _signal_changed;
       }
 
+      /** Postpone the emission of signal_changed
+       *
+       * Use this method before making several changes to the canvas or its plots.
+       * signal_changed will be emitted at most once when the matching thaw_updates() is called, resulting in a single redraw request.
+       * Calls may be nested. Consider using UpdateGuard to ensure that every freeze is matched by a thaw.
+       */
+      void freeze_updates();
+
+      /** Emit signal_changed if it was postponed since freeze_updates() was called
+       *
+       * The signal is only emitted when this call matches the outermost freeze_updates() call.
+       * \exception Gtk::PLplot::Exception
+       */
+      void thaw_updates();
+
+      /** Returns whether updates are currently frozen
+       *
+       * \return \c true if freeze_updates() was called more often than thaw_updates(), \c false if not
+       */
+      bool get_updates_frozen() const;
+
       /** Get a pointer to a plot included in the canvas
        *
        * \param plot_index index of the plot in the \c plots vector
@@ -0,0 +1,576 @@
+/*
+Copyright (C) 2016 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtkmm-plplot/contourline.h>
+#include <glibmm/ustring.h>
+#include <gtkmm-plplot/exception.h>
+#include <unordered_map>
+#include <utility>
+#include <limits>
+#include <cmath>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+using namespace Gtk::PLplot;
+
+#define CONTOUR_LINE_NO_EDGE std::numeric_limits<std::size_t>::max()
+
+// the edges of the grid that are crossed by a contour level, with the (at most two) edges they are connected to through the cells on either side.
+// horizontal edges, between (i, j) and (i + 1, j), have id 2 * (i * ny + j), while vertical edges, between (i, j) and (i, j + 1), have id 2 * (i * ny + j) + 1.
+class ContourGraphNode {
+public:
+  std::size_t next[2];
+  bool visited;
+
+  ContourGraphNode() : next{CONTOUR_LINE_NO_EDGE, CONTOUR_LINE_NO_EDGE}, visited(false) {}
+};
+
+typedef std::unordered_map<std::size_t, ContourGraphNode> ContourGraph;
+
+static void connect_edges(ContourGraph &graph, std::size_t edge1, std::size_t edge2) {
+  ContourGraphNode &node1 = graph[edge1];
+  node1.next[node1.next[0] == CONTOUR_LINE_NO_EDGE ? 0 : 1] = edge2;
+  ContourGraphNode &node2 = graph[edge2];
+  node2.next[node2.next[0] == CONTOUR_LINE_NO_EDGE ? 0 : 1] = edge1;
+}
+
+// find the point where the level crosses an edge, by linear interpolation between its endpoints
+static void edge_vertex(const StridedArray2D &z, const std::vector<double> &x, const std::vector<double> &y,
+                        double level, std::size_t edge, double &xv, double &yv) {
+  const std::size_t ny = y.size();
+  const std::size_t i = (edge / 2) / ny;
+  const std::size_t j = (edge / 2) % ny;
+
+  if (edge % 2 == 0) {
+    const double t = (level - z(i, j)) / (z(i + 1, j) - z(i, j));
+    xv = x[i] + t * (x[i + 1] - x[i]);
+    yv = y[j];
+  }
+  else {
+    const double t = (level - z(i, j)) / (z(i, j + 1) - z(i, j));
+    xv = x[i];
+    yv = y[j] + t * (y[j + 1] - y[j]);
+  }
+}
+
+// follow the connections starting from edge start, and turn them into a ContourFragment
+static void walk_contour_line(const StridedArray2D &z, const std::vector<double> &x, const std::vector<double> &y,
+                              double level, std::size_t level_index, ContourGraph &graph, std::size_t start,
+                              std::vector<ContourFragment> &fragments) {
+  std::vector<double> xv, yv;
+  std::size_t previous = CONTOUR_LINE_NO_EDGE;
+  std::size_t current = start;
+  bool closed = false;
+
+  while (true) {
+    ContourGraphNode &node = graph[current];
+    node.visited = true;
+
+    double xp, yp;
+    edge_vertex(z, x, y, level, current, xp, yp);
+    xv.push_back(xp);
+    yv.push_back(yp);
+
+    std::size_t next = CONTOUR_LINE_NO_EDGE;
+    for (int k = 0 ; k < 2 ; k++) {
+      const std::size_t candidate = node.next[k];
+      if (candidate == CONTOUR_LINE_NO_EDGE || candidate == previous)
+        continue;
+      if (graph[candidate].visited) {
+        // back at the start: the polyline is a loop
+        if (candidate == start && xv.size() > 2)
+          closed = true;
+        continue;
+      }
+      next = candidate;
+      break;
+    }
+
+    if (next == CONTOUR_LINE_NO_EDGE)
+      break;
+
+    previous = current;
+    current = next;
+  }
+
+  if (closed) {
+    xv.push_back(xv.front());
+    yv.push_back(yv.front());
+  }
+
+  fragments.emplace_back(level, level_index, std::move(xv), std::move(yv), start, current, closed);
+}
+
+// trace a level through the cells (i, j) with i in [i_first, i_last) and j in [j_first, j_last)
+static void trace_cells(const StridedArray2D &z, const std::vector<double> &x, const std::vector<double> &y,
+                        double level, std::size_t level_index,
+                        std::size_t i_first, std::size_t i_last, std::size_t j_first, std::size_t j_last,
+                        std::vector<ContourFragment> &fragments) {
+  const std::size_t ny = y.size();
+  ContourGraph graph;
+
+  for (std::size_t i = i_first ; i < i_last ; i++) {
+    for (std::size_t j = j_first ; j < j_last ; j++) {
+      // the corners of the cell, counterclockwise
+      const double za = z(i, j);
+      const double zb = z(i + 1, j);
+      const double zc = z(i + 1, j + 1);
+      const double zd = z(i, j + 1);
+
+      if (std::isnan(za) || std::isnan(zb) || std::isnan(zc) || std::isnan(zd))
+        continue;
+
+      const bool a = za >= level;
+      const bool b = zb >= level;
+      const bool c = zc >= level;
+      const bool d = zd >= level;
+
+      // the edges of the cell: bottom, right, top and left
+      const std::size_t edges[4] = {
+        2 * (i * ny + j),
+        2 * ((i + 1) * ny + j) + 1,
+        2 * (i * ny + j + 1),
+        2 * (i * ny + j) + 1
+      };
+      const bool crossed[4] = {a != b, b != c, d != c, a != d};
+
+      std::size_t crossings[4];
+      int ncrossings = 0;
+      for (int k = 0 ; k < 4 ; k++) {
+        if (crossed[k])
+          crossings[ncrossings++] = edges[k];
+      }
+
+      if (ncrossings == 2) {
+        connect_edges(graph, crossings[0], crossings[1]);
+      }
+      else if (ncrossings == 4) {
+        // saddle point: use the value in the center of the cell to decide which corners are connected
+        const bool center = (za + zb + zc + zd) / 4.0 >= level;
+        if (center == a) {
+          // a and c are connected through the center: cut off b and d
+          connect_edges(graph, edges[0], edges[1]);
+          connect_edges(graph, edges[2], edges[3]);
+        }
+        else {
+          // b and d are connected through the center: cut off a and c
+          connect_edges(graph, edges[3], edges[0]);
+          connect_edges(graph, edges[1], edges[2]);
+        }
+      }
+    }
+  }
+
+  // open polylines start at an edge with a single connection
+  for (auto &node : graph) {
+    if (!node.second.visited && node.second.next[1] == CONTOUR_LINE_NO_EDGE)
+      walk_contour_line(z, x, y, level, level_index, graph, node.first, fragments);
+  }
+
+  // whatever remains consists of closed loops
+  for (auto &node : graph) {
+    if (!node.second.visited)
+      walk_contour_line(z, x, y, level, level_index, graph, node.first, fragments);
+  }
+}
+
+// append the vertices of fragment to the end of a polyline, walking it backwards if reversed is true. The vertex they have in common is included only once.
+static void append_fragment(std::vector<double> &x, std::vector<double> &y, const ContourFragment &fragment, bool reversed) {
+  const std::vector<double> &fx = fragment.get_x();
+  const std::vector<double> &fy = fragment.get_y();
+
+  if (reversed) {
+    x.insert(x.end(), fx.rbegin() + 1, fx.rend());
+    y.insert(y.end(), fy.rbegin() + 1, fy.rend());
+  }
+  else {
+    x.insert(x.end(), fx.begin() + 1, fx.end());
+    y.insert(y.end(), fy.begin() + 1, fy.end());
+  }
+}
+
+// join the fragments of a single level that were traced in different tiles: their ends meet at edges on the boundaries between the tiles.
+// each such edge is shared by exactly two cells, so it is touched by exactly two fragment ends, one from the tile on either side.
+template<typename OnBoundary>
+static void stitch_level(double level, const std::vector<const ContourFragment *> &fragments, OnBoundary on_boundary,
+                         std::vector<ContourLine> &lines) {
+  std::vector<bool> used(fragments.size(), false);
+
+  auto fragment_edge = [&fragments](std::size_t f, bool last) {
+    return last ? fragments[f]->get_last_edge() : fragments[f]->get_first_edge();
+  };
+
+  // for each boundary edge, the fragment ends that touch it: fragment index times 2, plus 1 for the last vertex
+  std::unordered_map<std::size_t, std::pair<std::size_t, std::size_t>> ends;
+  for (std::size_t f = 0 ; f < fragments.size() ; f++) {
+    if (fragments[f]->is_closed())
+      continue;
+    for (int k = 0 ; k < 2 ; k++) {
+      const std::size_t edge = fragment_edge(f, k == 1);
+      if (!on_boundary(edge))
+        continue;
+      auto it = ends.find(edge);
+      if (it == ends.end())
+        ends.emplace(edge, std::make_pair(2 * f + k, CONTOUR_LINE_NO_EDGE));
+      else
+        it->second.second = 2 * f + k;
+    }
+  }
+
+  // the fragment end at the other side of the boundary edge that the given fragment end lies on, if any
+  auto counterpart = [&](std::size_t f, bool last) {
+    const std::size_t edge = fragment_edge(f, last);
+    if (!on_boundary(edge))
+      return CONTOUR_LINE_NO_EDGE;
+    auto it = ends.find(edge);
+    const std::size_t self = 2 * f + (last ? 1 : 0);
+    return it->second.first == self ? it->second.second : it->second.first;
+  };
+
+  // keep on appending the fragments connected to the far end of the polyline. Returns true if the polyline turns out to be a loop.
+  auto follow = [&](std::size_t f, bool reversed, std::vector<double> &x, std::vector<double> &y) {
+    while (true) {
+      const std::size_t other = counterpart(f, !reversed);
+      if (other == CONTOUR_LINE_NO_EDGE)
+        return false;
+      f = other / 2;
+      if (used[f])
+        return true;
+      used[f] = true;
+      // entering through the last vertex means the fragment has to be walked backwards
+      reversed = other % 2 == 1;
+      append_fragment(x, y, *fragments[f], reversed);
+    }
+  };
+
+  // closed loops within a single tile, and open polylines starting from a fragment end without counterpart
+  for (std::size_t f = 0 ; f < fragments.size() ; f++) {
+    const ContourFragment &fragment = *fragments[f];
+    if (used[f])
+      continue;
+
+    std::vector<double> x(fragment.get_x()), y(fragment.get_y());
+
+    if (fragment.is_closed()) {
+      used[f] = true;
+      lines.emplace_back(level, std::move(x), std::move(y), true);
+      continue;
+    }
+
+    bool reversed;
+    if (counterpart(f, false) == CONTOUR_LINE_NO_EDGE)
+      reversed = false;
+    else if (counterpart(f, true) == CONTOUR_LINE_NO_EDGE)
+      reversed = true;
+    else
+      continue;
+
+    used[f] = true;
+    if (reversed) {
+      std::reverse(x.begin(), x.end());
+      std::reverse(y.begin(), y.end());
+    }
+    follow(f, reversed, x, y);
+    if (x.size() > 1)
+      lines.emplace_back(level, std::move(x), std::move(y), false);
+  }
+
+  // whatever remains are loops crossing one or more boundaries
+  for (std::size_t f = 0 ; f < fragments.size() ; f++) {
+    if (used[f])
+      continue;
+    used[f] = true;
+    std::vector<double> x(fragments[f]->get_x()), y(fragments[f]->get_y());
+    const bool closed = follow(f, false, x, y);
+    lines.emplace_back(level, std::move(x), std::move(y), closed);
+  }
+}
+
+ContourLine::ContourLine(double _level, std::vector<double> &&_x, std::vector<double> &&_y, bool _closed) :
+  level(_level), x(std::move(_x)), y(std::move(_y)), closed(_closed) {}
+
+double ContourLine::get_level() const {
+  return level;
+}
+
+const std::vector<double> &ContourLine::get_x() const {
+  return x;
+}
+
+const std::vector<double> &ContourLine::get_y() const {
+  return y;
+}
+
+bool ContourLine::is_closed() const {
+  return closed;
+}
+
+ContourFragment::ContourFragment(double _level, std::size_t _level_index, std::vector<double> &&_x, std::vector<double> &&_y,
+                                 std::size_t _first_edge, std::size_t _last_edge, bool _closed) :
+  ContourLine(_level, std::move(_x), std::move(_y), _closed),
+  level_index(_level_index),
+  first_edge(_first_edge),
+  last_edge(_last_edge) {}
+
+std::size_t ContourFragment::get_level_index() const {
+  return level_index;
+}
+
+std::size_t ContourFragment::get_first_edge() const {
+  return first_edge;
+}
+
+std::size_t ContourFragment::get_last_edge() const {
+  return last_edge;
+}
+
+ContourTiles::ContourTiles(std::size_t _tile_size) :
+  tile_size(_tile_size),
+  nx(0),
+  ny(0),
+  ntiles_x(0),
+  ntiles_y(0),
+  lines_valid(true),
+  region_tiles{0, 0, 0, 0},
+  region_lines_valid(false) {
+
+  if (tile_size == 0) {
+    throw Exception("Gtk::PLplot::ContourTiles::ContourTiles -> tile_size must be strictly positive");
+  }
+}
+
+void ContourTiles::trace_tiles(const StridedArray2D &z, const std::vector<double> &x, const std::vector<double> &y,
+                               std::size_t cell_x_first, std::size_t cell_x_last,
+                               std::size_t cell_y_first, std::size_t cell_y_last) {
+  if (tiles.empty() || cell_x_first >= cell_x_last || cell_y_first >= cell_y_last)
+    return;
+
+  std::vector<std::size_t> tile_list;
+  for (std::size_t tx = cell_x_first / tile_size ; tx <= (cell_x_last - 1) / tile_size ; tx++) {
+    for (std::size_t ty = cell_y_first / tile_size ; ty <= (cell_y_last - 1) / tile_size ; ty++) {
+      if (!tiles_traced[tx * ntiles_y + ty])
+        tile_list.push_back(tx * ntiles_y + ty);
+    }
+  }
+
+  if (tile_list.empty())
+    return;
+
+  std::atomic<std::size_t> next_tile(0);
+
+  // each thread keeps on picking the next tile from the list, until none are left
+  auto trace_next_tiles = [&]() {
+    std::size_t index;
+    while ((index = next_tile++) < tile_list.size()) {
+      const std::size_t tile = tile_list[index];
+      const std::size_t tx = tile / ntiles_y;
+      const std::size_t ty = tile % ntiles_y;
+      std::vector<ContourFragment> &fragments = tiles[tile];
+      fragments.clear();
+      for (std::size_t l = 0 ; l < levels.size() ; l++) {
+        trace_cells(z, x, y, levels[l], l,
+                    tx * tile_size, std::min((tx + 1) * tile_size, nx - 1),
+                    ty * tile_size, std::min((ty + 1) * tile_size, ny - 1),
+                    fragments);
+      }
+    }
+  };
+
+  const std::size_t nthreads = std::min<std::size_t>(std::max<std::size_t>(std::thread::hardware_concurrency(), 1), tile_list.size());
+
+  std::vector<std::thread> threads;
+  for (std::size_t thread = 1 ; thread < nthreads ; thread++)
+    threads.emplace_back(trace_next_tiles);
+  trace_next_tiles();
+  for (auto &thread : threads)
+    thread.join();
+
+  for (auto tile : tile_list)
+    tiles_traced[tile] = 1;
+
+  lines_valid = false;
+  region_lines_valid = false;
+}
+
+void ContourTiles::stitch_tiles(std::size_t tx_first, std::size_t tx_last,
+                                std::size_t ty_first, std::size_t ty_last,
+                                std::vector<ContourLine> &stitched) const {
+  // edges on the boundary between two of the tiles are shared by cells of both tiles,
+  // whereas those on the border of the rectangle are shared with tiles that are left out
+  const std::size_t _tile_size = tile_size;
+  const std::size_t _ny = ny;
+  const std::size_t i_first = tx_first * tile_size;
+  const std::size_t i_last = std::min(tx_last * tile_size, nx - 1);
+  const std::size_t j_first = ty_first * tile_size;
+  const std::size_t j_last = std::min(ty_last * tile_size, ny - 1);
+  auto on_boundary = [_tile_size, _ny, i_first, i_last, j_first, j_last](std::size_t edge) {
+    const std::size_t i = (edge / 2) / _ny;
+    const std::size_t j = (edge / 2) % _ny;
+    if (edge % 2 == 1)
+      return i > i_first && i < i_last && i % _tile_size == 0;
+    return j > j_first && j < j_last && j % _tile_size == 0;
+  };
+
+  std::vector<std::vector<const ContourFragment *>> level_fragments(levels.size());
+  for (std::size_t tx = tx_first ; tx < tx_last ; tx++) {
+    for (std::size_t ty = ty_first ; ty < ty_last ; ty++) {
+      for (auto &fragment : tiles[tx * ntiles_y + ty])
+        level_fragments[fragment.get_level_index()].push_back(&fragment);
+    }
+  }
+
+  for (std::size_t l = 0 ; l < levels.size() ; l++)
+    stitch_level(levels[l], level_fragments[l], on_boundary, stitched);
+}
+
+void ContourTiles::reset(std::size_t _nx, std::size_t _ny, const std::vector<double> &_levels) {
+  levels = _levels;
+  nx = _nx;
+  ny = _ny;
+  tiles.clear();
+  tiles_traced.clear();
+  lines.clear();
+  lines_valid = true;
+  region_lines.clear();
+  region_lines_valid = false;
+
+  if (nx < 2 || ny < 2 || levels.empty()) {
+    ntiles_x = ntiles_y = 0;
+    return;
+  }
+
+  ntiles_x = (nx - 2) / tile_size + 1;
+  ntiles_y = (ny - 2) / tile_size + 1;
+  tiles.resize(ntiles_x * ntiles_y);
+  tiles_traced.resize(tiles.size(), 0);
+  lines_valid = false;
+}
+
+void ContourTiles::invalidate(std::size_t ix0, std::size_t iy0, std::size_t region_nx, std::size_t region_ny) {
+  if (tiles.empty() || region_nx == 0 || region_ny == 0)
+    return;
+
+  // a grid point is a corner of the cells on either side of it
+  const std::size_t cell_x_first = ix0 > 0 ? ix0 - 1 : 0;
+  const std::size_t cell_x_last = std::min(ix0 + region_nx, nx - 1);
+  const std::size_t cell_y_first = iy0 > 0 ? iy0 - 1 : 0;
+  const std::size_t cell_y_last = std::min(iy0 + region_ny, ny - 1);
+
+  if (cell_x_first >= cell_x_last || cell_y_first >= cell_y_last)
+    return;
+
+  for (std::size_t tx = cell_x_first / tile_size ; tx <= (cell_x_last - 1) / tile_size ; tx++) {
+    for (std::size_t ty = cell_y_first / tile_size ; ty <= (cell_y_last - 1) / tile_size ; ty++)
+      tiles_traced[tx * ntiles_y + ty] = 0;
+  }
+  lines_valid = false;
+}
+
+void ContourTiles::trace(const StridedArray2D &z,
+                         const std::vector<double> &x,
+                         const std::vector<double> &y,
+                         const std::vector<double> &_levels) {
+  reset(x.size(), y.size(), _levels);
+  trace_tiles(z, x, y, 0, nx - 1, 0, ny - 1);
+}
+
+void ContourTiles::get_fragments(const StridedArray2D &z,
+                                 const std::vector<double> &x,
+                                 const std::vector<double> &y,
+                                 std::size_t ix0, std::size_t iy0,
+                                 std::size_t region_nx, std::size_t region_ny,
+                                 std::vector<const ContourLine *> &fragments) {
+  if (tiles.empty() || region_nx < 2 || region_ny < 2)
+    return;
+
+  // the cells between the grid points of the rectangle
+  const std::size_t cell_x_first = std::min(ix0, nx - 2);
+  const std::size_t cell_x_last = std::min(ix0 + region_nx - 1, nx - 1);
+  const std::size_t cell_y_first = std::min(iy0, ny - 2);
+  const std::size_t cell_y_last = std::min(iy0 + region_ny - 1, ny - 1);
+
+  trace_tiles(z, x, y, cell_x_first, cell_x_last, cell_y_first, cell_y_last);
+
+  for (std::size_t tx = cell_x_first / tile_size ; tx <= (cell_x_last - 1) / tile_size ; tx++) {
+    for (std::size_t ty = cell_y_first / tile_size ; ty <= (cell_y_last - 1) / tile_size ; ty++) {
+      for (auto &fragment : tiles[tx * ntiles_y + ty])
+        fragments.push_back(&fragment);
+    }
+  }
+}
+
+const std::vector<ContourLine> &ContourTiles::get_region_lines(const StridedArray2D &z,
+                                                               const std::vector<double> &x,
+                                                               const std::vector<double> &y,
+                                                               std::size_t ix0, std::size_t iy0,
+                                                               std::size_t region_nx, std::size_t region_ny) {
+  if (tiles.empty() || region_nx < 2 || region_ny < 2) {
+    region_lines.clear();
+    region_lines_valid = false;
+    return region_lines;
+  }
+
+  // the cells between the grid points of the rectangle
+  const std::size_t cell_x_first = std::min(ix0, nx - 2);
+  const std::size_t cell_x_last = std::min(ix0 + region_nx - 1, nx - 1);
+  const std::size_t cell_y_first = std::min(iy0, ny - 2);
+  const std::size_t cell_y_last = std::min(iy0 + region_ny - 1, ny - 1);
+
+  // tracing any of the outdated tiles invalidates region_lines
+  trace_tiles(z, x, y, cell_x_first, cell_x_last, cell_y_first, cell_y_last);
+
+  const std::size_t requested[4] = {
+    cell_x_first / tile_size,
+    cell_y_first / tile_size,
+    (cell_x_last - 1) / tile_size + 1,
+    (cell_y_last - 1) / tile_size + 1
+  };
+
+  if (region_lines_valid && std::equal(requested, requested + 4, region_tiles))
+    return region_lines;
+
+  region_lines.clear();
+  stitch_tiles(requested[0], requested[2], requested[1], requested[3], region_lines);
+  std::copy(requested, requested + 4, region_tiles);
+  region_lines_valid = true;
+  return region_lines;
+}
+
+const std::vector<ContourLine> &ContourTiles::get_lines(const StridedArray2D &z,
+                                                        const std::vector<double> &x,
+                                                        const std::vector<double> &y) {
+  if (lines_valid)
+    return lines;
+
+  trace_tiles(z, x, y, 0, nx - 1, 0, ny - 1);
+
+  lines.clear();
+  stitch_tiles(0, ntiles_x, 0, ntiles_y, lines);
+
+  lines_valid = true;
+  return lines;
+}
+
+std::vector<ContourLine> Gtk::PLplot::trace_contour_lines(const StridedArray2D &z,
+                                                          const std::vector<double> &x,
+                                                          const std::vector<double> &y,
+                                                          const std::vector<double> &levels) {
+  ContourTiles tiles;
+  tiles.trace(z, x, y, levels);
+  return tiles.get_lines(z, x, y);
+}
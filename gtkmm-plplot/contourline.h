@@ -0,0 +1,283 @@
+/*
+Copyright (C) 2016 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GTKMM_PLPLOT_CONTOUR_LINE_H
+#define GTKMM_PLPLOT_CONTOUR_LINE_H
+
+#include <gtkmm-plplot/stridedarray2d.h>
+#include <vector>
+#include <cstddef>
+
+namespace Gtk {
+  namespace PLplot {
+    /** \class ContourLine contourline.h <gtkmm-plplot/contourline.h>
+     *  \brief a single polyline of a contour level
+     *
+     *  Instances of this class hold the geometry of one connected piece of a contour level, in world coordinates.
+     *  They are produced by ContourTiles and trace_contour_lines(), and are cached by PlotContour, which exposes them through PlotContour::get_contour_lines().
+     */
+    class ContourLine {
+    protected:
+      double level; ///< the contour level this polyline belongs to
+      std::vector<double> x; ///< the X-coordinates of the vertices of the polyline
+      std::vector<double> y; ///< the Y-coordinates of the vertices of the polyline
+      bool closed; ///< \c true if the polyline is a closed loop, in which case its last vertex is identical to its first
+    public:
+      /** Constructor
+       *
+       * \param level the contour level
+       * \param x the X-coordinates of the vertices, which will be moved into the new instance
+       * \param y the Y-coordinates of the vertices, which will be moved into the new instance
+       * \param closed whether the polyline is a closed loop
+       */
+      ContourLine(double level, std::vector<double> &&x, std::vector<double> &&y, bool closed);
+
+      /** Get the contour level this polyline belongs to
+       *
+       * \returns the contour level
+       */
+      double get_level() const;
+
+      /** Get the X-coordinates of the vertices of the polyline
+       *
+       * \returns a reference to the X-coordinates
+       */
+      const std::vector<double> &get_x() const;
+
+      /** Get the Y-coordinates of the vertices of the polyline
+       *
+       * \returns a reference to the Y-coordinates
+       */
+      const std::vector<double> &get_y() const;
+
+      /** Check if the polyline is a closed loop
+       *
+       * \returns \c true if the polyline is closed, \c false if both its ends lie on the edge of the grid or next to undefined values
+       */
+      bool is_closed() const;
+    };
+
+    /** \class ContourFragment contourline.h <gtkmm-plplot/contourline.h>
+     *  \brief the part of a contour line that lies within a single tile of a ContourTiles cache
+     *
+     *  Besides its geometry, a fragment knows on which edges of the grid its first and last vertices lie,
+     *  which allows ContourTiles to stitch fragments of neighbouring tiles together. Edges between grid points (i, j) and (i + 1, j)
+     *  have id 2 * (i * ny + j), while edges between grid points (i, j) and (i, j + 1) have id 2 * (i * ny + j) + 1, with ny the number of Y-grid coordinates.
+     */
+    class ContourFragment : public ContourLine {
+    protected:
+      std::size_t level_index; ///< the index of the contour level in the list of levels that was traced
+      std::size_t first_edge; ///< the id of the grid edge the first vertex lies on
+      std::size_t last_edge; ///< the id of the grid edge the last vertex lies on
+    public:
+      /** Constructor
+       *
+       * \param level the contour level
+       * \param level_index the index of the contour level in the list of levels that was traced
+       * \param x the X-coordinates of the vertices, which will be moved into the new instance
+       * \param y the Y-coordinates of the vertices, which will be moved into the new instance
+       * \param first_edge the id of the grid edge the first vertex lies on
+       * \param last_edge the id of the grid edge the last vertex lies on
+       * \param closed whether the fragment is a closed loop
+       */
+      ContourFragment(double level, std::size_t level_index, std::vector<double> &&x, std::vector<double> &&y,
+                      std::size_t first_edge, std::size_t last_edge, bool closed);
+
+      /** Get the index of the contour level in the list of levels that was traced
+       *
+       * \returns the index of the contour level
+       */
+      std::size_t get_level_index() const;
+
+      /** Get the id of the grid edge the first vertex lies on
+       *
+       * \returns the edge id
+       */
+      std::size_t get_first_edge() const;
+
+      /** Get the id of the grid edge the last vertex lies on
+       *
+       * \returns the edge id
+       */
+      std::size_t get_last_edge() const;
+    };
+
+    /** \class ContourTiles contourline.h <gtkmm-plplot/contourline.h>
+     *  \brief a cache of the contour lines of a rectilinear grid, organized in square tiles of cells
+     *
+     *  The cells of the grid are divided into tiles, and the contour lines of each tile are traced separately, using all available cores.
+     *  A marching squares algorithm is applied to each cell, using the value in the center of the cell to resolve saddle points,
+     *  and the vertices are found by linear interpolation along the edges of the cells, using the same mapping from grid indices
+     *  to world coordinates as PLplot's \c tr1 transformation function. Cells with a NaN value in one of their corners are skipped.
+     *  Tiles are traced on demand: get_fragments() only traces the tiles overlapping the requested part of the grid, while get_lines()
+     *  traces all outdated tiles, and then stitches the fragments that meet at the boundaries between tiles into complete contour lines.
+     *  get_region_lines() combines both, stitching only the fragments of the tiles overlapping the requested part of the grid.
+     *  When only a part of the grid has been modified, invalidate() marks the tiles touching it as outdated, leaving all other tiles alone.
+     */
+    class ContourTiles {
+    private:
+      ContourTiles(const ContourTiles &) = delete; ///< no copy constructor
+      ContourTiles &operator=(const ContourTiles &) = delete; ///< no assignment operator
+
+      /** Trace the contour lines through the outdated tiles that overlap a rectangle of cells, in parallel
+       *
+       * \param z the Z-values, as an array of \c x.size() by \c y.size() elements
+       * \param x the X-grid coordinates
+       * \param y the Y-grid coordinates
+       * \param cell_x_first the first cell of the rectangle along the first dimension
+       * \param cell_x_last one past the last cell of the rectangle along the first dimension
+       * \param cell_y_first the first cell of the rectangle along the second dimension
+       * \param cell_y_last one past the last cell of the rectangle along the second dimension
+       */
+      void trace_tiles(const StridedArray2D &z, const std::vector<double> &x, const std::vector<double> &y,
+                       std::size_t cell_x_first, std::size_t cell_x_last,
+                       std::size_t cell_y_first, std::size_t cell_y_last);
+
+      /** Stitch the fragments of a rectangle of tiles together
+       *
+       * Fragments meeting at the boundaries between these tiles are joined, while edges on the border of the rectangle are treated as open ends.
+       * \param tx_first the first tile of the rectangle along the first dimension
+       * \param tx_last one past the last tile of the rectangle along the first dimension
+       * \param ty_first the first tile of the rectangle along the second dimension
+       * \param ty_last one past the last tile of the rectangle along the second dimension
+       * \param stitched the vector the contour lines will be appended to, sorted by level
+       */
+      void stitch_tiles(std::size_t tx_first, std::size_t tx_last,
+                        std::size_t ty_first, std::size_t ty_last,
+                        std::vector<ContourLine> &stitched) const;
+    protected:
+      std::size_t tile_size; ///< the number of cells along each side of a tile
+      std::size_t nx; ///< the number of X-grid coordinates of the traced grid
+      std::size_t ny; ///< the number of Y-grid coordinates of the traced grid
+      std::size_t ntiles_x; ///< the number of tiles along the first dimension of the grid
+      std::size_t ntiles_y; ///< the number of tiles along the second dimension of the grid
+      std::vector<double> levels; ///< the contour levels that are traced
+      std::vector<std::vector<ContourFragment>> tiles; ///< the fragments found in each tile. Tile (tx, ty) is found at index tx * ntiles_y + ty.
+      std::vector<char> tiles_traced; ///< non-zero for the tiles whose fragments are up to date
+      std::vector<ContourLine> lines; ///< the stitched contour lines
+      bool lines_valid; ///< \c false if \c lines needs to be stitched again
+      std::vector<ContourLine> region_lines; ///< the stitched contour lines of the tiles that were requested most recently through get_region_lines()
+      std::size_t region_tiles[4]; ///< the tiles covered by \c region_lines: first tile along both dimensions, and one past the last tile along both dimensions
+      bool region_lines_valid; ///< \c false if \c region_lines needs to be stitched again
+    public:
+      /** Constructor
+       *
+       * \param tile_size the number of cells along each side of a tile
+       * \exception Gtk::PLplot::Exception
+       */
+      ContourTiles(std::size_t tile_size = 256);
+
+      /** Forget all traced contour lines, and prepare the cache for a grid with the given dimensions and contour levels
+       *
+       * Nothing is traced until the contour lines are requested.
+       * \param nx the number of X-grid coordinates
+       * \param ny the number of Y-grid coordinates
+       * \param levels the contour levels
+       */
+      void reset(std::size_t nx, std::size_t ny, const std::vector<double> &levels);
+
+      /** Mark the tiles touching a rectangle of modified grid points as outdated
+       *
+       * \param ix0 the first index of the rectangle along the first dimension
+       * \param iy0 the first index of the rectangle along the second dimension
+       * \param region_nx the extent of the rectangle along the first dimension
+       * \param region_ny the extent of the rectangle along the second dimension
+       */
+      void invalidate(std::size_t ix0, std::size_t iy0, std::size_t region_nx, std::size_t region_ny);
+
+      /** Trace the contour lines of a grid from scratch
+       *
+       * \param z the Z-values, as an array of \c x.size() by \c y.size() elements
+       * \param x the X-grid coordinates
+       * \param y the Y-grid coordinates
+       * \param levels the contour levels
+       */
+      void trace(const StridedArray2D &z,
+                 const std::vector<double> &x,
+                 const std::vector<double> &y,
+                 const std::vector<double> &levels);
+
+      /** Get the fragments of the contour lines in the tiles overlapping a rectangle of grid points
+       *
+       * Only the outdated tiles among these are traced, which makes this method suitable for drawing a zoomed in part of a large grid.
+       * The fragments are not stitched together.
+       * \param z the Z-values, as an array of \c x.size() by \c y.size() elements
+       * \param x the X-grid coordinates
+       * \param y the Y-grid coordinates
+       * \param ix0 the first index of the rectangle along the first dimension
+       * \param iy0 the first index of the rectangle along the second dimension
+       * \param region_nx the extent of the rectangle along the first dimension
+       * \param region_ny the extent of the rectangle along the second dimension
+       * \param fragments the vector the fragments will be appended to. Its elements remain valid until the cache is modified.
+       */
+      void get_fragments(const StridedArray2D &z,
+                         const std::vector<double> &x,
+                         const std::vector<double> &y,
+                         std::size_t ix0, std::size_t iy0,
+                         std::size_t region_nx, std::size_t region_ny,
+                         std::vector<const ContourLine *> &fragments);
+
+      /** Get the contour lines that pass through the tiles overlapping a rectangle of grid points
+       *
+       * Only the outdated tiles among these are traced, and only their fragments are stitched together, which makes this method suitable for drawing
+       * a zoomed in part of a large grid as complete polylines. Lines leaving the tiles are cut off where they cross the border of the covered tiles.
+       * The result is cached, and is stitched again only if another rectangle of tiles is requested, or if any of these tiles changed.
+       * \param z the Z-values, as an array of \c x.size() by \c y.size() elements
+       * \param x the X-grid coordinates
+       * \param y the Y-grid coordinates
+       * \param ix0 the first index of the rectangle along the first dimension
+       * \param iy0 the first index of the rectangle along the second dimension
+       * \param region_nx the extent of the rectangle along the first dimension
+       * \param region_ny the extent of the rectangle along the second dimension
+       * \returns the contour lines, sorted by level in the order in which the levels were passed to reset() or trace(). The reference remains valid until the next call of this method.
+       */
+      const std::vector<ContourLine> &get_region_lines(const StridedArray2D &z,
+                                                       const std::vector<double> &x,
+                                                       const std::vector<double> &y,
+                                                       std::size_t ix0, std::size_t iy0,
+                                                       std::size_t region_nx, std::size_t region_ny);
+
+      /** Get the contour lines
+       *
+       * All outdated tiles are traced, and the fragments of all tiles are stitched together if any of them changed since the last call.
+       * \param z the Z-values, as an array of \c x.size() by \c y.size() elements
+       * \param x the X-grid coordinates
+       * \param y the Y-grid coordinates
+       * \returns the contour lines, sorted by level in the order in which the levels were passed to reset() or trace()
+       */
+      const std::vector<ContourLine> &get_lines(const StridedArray2D &z,
+                                                const std::vector<double> &x,
+                                                const std::vector<double> &y);
+    };
+
+    /** Trace the contour lines of a rectilinear grid
+     *
+     * This is a convenience function that traces all tiles of a temporary ContourTiles object, and returns the stitched contour lines.
+     * \param z the Z-values, as an array of \c x.size() by \c y.size() elements
+     * \param x the X-grid coordinates
+     * \param y the Y-grid coordinates
+     * \param levels the contour levels
+     * \returns the contour lines, sorted by level in the order of \c levels
+     */
+    std::vector<ContourLine> trace_contour_lines(const StridedArray2D &z,
+                                                 const std::vector<double> &x,
+                                                 const std::vector<double> &y,
+                                                 const std::vector<double> &levels);
+  }
+}
+
+#endif
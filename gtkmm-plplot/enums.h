@@ -78,6 +78,37 @@ namespace Gtk {
       UPWARD_AND_DOWNWARD_LINES_45_DEGREES, ///< lines at 45 degrees angle upward and downward
     };
 
+    /** Determines how PlotContourShades renders its shaded regions
+     *
+     * To be used in combination with PlotContourShades::set_shades_rendering() and PlotContourShades::get_shades_rendering()
+     */
+    enum ShadesRendering {
+      SHADES_POLYGONS = 0, ///< PLplot fills a polygon for each shaded region, honouring the area fill pattern
+      SHADES_RASTER, ///< the shaded regions are painted as a single image, with one pixel per device pixel
+    };
+
+    /** How the blocks of grid points of a PlotDataSurface are combined into a single value when its display-resolution pyramid is built
+     *
+     * To be used in combination with PlotDataSurface::set_pyramid_reduction()
+     */
+    enum PyramidReduction {
+      PYRAMID_NONE = 0, ///< no pyramid is built, and plots always use the data at full resolution
+      PYRAMID_MEAN, ///< the mean of each block
+      PYRAMID_MIN, ///< the minimum of each block
+      PYRAMID_MAX, ///< the maximum of each block
+    };
+
+    /** The types in which the values of a PlotDataBuffer can be stored
+     *
+     * To be used in combination with the PlotDataBuffer constructors and PlotDataBuffer::get_sample_type()
+     */
+    enum SampleType {
+      SAMPLE_DOUBLE = 0, ///< double precision floating point numbers
+      SAMPLE_FLOAT, ///< single precision floating point numbers
+      SAMPLE_INT16, ///< 16-bit signed integers
+      SAMPLE_INT32, ///< 32-bit signed integers
+    };
+
     /** Determines which corner of the Legend box that will be used for the normalized coordinate system.
      *
      */
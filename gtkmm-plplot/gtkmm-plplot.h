@@ -20,6 +20,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <gtkmm-plplot/object.h>
 #include <gtkmm-plplot/canvas.h>
+#include <gtkmm-plplot/contourline.h>
+#include <gtkmm-plplot/stridedarray2d.h>
+#include <gtkmm-plplot/surfacepyramidlevel.h>
+#include <gtkmm-plplot/plotdatawaterfall.h>
+#include <gtkmm-plplot/plotwaterfall.h>
 #include <gtkmm-plplot/enums.h>
 #include <gtkmm-plplot/exception.h>
 #include <gtkmm-plplot/legend.h>
@@ -34,7 +39,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <gtkmm-plplot/plotdata2derrorx.h>
 #include <gtkmm-plplot/plotdata2derrorxy.h>
 #include <gtkmm-plplot/plotdata2derrory.h>
+#include <gtkmm-plplot/plotdata2dstrip.h>
 #include <gtkmm-plplot/plotdata3d.h>
+#include <gtkmm-plplot/plotdatabuffer.h>
 #include <gtkmm-plplot/plotdatahistogram.h>
 #include <gtkmm-plplot/plotdatahistogrambinned.h>
 #include <gtkmm-plplot/plotdatahistogramunbinned.h>
@@ -47,6 +54,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <gtkmm-plplot/plotobject2dline.h>
 #include <gtkmm-plplot/plotobject2dtext.h>
 #include <gtkmm-plplot/regionselection.h>
+#include <gtkmm-plplot/updateguard.h>
 #include <gtkmm-plplot/utils.h>
 
 
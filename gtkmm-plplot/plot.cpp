@@ -17,8 +17,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <gtkmm-plplot/plot.h>
 #include <gtkmm-plplot/exception.h>
+#include <gtkmm-plplot/enums.h>
 #include <gdkmm/general.h>
 #include <plstream.h>
+#include <cmath>
 
 using namespace Gtk::PLplot;
 
@@ -35,6 +37,12 @@ Plot::Plot(
   axis_title_y(_axis_title_y),
   plot_title(_plot_title),
   pls(nullptr),
+  canvas_width(0),
+  canvas_height(0),
+  plot_offset_x(0),
+  plot_offset_y(0),
+  plot_width(0),
+  plot_height(0),
   shown(true),
   background_color("Black"),
   plot_width_norm(_plot_width_norm),
@@ -42,7 +50,14 @@ Plot::Plot(
   plot_offset_horizontal_norm(_plot_offset_horizontal_norm),
   plot_offset_vertical_norm(_plot_offset_vertical_norm),
   axes_color("Black"),
-  titles_color("Black") {
+  titles_color("Black"),
+  cache_canvas_width(0),
+  cache_canvas_height(0),
+  cache_device_scale(1.0),
+  cache_valid(false),
+  updates_frozen(0),
+  changed_pending(false),
+  data_modified_pending(false) {
 
   background_color.set_alpha(0.0);
 
@@ -52,6 +67,9 @@ Plot::Plot(
   this->signal_data_removed().connect(sigc::mem_fun(*this, &Plot::on_data_removed));
   this->signal_object_added().connect(sigc::mem_fun(*this, &Plot::on_object_added));
   this->signal_object_removed().connect(sigc::mem_fun(*this, &Plot::on_object_removed));
+
+  //any change invalidates the cached image. This is not done in on_changed as it may be overridden
+  this->signal_changed().connect([this](){cache_valid = false;});
 }
 
 Plot::~Plot() {
@@ -74,14 +92,57 @@ void Plot::on_changed() {
   //it is designed to be overridden by a derived class
 }
 
+void Plot::notify_changed() {
+  if (updates_frozen > 0) {
+    changed_pending = true;
+    return;
+  }
+  _signal_changed.emit();
+}
+
+void Plot::notify_data_modified() {
+  if (updates_frozen > 0) {
+    data_modified_pending = true;
+    return;
+  }
+  plot_data_modified();
+}
+
+void Plot::freeze_updates() {
+  updates_frozen++;
+}
+
+void Plot::thaw_updates() {
+  if (updates_frozen == 0)
+    throw Exception("Gtk::PLplot::Plot::thaw_updates -> updates are not frozen");
+
+  if (--updates_frozen > 0)
+    return;
+
+  //plot_data_modified emits signal_changed itself
+  if (data_modified_pending) {
+    data_modified_pending = false;
+    changed_pending = false;
+    plot_data_modified();
+  }
+  else if (changed_pending) {
+    changed_pending = false;
+    _signal_changed.emit();
+  }
+}
+
+bool Plot::get_updates_frozen() const {
+  return updates_frozen > 0;
+}
+
 void Plot::show() {
   shown = true;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 void Plot::hide() {
   shown = false;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 bool Plot::is_showing() const {
@@ -89,25 +150,25 @@ bool Plot::is_showing() const {
 }
 
 void Plot::on_data_added(PlotData *added_data) {
-  plot_data_modified();
+  notify_data_modified();
 }
 
 void Plot::on_object_added(PlotObject *added_object) {
-  _signal_changed.emit();
+  notify_changed();
 }
 
 void Plot::on_data_removed(PlotData *removed_data) {
   if (removed_data->is_managed_()) {
     delete removed_data; //this is necessary to avoid a memory leak.
   }
-  plot_data_modified();
+  notify_data_modified();
 }
 
 void Plot::on_object_removed(PlotObject *removed_object) {
   if (removed_object->is_managed_()) {
     delete removed_object; //this is necessary to avoid a memory leak.
   }
-  _signal_changed.emit();
+  notify_changed();
 }
 
 void Plot::remove_data(unsigned int index) {
@@ -166,12 +227,12 @@ void Plot::remove_object(PlotObject &plot_object_member) {
 
 void Plot::set_axis_title_x(Glib::ustring title) {
   axis_title_x = title;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 void Plot::set_axis_title_y(Glib::ustring title) {
   axis_title_y = title;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 Glib::ustring Plot::get_axis_title_x() {
@@ -184,7 +245,7 @@ Glib::ustring Plot::get_axis_title_y() {
 
 void Plot::set_plot_title(Glib::ustring title) {
   plot_title = title;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 Glib::ustring Plot::get_plot_title() {
@@ -204,7 +265,7 @@ Gdk::RGBA Plot::get_background_color() {
 
 void Plot::set_background_color(Gdk::RGBA _background_color) {
   background_color = _background_color;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 Gdk::RGBA Plot::get_axes_color() {
@@ -213,7 +274,7 @@ Gdk::RGBA Plot::get_axes_color() {
 
 void Plot::set_axes_color(Gdk::RGBA _axes_color) {
   axes_color = _axes_color;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 Gdk::RGBA Plot::get_titles_color() {
@@ -222,33 +283,123 @@ Gdk::RGBA Plot::get_titles_color() {
 
 void Plot::set_titles_color(Gdk::RGBA _titles_color) {
   titles_color = _titles_color;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 
+void Plot::get_plot_area(const int width, const int height, int &x, int &y, int &w, int &h) const {
+  x = width * plot_offset_horizontal_norm;
+  y = height * plot_offset_vertical_norm;
+  w = width * plot_width_norm;
+  h = height * plot_height_norm;
+}
+
 void Plot::draw_plot_init(const Cairo::RefPtr<Cairo::Context> &cr, const int width, const int height) {
+  int new_plot_offset_x, new_plot_offset_y, new_plot_width, new_plot_height;
+  get_plot_area(width, height, new_plot_offset_x, new_plot_offset_y, new_plot_width, new_plot_height);
+
+  //the extcairo device only reads the page geometry in init(),
+  //so the stream needs to be set up from scratch only when the plot geometry changes.
+  const bool geometry_changed = pls == nullptr ||
+                                canvas_width != width ||
+                                canvas_height != height ||
+                                plot_width != new_plot_width ||
+                                plot_height != new_plot_height ||
+                                plot_offset_x != new_plot_offset_x ||
+                                plot_offset_y != new_plot_offset_y;
+
   canvas_width = width;
   canvas_height = height;
-  plot_width = width * plot_width_norm;
-  plot_height= height * plot_height_norm;
-  plot_offset_x = width * plot_offset_horizontal_norm;
-  plot_offset_y = height * plot_offset_vertical_norm;
+  plot_width = new_plot_width;
+  plot_height = new_plot_height;
+  plot_offset_x = new_plot_offset_x;
+  plot_offset_y = new_plot_offset_y;
 
-  if (pls)
-    delete pls;
-  pls = new plstream;
+  if (geometry_changed) {
+    if (pls)
+      delete pls;
+    pls = new plstream;
 
-  //add support for more colors
-  pls->scmap0n(1024);
+    //add support for more colors
+    pls->scmap0n(1024);
+
+    pls->sdev("extcairo");
+    pls->spage(0.0, 0.0, plot_width , plot_height, plot_offset_x, plot_offset_y);
+  }
 
-  pls->sdev("extcairo");
-  pls->spage(0.0, 0.0, plot_width , plot_height, plot_offset_x, plot_offset_y);
   Gdk::Cairo::set_source_rgba(cr, background_color);
   cr->rectangle(plot_offset_x, plot_offset_y, plot_width, plot_height);
   cr->fill();
   cr->save();
   cr->translate(plot_offset_x, plot_offset_y);
-  pls->init();
 
+  if (geometry_changed)
+    pls->init();
+
+  //(re)bind the stream to the current cairo context
   pls->cmd(PLESC_DEVINIT, cr->cobj());
+
+  //the stream outlives this draw, so reset the pen state left behind by the previous one
+  pls->lsty(LineStyle::CONTINUOUS);
+  pls->width(1.0);
+  pls->schr(0.0, 1.0);
+  pls->psty(0);
+}
+
+void Plot::draw_plot_cached(const Cairo::RefPtr<Cairo::Context> &cr, const int width, const int height) {
+  if (!shown)
+    return;
+
+  int cache_plot_offset_x, cache_plot_offset_y, cache_plot_width, cache_plot_height;
+  get_plot_area(width, height, cache_plot_offset_x, cache_plot_offset_y, cache_plot_width, cache_plot_height);
+
+  if (cache_plot_width <= 0 || cache_plot_height <= 0)
+    return;
+
+  double device_scale_x = 1.0, device_scale_y = 1.0;
+#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE(1, 14, 0)
+  cairo_surface_get_device_scale(cr->get_target()->cobj(), &device_scale_x, &device_scale_y);
+#endif
+
+  if (!cache_valid ||
+      !cache_surface ||
+      cache_canvas_width != width ||
+      cache_canvas_height != height ||
+      cache_device_scale != device_scale_x) {
+
+    if (!cache_surface ||
+        cache_canvas_width != width ||
+        cache_canvas_height != height ||
+        cache_device_scale != device_scale_x) {
+      cache_surface = Cairo::ImageSurface::create(Cairo::FORMAT_ARGB32,
+                                                  std::ceil(cache_plot_width * device_scale_x),
+                                                  std::ceil(cache_plot_height * device_scale_x));
+#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE(1, 14, 0)
+      cairo_surface_set_device_scale(cache_surface->cobj(), device_scale_x, device_scale_x);
+#endif
+    }
+
+    Cairo::RefPtr<Cairo::Context> cache_cr = Cairo::Context::create(cache_surface);
+
+    //start from a fully transparent image
+    cache_cr->set_operator(Cairo::OPERATOR_CLEAR);
+    cache_cr->paint();
+    cache_cr->set_operator(Cairo::OPERATOR_OVER);
+
+    //draw_plot uses canvas coordinates
+    cache_cr->translate(-cache_plot_offset_x, -cache_plot_offset_y);
+    draw_plot(cache_cr, width, height);
+    cache_surface->flush();
+
+    cache_canvas_width = width;
+    cache_canvas_height = height;
+    cache_device_scale = device_scale_x;
+    cache_valid = true;
+  }
+
+  cr->save();
+  cr->set_source(cache_surface, cache_plot_offset_x, cache_plot_offset_y);
+  cr->rectangle(cache_plot_offset_x, cache_plot_offset_y, cache_plot_width, cache_plot_height);
+  cr->fill();
+  cr->restore();
 }
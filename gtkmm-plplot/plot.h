@@ -50,7 +50,7 @@ namespace Gtk {
       Glib::ustring axis_title_x; ///< X-axis title
       Glib::ustring axis_title_y; ///< Y-axis title
       Glib::ustring plot_title;   ///< Plot title
-      plstream *pls; ///< the \c plstream object that will ensure the connection with PLplot
+      plstream *pls; ///< the \c plstream object that will ensure the connection with PLplot. It is kept alive in between draws and only recreated when the plot geometry changes
       int canvas_width; ///< the width of the canvas in Cairo units
       int canvas_height; ///< the height of the canvas in Cairo units
       int plot_offset_x; ///< the offset of the plot with respect to the top left corner of the canvas, measured along the horizontal (X-) axis in Cairo units
@@ -65,6 +65,14 @@ namespace Gtk {
       const double plot_offset_vertical_norm; ///< the normalized vertical offset from the canvas top left corner, calculated relative to the canvas height
       Gdk::RGBA axes_color; ///< the currently used color to draw the axes, the box and gridlines. Default is opaque black
       Gdk::RGBA titles_color; ///< the currently used color to draw the axes and plot titles. Default is opaque black
+      Cairo::RefPtr<Cairo::ImageSurface> cache_surface; ///< image holding the output of the last draw_plot_cached() call, painted again on expose as long as the plot has not changed
+      int cache_canvas_width; ///< the canvas width \c cache_surface was rendered for
+      int cache_canvas_height; ///< the canvas height \c cache_surface was rendered for
+      double cache_device_scale; ///< the device scale \c cache_surface was rendered for
+      bool cache_valid; ///< \c false when signal_changed has been emitted after \c cache_surface was rendered
+      unsigned int updates_frozen; ///< the number of freeze_updates() calls that have not been matched by thaw_updates() yet
+      bool changed_pending; ///< \c true when signal_changed was postponed because updates were frozen
+      bool data_modified_pending; ///< \c true when plot_data_modified() was postponed because updates were frozen
 
       sigc::signal<void> _signal_changed; ///< signal that gets emitted whenever any of the plot parameters, or any of the contained PlotData datasets is changed.
       sigc::signal<void, PlotData *> _signal_data_added; ///< signal emitted whenever a PlotData dataset is added to the plot
@@ -74,6 +82,20 @@ namespace Gtk {
 
       virtual void plot_data_modified() = 0; ///< a method that will update the \c _range variables when datasets are added, modified or removed.
 
+      /** Emit signal_changed
+       *
+       * Derived classes should call this method instead of emitting \c _signal_changed directly.
+       * While updates are frozen, the emission is postponed until thaw_updates() is called.
+       */
+      void notify_changed();
+
+      /** Call plot_data_modified()
+       *
+       * Derived classes should call this method instead of plot_data_modified() when datasets were added, modified or removed.
+       * While updates are frozen, the call is postponed until thaw_updates() is called.
+       */
+      void notify_data_modified();
+
       /** This is a default handler for signal_changed()
        *
        * This signal is emitted whenever any of the plot properties, or the properties of the PlotData datasets therein, is changed.
@@ -116,12 +138,35 @@ namespace Gtk {
       /** Initialization method for draw_plot.
        *
        *  Should be called by all draw_plot() methods in derived classes.
+       *  The \c plstream is created on the first call and reused afterwards: it is bound to \c cr using \c PLESC_DEVINIT,
+       *  and only set up again when the canvas dimensions, and therefore the plot geometry, have changed since the previous call.
        * \param cr Cairo context
        * \param width width of the plot in normalized coordinates
        * \param height height of the plot in normalized coordinates
        */
       virtual void draw_plot_init(const Cairo::RefPtr<Cairo::Context> &cr, const int width, const int height) final;
 
+      /** Calculate the rectangle occupied by the plot on a canvas with the given dimensions
+       *
+       * \param width the width of the Canvas widget
+       * \param height the height of the Canvas widget
+       * \param x the horizontal offset of the plot with respect to the top left corner of the canvas
+       * \param y the vertical offset of the plot with respect to the top left corner of the canvas
+       * \param w the width of the plot
+       * \param h the height of the plot
+       */
+      void get_plot_area(const int width, const int height, int &x, int &y, int &w, int &h) const;
+
+      /** Draw the plot using a cached image
+       *
+       *  Used by Canvas when drawing the widget. The plot is rendered with draw_plot() into an ARGB image, which is then painted onto \c cr.
+       *  This image is reused for subsequent calls, without going through PLplot, until signal_changed() is emitted or the canvas dimensions or device scale change.
+       * \param cr Cairo context of the widget
+       * \param width the width of the Canvas widget
+       * \param height the height of the Canvas widget
+       */
+      virtual void draw_plot_cached(const Cairo::RefPtr<Cairo::Context> &cr, const int width, const int height) final;
+
       /** Constructor
        *
        * This class provides a single constructor, which takes an existing PlotData dataset to construct a plot.
@@ -282,6 +327,28 @@ namespace Gtk {
        */
       void set_titles_color(Gdk::RGBA color);
 
+      /** Postpone the emission of signal_changed and the recalculation of the plot ranges
+       *
+       * Use this method before making several changes to the plot or its datasets.
+       * When the matching thaw_updates() is called, the plot ranges will be updated at most once and signal_changed will be emitted at most once, resulting in a single redraw.
+       * This includes changes made directly to the datasets of the plot, since their signal_data_modified and signal_changed emissions are postponed by the plot as well.
+       * Calls may be nested. Consider using UpdateGuard to ensure that every freeze is matched by a thaw.
+       */
+      void freeze_updates();
+
+      /** Perform the updates that were postponed since freeze_updates() was called
+       *
+       * Updates are only performed when this call matches the outermost freeze_updates() call.
+       * \exception Gtk::PLplot::Exception
+       */
+      void thaw_updates();
+
+      /** Returns whether updates are currently frozen
+       *
+       * \return \c true if freeze_updates() was called more often than thaw_updates(), \c false if not
+       */
+      bool get_updates_frozen() const;
+
       /** signal_changed is emitted whenever any of the plot properties or any of the dataset properties has changed.
        *
        * See default handler on_changed()
@@ -324,6 +391,7 @@ namespace Gtk {
 
       friend class Canvas;
       friend class RegionSelection;
+      friend class Legend;
     };
   }
 }
@@ -19,6 +19,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <gtkmm-plplot/exception.h>
 #include <gtkmm-plplot/utils.h>
 #include <iostream>
+#include <limits>
+#include <algorithm>
+#include <cmath>
 #include <gdkmm/rgba.h>
 #include <plstream.h>
 
@@ -72,31 +75,28 @@ Plot2D::~Plot2D() {}
 
 void Plot2D::plot_data_modified() {
   //update ranges
-  std::vector<double> min_x, min_y;
-  std::vector<double> max_x, max_y;
-
-  for (auto &iter : plot_data) {
-    auto iter2 = dynamic_cast<PlotData2D*>(iter);
-    double xmin, xmax, ymin, ymax;
-    iter2->get_extremes(xmin, xmax, ymin, ymax);
-    min_x.push_back(xmin);
-    max_x.push_back(xmax);
-    min_y.push_back(ymin);
-    max_y.push_back(ymax);
+  //the datasets keep track of their own extremes, so this only needs to loop over the datasets
+  if (plot_data.empty()) {
+    plot_data_range_x[0] = 0.0;
+    plot_data_range_x[1] = 1.0;
+    plot_data_range_y[0] = 0.0;
+    plot_data_range_y[1] = 1.0;
   }
+  else {
+    plot_data_range_x[0] = plot_data_range_y[0] = std::numeric_limits<double>::max();
+    plot_data_range_x[1] = plot_data_range_y[1] = std::numeric_limits<double>::lowest();
 
-  if (min_x.empty()) {
-    min_x.push_back(0.0);
-    max_x.push_back(1.0);
-    min_y.push_back(0.0);
-    max_y.push_back(1.0);
+    for (auto &iter : plot_data) {
+      auto iter2 = dynamic_cast<PlotData2D*>(iter);
+      double xmin, xmax, ymin, ymax;
+      iter2->get_extremes(xmin, xmax, ymin, ymax);
+      plot_data_range_x[0] = std::min(plot_data_range_x[0], xmin);
+      plot_data_range_x[1] = std::max(plot_data_range_x[1], xmax);
+      plot_data_range_y[0] = std::min(plot_data_range_y[0], ymin);
+      plot_data_range_y[1] = std::max(plot_data_range_y[1], ymax);
+    }
   }
 
-  plot_data_range_x[0] = *std::min_element(min_x.begin(), min_x.end());
-  plot_data_range_x[1] = *std::max_element(max_x.begin(), max_x.end());
-  plot_data_range_y[0] = *std::min_element(min_y.begin(), min_y.end());
-  plot_data_range_y[1] = *std::max_element(max_y.begin(), max_y.end());
-
   coordinate_transform_world_to_plplot(
     plot_data_range_x[0], plot_data_range_y[0],
     plot_data_range_x[0], plot_data_range_y[0]
@@ -111,7 +111,7 @@ void Plot2D::plot_data_modified() {
   plotted_range_y[0] = plot_data_range_y[0];
   plotted_range_y[1] = plot_data_range_y[1];
 
-  _signal_changed.emit();
+  notify_changed();
 }
 
 void Plot2D::add_data(PlotData2D &data) {
@@ -121,8 +121,8 @@ void Plot2D::add_data(PlotData2D &data) {
     throw Exception("Gtk::PLplot::Plot2D::add_data -> Data has been added before to this plot");
 
   plot_data.push_back(&data);
-  data.signal_changed().connect([this](){_signal_changed.emit();});
-  data.signal_data_modified().connect([this](){plot_data_modified();});
+  data.signal_changed().connect([this](){notify_changed();});
+  data.signal_data_modified().connect([this](){notify_data_modified();});
 
   _signal_data_added.emit(&data);
 }
@@ -134,7 +134,7 @@ void Plot2D::add_object(PlotObject2D &object) {
     throw Exception("Gtk::PLplot::Plot2D::add_object -> Object has been added before to this plot");
 
   plot_objects.push_back(&object);
-  object.signal_changed().connect([this](){_signal_changed.emit();});
+  object.signal_changed().connect([this](){notify_changed();});
 
   _signal_object_added.emit(&object);
 }
@@ -171,14 +171,15 @@ void Plot2D::set_axis_logarithmic_x(bool _log10) {
   if (_log10) {
     for (auto &iter : plot_data) {
       auto iter2 = dynamic_cast<PlotData2D*>(iter);
-      std::vector<double> x = iter2->get_vector_x();
-      if (std::count_if(x.begin(), x.end(), std::bind2nd(std::less_equal<double>(), double(0.0))) > 0) {
+      double xmin, xmax, ymin, ymax;
+      iter2->get_extremes(xmin, xmax, ymin, ymax);
+      if (xmin <= 0.0) {
         throw Exception("Gtkmm::Plplot::Plot2D::set_axis_logarithmic_x -> plot X-values must be strictly positive");
       }
     }
   }
   log10_x = _log10;
-  plot_data_modified();
+  notify_data_modified();
 }
 
 void Plot2D::set_axis_logarithmic_y(bool _log10) {
@@ -186,14 +187,15 @@ void Plot2D::set_axis_logarithmic_y(bool _log10) {
   if (_log10) {
     for (auto &iter : plot_data) {
       auto iter2 = dynamic_cast<PlotData2D*>(iter);
-      std::vector<double> y = iter2->get_vector_y();
-      if (std::count_if(y.begin(), y.end(), std::bind2nd(std::less_equal<double>(), double(0.0))) > 0) {
+      double xmin, xmax, ymin, ymax;
+      iter2->get_extremes(xmin, xmax, ymin, ymax);
+      if (ymin <= 0.0) {
         throw Exception("Gtkmm::Plplot::Plot2D::set_axis_logarithmic_y -> plot Y-values must be strictly positive");
       }
     }
   }
   log10_y = _log10;
-  plot_data_modified();
+  notify_data_modified();
 }
 
 bool Plot2D::get_axis_logarithmic_x() {
@@ -206,7 +208,7 @@ bool Plot2D::get_axis_logarithmic_y() {
 
 void Plot2D::set_box_style(BoxStyle _box_style) {
   box_style = _box_style;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 BoxStyle Plot2D::get_box_style() {
@@ -293,7 +295,26 @@ void Plot2D::draw_plot(const Cairo::RefPtr<Cairo::Context> &cr, const int width,
   //hook up the coordinate transform
   pls->stransform(&Plot2D::coordinate_transform_world_to_plplot, this);
 
+  //the number of device pixel columns covered by the plot window, which allows the datasets to cull and decimate their lines
+  double viewport_xmin, viewport_xmax, viewport_ymin, viewport_ymax;
+  pls->gvpd(viewport_xmin, viewport_xmax, viewport_ymin, viewport_ymax);
+  double viewport_width = (viewport_xmax - viewport_xmin) * plot_width, viewport_height = 0.0;
+  cr->user_to_device_distance(viewport_width, viewport_height);
+  double device_scale_x = 1.0, device_scale_y = 1.0;
+#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE(1, 14, 0)
+  cairo_surface_get_device_scale(cr->get_target()->cobj(), &device_scale_x, &device_scale_y);
+#endif
+  const int columns = static_cast<int>(std::ceil(std::fabs(viewport_width) * device_scale_x));
+
   for (auto &iter : plot_data) {
+    auto iter2 = dynamic_cast<PlotData2D*>(iter);
+    iter2->view_columns = columns;
+    iter2->view_range_x[0] = plotted_range_x[0];
+    iter2->view_range_x[1] = plotted_range_x[1];
+    iter2->view_range_y[0] = plotted_range_y[0];
+    iter2->view_range_y[1] = plotted_range_y[1];
+    iter2->view_log10_x = log10_x;
+    iter2->view_log10_y = log10_y;
     iter->draw_plot_data(cr, pls);
   }
 
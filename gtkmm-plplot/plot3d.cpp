@@ -19,6 +19,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <gtkmm-plplot/exception.h>
 #include <gtkmm-plplot/utils.h>
 #include <iostream>
+#include <limits>
+#include <algorithm>
 #include <gdkmm/rgba.h>
 #include <plstream.h>
 
@@ -68,7 +70,7 @@ void Plot3D::set_altitude(double _altitude) {
   if (_altitude < 0 || _altitude > 90.0)
     throw Exception("Gtk::PLplot::Plot3D::set_altitude -> altitude must be between 0 and 90");
   altitude = _altitude;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 double Plot3D::get_altitude() {
@@ -79,7 +81,7 @@ void Plot3D::set_azimuth(double _azimuth) {
   if (azimuth == _azimuth)
     return;
   azimuth = _azimuth;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 double Plot3D::get_azimuth() {
@@ -88,27 +90,26 @@ double Plot3D::get_azimuth() {
 
 void Plot3D::plot_data_modified() {
   //update ranges
-  std::vector<double> min_x, min_y, min_z;
-  std::vector<double> max_x, max_y, max_z;
+  //the datasets keep track of their own extremes, so this only needs to loop over the datasets
+  plot_data_range_x[0] = plot_data_range_y[0] = plot_data_range_z[0] = std::numeric_limits<double>::max();
+  plot_data_range_x[1] = plot_data_range_y[1] = plot_data_range_z[1] = std::numeric_limits<double>::lowest();
 
   for (auto &iter : plot_data) {
     auto iter2 = dynamic_cast<PlotData3D*>(iter);
-    std::vector<double> x = iter2->get_vector_x();
-    std::vector<double> y = iter2->get_vector_y();
-    std::vector<double> z = iter2->get_vector_z();
-    min_x.push_back(*std::min_element(x.begin(), x.end()));
-    max_x.push_back(*std::max_element(x.begin(), x.end()));
-    min_y.push_back(*std::min_element(y.begin(), y.end()));
-    max_y.push_back(*std::max_element(y.begin(), y.end()));
-    min_z.push_back(*std::min_element(z.begin(), z.end()));
-    max_z.push_back(*std::max_element(z.begin(), z.end()));
+    double xmin, xmax, ymin, ymax, zmin, zmax;
+    iter2->get_extremes(xmin, xmax, ymin, ymax, zmin, zmax);
+    plot_data_range_x[0] = std::min(plot_data_range_x[0], xmin);
+    plot_data_range_x[1] = std::max(plot_data_range_x[1], xmax);
+    plot_data_range_y[0] = std::min(plot_data_range_y[0], ymin);
+    plot_data_range_y[1] = std::max(plot_data_range_y[1], ymax);
+    plot_data_range_z[0] = std::min(plot_data_range_z[0], zmin);
+    plot_data_range_z[1] = std::max(plot_data_range_z[1], zmax);
+  }
+
+  if (plot_data.empty()) {
+    plot_data_range_x[0] = plot_data_range_y[0] = plot_data_range_z[0] = 0.0;
+    plot_data_range_x[1] = plot_data_range_y[1] = plot_data_range_z[1] = 1.0;
   }
-  plot_data_range_x[0] = *std::min_element(min_x.begin(), min_x.end());
-  plot_data_range_x[1] = *std::max_element(max_x.begin(), max_x.end());
-  plot_data_range_y[0] = *std::min_element(min_y.begin(), min_y.end());
-  plot_data_range_y[1] = *std::max_element(max_y.begin(), max_y.end());
-  plot_data_range_z[0] = *std::min_element(min_z.begin(), min_z.end());
-  plot_data_range_z[1] = *std::max_element(max_z.begin(), max_z.end());
 
   plotted_range_x[0] = plot_data_range_x[0];
   plotted_range_x[1] = plot_data_range_x[1];
@@ -117,7 +118,7 @@ void Plot3D::plot_data_modified() {
   plotted_range_z[0] = plot_data_range_z[0];
   plotted_range_z[1] = plot_data_range_z[1];
 
-  _signal_changed.emit();
+  notify_changed();
 }
 
 void Plot3D::add_data(PlotData3D &data) {
@@ -127,8 +128,8 @@ void Plot3D::add_data(PlotData3D &data) {
     throw Exception("Gtk::PLplot::Plot3D::add_data -> Data has been added before to this plot");
 
   plot_data.push_back(&data);
-  data.signal_changed().connect([this](){_signal_changed.emit();});
-  data.signal_data_modified().connect([this](){plot_data_modified();});
+  data.signal_changed().connect([this](){notify_changed();});
+  data.signal_data_modified().connect([this](){notify_data_modified();});
 
   _signal_data_added.emit(&data);
 }
@@ -19,6 +19,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <gtkmm-plplot/exception.h>
 #include <gtkmm-plplot/utils.h>
 #include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <limits>
 #include <plConfig.h>
 #include <plstream.h>
 
@@ -28,6 +33,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 	#define PLCALLBACK plstream
 #endif
 
+#define PLOTCONTOUR_LABEL_SPACING 0.3
+#define PLOTCONTOUR_LABEL_SIZE 0.6
+#define PLOTCONTOUR_VISIBLE_MARGIN 1
+
 using namespace Gtk::PLplot;
 
 PlotContour::PlotContour(
@@ -50,7 +59,17 @@ PlotContour::PlotContour(
   edge_color(_edge_color),
   edge_width(_edge_width),
 	showing_labels(true),
-  clevels(_nlevels) {
+  labels_exponent_limit(4),
+  labels_significant_digits(2),
+  zmin(std::numeric_limits<double>::quiet_NaN()),
+  zmax(std::numeric_limits<double>::quiet_NaN()),
+  clevels(_nlevels),
+  contour_tiles_valid(false),
+  contour_tiles_level(0),
+  contour_tiles_dirty{0, 0, 0, 0},
+  export_tiles_valid(false),
+  export_tiles_dirty{0, 0, 0, 0},
+  data_region_pending{0, 0, 0, 0} {
   //ensure edge_width is strictly positive
   if (edge_width <= 0.0) {
     throw Exception("Gtk::PLplot::PlotContour::PlotContour-> edge width must be strictly positive");
@@ -87,8 +106,8 @@ PlotContour::~PlotContour() {}
 
 void PlotContour::plot_data_modified() {
   auto data = dynamic_cast<PlotDataSurface*>(plot_data[0]);
-  std::vector<double> x = data->get_vector_x();
-  std::vector<double> y = data->get_vector_y();
+  const std::vector<double> &x = data->get_data_x();
+  const std::vector<double> &y = data->get_data_y();
 
   plot_data_range_x[0] = x.front();
   plot_data_range_x[1] = x.back();
@@ -111,17 +130,31 @@ void PlotContour::plot_data_modified() {
   plotted_range_y[0] = plot_data_range_y[0];
   plotted_range_y[1] = plot_data_range_y[1];
 
-  //get maximum of z
-  double **z = data->get_array2d_z();
-  plMinMax2dGrid(z, x.size(), y.size(), &zmax, &zmin);
-  free_array2d((void **) z, x.size());
+  //get the extremes of z: the dataset keeps track of these incrementally
+  double new_zmin, new_zmax;
+  data->get_extremes_z(new_zmin, new_zmax);
 
-  //fill up level
-  for (unsigned int i = 0 ; i < nlevels ; i++) {
-    clevels[i] = zmin + (zmax - zmin) * i / (double) (nlevels - 1);
+  std::size_t region[4];
+  std::copy(data_region_pending, data_region_pending + 4, region);
+  data_region_pending[0] = data_region_pending[2] = 0;
+
+  //zmin and zmax are NaN until the data is first looked at
+  if (new_zmin != zmin || new_zmax != zmax) {
+    zmin = new_zmin;
+    zmax = new_zmax;
+
+    //fill up level
+    for (unsigned int i = 0 ; i < nlevels ; i++) {
+      clevels[i] = zmin + (zmax - zmin) * i / (double) (nlevels - 1);
+    }
+    plot_levels_modified();
+  }
+  else if (region[0] < region[2] && region[1] < region[3]) {
+    //the levels remain the same, so only the modified part of the grid needs to be looked at again
+    plot_data_region_modified(region[0], region[1], region[2] - region[0], region[3] - region[1]);
   }
 
-  _signal_changed.emit();
+  notify_changed();
 }
 
 void PlotContour::add_data(PlotDataSurface &data) {
@@ -130,15 +163,21 @@ void PlotContour::add_data(PlotDataSurface &data) {
     throw Exception("Gtk::PLplot::PlotContour::add_data -> cannot add data when plot_data is not empty!");
 
   plot_data.push_back(&data);
-  data.signal_changed().connect([this](){_signal_changed.emit();});
-  data.signal_data_modified().connect([this](){plot_data_modified();});
+  data.signal_changed().connect([this](){notify_changed();});
+  data.signal_data_modified().connect([this, &data](){
+    //the plot may postpone plot_data_modified(), so keep track of all regions that were modified in the meantime
+    std::size_t ix0, iy0, nx, ny;
+    data.get_modified_region(ix0, iy0, nx, ny);
+    merge_grid_region(data_region_pending, ix0, iy0, nx, ny);
+    notify_data_modified();
+  });
 
   _signal_data_added.emit(&data);
 }
 
 void PlotContour::set_edge_color(Gdk::RGBA _edge_color) {
   edge_color = _edge_color;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 Gdk::RGBA PlotContour::get_edge_color() {
@@ -152,7 +191,7 @@ void PlotContour::set_edge_width(double _edge_width) {
   }
 
   edge_width = _edge_width;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 double PlotContour::get_edge_width() {
@@ -176,7 +215,8 @@ void PlotContour::set_nlevels(unsigned int _nlevels) {
   for (unsigned int i = 0 ; i < nlevels ; i++) {
     clevels[i] = zmin + (zmax - zmin) * i / (double) (nlevels - 1);
   }
-  _signal_changed.emit();
+  plot_levels_modified();
+  notify_changed();
 }
 
 unsigned int PlotContour::get_nlevels() {
@@ -187,20 +227,275 @@ void PlotContour::show_labels() {
 	if (showing_labels)
 		return;
 	showing_labels = true;
-	_signal_changed.emit();
+	notify_changed();
 }
 
 void PlotContour::hide_labels() {
 	if (!showing_labels)
 		return;
 	showing_labels = false;
-	_signal_changed.emit();
+	notify_changed();
 }
 
 bool PlotContour::is_showing_labels() const {
 	return showing_labels;
 }
 
+void PlotContour::set_labels_format(int exponent_limit, int significant_digits) {
+  if (exponent_limit < 0) {
+    throw Exception("Gtk::PLplot::PlotContour::set_labels_format -> exponent_limit cannot be negative");
+  }
+  if (significant_digits < 1) {
+    throw Exception("Gtk::PLplot::PlotContour::set_labels_format -> significant_digits must be at least 1");
+  }
+  if (exponent_limit == labels_exponent_limit && significant_digits == labels_significant_digits)
+    return;
+
+  labels_exponent_limit = exponent_limit;
+  labels_significant_digits = significant_digits;
+  notify_changed();
+}
+
+void PlotContour::get_labels_format(int &exponent_limit, int &significant_digits) {
+  exponent_limit = labels_exponent_limit;
+  significant_digits = labels_significant_digits;
+}
+
+void PlotContour::plot_data_region_modified(std::size_t ix0, std::size_t iy0, std::size_t nx, std::size_t ny) {
+  merge_grid_region(contour_tiles_dirty, ix0, iy0, nx, ny);
+  merge_grid_region(export_tiles_dirty, ix0, iy0, nx, ny);
+}
+
+void PlotContour::plot_levels_modified() {
+  contour_tiles_valid = false;
+  export_tiles_valid = false;
+}
+
+void PlotContour::update_contour_tiles(unsigned int level) {
+  auto data = dynamic_cast<PlotDataSurface*>(plot_data[0]);
+
+  if (!contour_tiles_valid || level != contour_tiles_level) {
+    const SurfacePyramidLevel &grid = data->get_pyramid_level(level);
+    contour_tiles.reset(grid.get_data_x().size(), grid.get_data_y().size(), clevels);
+    contour_tiles_valid = true;
+    contour_tiles_level = level;
+  }
+  else if (contour_tiles_dirty[0] < contour_tiles_dirty[2] && contour_tiles_dirty[1] < contour_tiles_dirty[3]) {
+    std::size_t region[4];
+    pyramid_grid_region(contour_tiles_dirty, level, region);
+    contour_tiles.invalidate(region[0], region[1], region[2] - region[0], region[3] - region[1]);
+  }
+  contour_tiles_dirty[0] = contour_tiles_dirty[2] = 0;
+}
+
+const std::vector<ContourLine> &PlotContour::get_contour_lines() {
+  auto data = dynamic_cast<PlotDataSurface*>(plot_data[0]);
+  const std::vector<double> &x = data->get_data_x();
+  const std::vector<double> &y = data->get_data_y();
+
+  //a separate cache, to avoid throwing away the lines traced at the resolution of the display
+  if (!export_tiles_valid) {
+    export_tiles.reset(x.size(), y.size(), clevels);
+    export_tiles_valid = true;
+  }
+  else if (export_tiles_dirty[0] < export_tiles_dirty[2] && export_tiles_dirty[1] < export_tiles_dirty[3]) {
+    export_tiles.invalidate(export_tiles_dirty[0], export_tiles_dirty[1], export_tiles_dirty[2] - export_tiles_dirty[0], export_tiles_dirty[3] - export_tiles_dirty[1]);
+  }
+  export_tiles_dirty[0] = export_tiles_dirty[2] = 0;
+
+  return export_tiles.get_lines(data->get_strided_data_z(), x, y);
+}
+
+//find the grid points that span the currently plotted range: the last one below the lower bound up to the first one above the upper bound
+static void visible_grid_window(const std::vector<double> &grid, double lower, double upper, std::size_t &first, std::size_t &n) {
+  std::size_t begin = std::upper_bound(grid.begin(), grid.end(), lower) - grid.begin();
+  std::size_t end = std::lower_bound(grid.begin(), grid.end(), upper) - grid.begin();
+
+  begin = begin > PLOTCONTOUR_VISIBLE_MARGIN ? begin - 1 - PLOTCONTOUR_VISIBLE_MARGIN : 0;
+  end = std::min<std::size_t>(end + 1 + PLOTCONTOUR_VISIBLE_MARGIN, grid.size());
+
+  //there must be at least one cell
+  if (end < begin + 2) {
+    end = std::min<std::size_t>(std::max<std::size_t>(end, 2), grid.size());
+    begin = end - 2;
+  }
+
+  first = begin;
+  n = end - begin;
+}
+
+void PlotContour::get_visible_region(const SurfacePyramidLevel &grid, std::size_t &ix0, std::size_t &iy0, std::size_t &nx, std::size_t &ny) {
+  visible_grid_window(grid.get_data_x(), std::min(plotted_range_x[0], plotted_range_x[1]), std::max(plotted_range_x[0], plotted_range_x[1]), ix0, nx);
+  visible_grid_window(grid.get_data_y(), std::min(plotted_range_y[0], plotted_range_y[1]), std::max(plotted_range_y[0], plotted_range_y[1]), iy0, ny);
+}
+
+unsigned int PlotContour::select_pyramid_level() {
+  auto data = dynamic_cast<PlotDataSurface*>(plot_data[0]);
+
+  //the size of the plot window
+  double nxmin, nxmax, nymin, nymax;
+  pls->gvpd(nxmin, nxmax, nymin, nymax);
+  const double pixels_x = plot_width * (nxmax - nxmin);
+  const double pixels_y = plot_height * (nymax - nymin);
+
+  std::size_t ix0, iy0, nx, ny;
+  get_visible_region(data->get_pyramid_level(0), ix0, iy0, nx, ny);
+
+  //every level halves the number of grid points in view
+  unsigned int level = 0;
+  while (level + 1 < data->get_pyramid_levels() &&
+         (nx >> (level + 1)) >= pixels_x &&
+         (ny >> (level + 1)) >= pixels_y)
+    level++;
+
+  return level;
+}
+
+void PlotContour::draw_contour_lines() {
+  auto data = dynamic_cast<PlotDataSurface*>(plot_data[0]);
+  const unsigned int level = select_pyramid_level();
+  const SurfacePyramidLevel &grid = data->get_pyramid_level(level);
+  const std::vector<double> &x = grid.get_data_x();
+  const std::vector<double> &y = grid.get_data_y();
+
+  update_contour_tiles(level);
+
+  std::size_t ix0, iy0, nx, ny;
+  get_visible_region(grid, ix0, iy0, nx, ny);
+
+  //stroke the cached contour lines: only the tiles in view are traced, and only when the data or the levels change.
+  //labels are placed along the lines stitched together from the fragments of these tiles, which are cut off at the border of the tiles in view.
+  //otherwise the fragments are drawn as they are
+  std::vector<const ContourLine *> lines;
+  if (is_showing_labels()) {
+    for (auto &line : contour_tiles.get_region_lines(grid.get_data_z(), x, y, ix0, iy0, nx, ny))
+      lines.push_back(&line);
+    draw_labelled_lines(lines);
+    return;
+  }
+
+  contour_tiles.get_fragments(grid.get_data_z(), x, y, ix0, iy0, nx, ny, lines);
+
+  for (auto line : lines)
+    pls->line(line->get_x().size(), line->get_x().data(), line->get_y().data());
+}
+
+//format a contour level the way plcont() does: in fixed-point notation, unless the absolute value of its decimal exponent reaches exponent_limit
+static void format_contour_label(double value, int exponent_limit, int significant_digits, char *label, std::size_t size) {
+  const int exponent = value == 0.0 ? 0 : static_cast<int>(std::floor(std::log10(std::fabs(value))));
+
+  if (std::abs(exponent) < exponent_limit)
+    snprintf(label, size, "%.*f", std::max(significant_digits - 1 - exponent, 0), value);
+  else
+    snprintf(label, size, "%.*fx10#u%d#d", significant_digits - 1, value / std::pow(10.0, exponent), exponent);
+}
+
+void PlotContour::draw_labelled_lines(const std::vector<const ContourLine *> &lines) {
+  pls->schr(0, PLOTCONTOUR_LABEL_SIZE);
+
+  //distances along the lines are measured in mm on the page, which requires the size of the plot window
+  double page_xmin, page_xmax, page_ymin, page_ymax;
+  pls->gspa(page_xmin, page_xmax, page_ymin, page_ymax);
+  double nxmin, nxmax, nymin, nymax;
+  pls->gvpd(nxmin, nxmax, nymin, nymax);
+  const double window_width = (page_xmax - page_xmin) * (nxmax - nxmin);
+  const double window_height = (page_ymax - page_ymin) * (nymax - nymin);
+  const double scale_x = window_width / (plotted_range_x[1] - plotted_range_x[0]);
+  const double scale_y = window_height / (plotted_range_y[1] - plotted_range_y[0]);
+  const double spacing = PLOTCONTOUR_LABEL_SPACING * std::min(window_width, window_height);
+
+  double char_default, char_height;
+  pls->gchr(char_default, char_height);
+
+  char label[64];
+  std::vector<double> length, gaps, piece_x, piece_y;
+
+  auto flush_piece = [&]() {
+    if (piece_x.size() >= 2)
+      pls->line(piece_x.size(), piece_x.data(), piece_y.data());
+    piece_x.clear();
+    piece_y.clear();
+  };
+
+  for (auto line : lines) {
+    const std::vector<double> &x = line->get_x();
+    const std::vector<double> &y = line->get_y();
+    const std::size_t n = x.size();
+
+    //the distance of each vertex from the start of the line
+    length.resize(n);
+    length[0] = 0.0;
+    for (std::size_t i = 1 ; i < n ; i++)
+      length[i] = length[i - 1] + std::hypot((x[i] - x[i - 1]) * scale_x, (y[i] - y[i - 1]) * scale_y);
+
+    //the labels are centered on the line, which is interrupted for the width of the label plus some room on either side.
+    //their width is estimated from the number of characters that are visible, skipping PLplot's escape sequences
+    format_contour_label(line->get_level(), labels_exponent_limit, labels_significant_digits, label, sizeof(label));
+    std::size_t visible_chars = 0;
+    for (const char *c = label ; *c ; c++) {
+      if (*c == '#' && c[1]) {
+        c++;
+        continue;
+      }
+      visible_chars++;
+    }
+    const double half_gap = (0.8 * visible_chars + 1.0) * char_height / 2.0;
+
+    gaps.clear();
+    for (double center = spacing / 2.0 ; center + half_gap <= length[n - 1] ; center += spacing) {
+      if (center < half_gap)
+        continue;
+      gaps.push_back(center - half_gap);
+      gaps.push_back(center + half_gap);
+    }
+
+    //stroke the line, leaving out the gaps
+    auto add_point = [&](std::size_t i, double distance) {
+      const double segment = length[i] - length[i - 1];
+      const double fraction = segment > 0.0 ? (distance - length[i - 1]) / segment : 0.0;
+      piece_x.push_back(x[i - 1] + fraction * (x[i] - x[i - 1]));
+      piece_y.push_back(y[i - 1] + fraction * (y[i] - y[i - 1]));
+    };
+
+    std::size_t gap = 0;
+    piece_x.assign(1, x[0]);
+    piece_y.assign(1, y[0]);
+    for (std::size_t i = 1 ; i < n ; i++) {
+      //gap boundaries alternate between starts and ends
+      for ( ; gap < gaps.size() && gaps[gap] <= length[i] ; gap++) {
+        add_point(i, gaps[gap]);
+        if (gap % 2 == 0)
+          flush_piece();
+      }
+      if (gap % 2 == 0) {
+        piece_x.push_back(x[i]);
+        piece_y.push_back(y[i]);
+      }
+    }
+    flush_piece();
+
+    //write the labels in the gaps, along the segment that holds their center
+    std::size_t i = 1;
+    for (std::size_t label_gap = 0 ; label_gap < gaps.size() ; label_gap += 2) {
+      const double center = (gaps[label_gap] + gaps[label_gap + 1]) / 2.0;
+      while (i + 1 < n && length[i] < center)
+        i++;
+      add_point(i, center);
+      double dx = x[i] - x[i - 1];
+      double dy = y[i] - y[i - 1];
+
+      //keep the text upright
+      if (dx < 0.0 || (dx == 0.0 && dy < 0.0)) {
+        dx = -dx;
+        dy = -dy;
+      }
+      pls->ptex(piece_x.back(), piece_y.back(), dx, dy, 0.5, label);
+      piece_x.clear();
+      piece_y.clear();
+    }
+  }
+}
+
 void PlotContour::draw_plot(const Cairo::RefPtr<Cairo::Context> &cr, const int width, const int height) {
   if (!shown)
     return;
@@ -229,21 +524,7 @@ void PlotContour::draw_plot(const Cairo::RefPtr<Cairo::Context> &cr, const int w
 
   pls->width(edge_width);
 
-  auto data = dynamic_cast<PlotDataSurface*>(plot_data[0]);
-  std::vector<double> x = data->get_vector_x();
-  std::vector<double> y = data->get_vector_y();
-  PLcGrid cgrid;
-  cgrid.xg = &x[0];
-  cgrid.yg = &y[0];
-  cgrid.nx = x.size();
-  cgrid.ny = y.size();
-  double **z = data->get_array2d_z();
-
-	pls->setcontlabelparam(0.01, 0.6, 0.1, is_showing_labels());
-
-  pls->cont(z, x.size(), y.size(), 1, x.size(), 1, y.size(), &clevels[0], nlevels, PLCALLBACK::tr1, (void *) &cgrid);
-
-  free_array2d((void **) z, x.size());
+  draw_contour_lines();
 
   cr->restore();
 
@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <gtkmm-plplot/plot.h>
 #include <gtkmm-plplot/regionselection.h>
 #include <gtkmm-plplot/plotdatasurface.h>
+#include <gtkmm-plplot/contourline.h>
 #include <gtkmm-plplot/enums.h>
 
 
@@ -35,6 +36,12 @@ namespace Gtk {
      *  PlotContour features several properties that determine the appearance of the contour.
      *  Important is that whenever a property is changed, \c signal_changed() is emitted, which will eventually
      *  be picked up by the \c canvas that will hold the plot.
+     *  The contour lines are traced only once after the data or the contour levels have changed, and are cached as ContourLine
+     *  objects, which are simply stroked whenever the plot is redrawn. They are available through get_contour_lines().
+     *  When only a part of the dataset is modified, as with PlotDataSurface::update_region(), and its extremes remain the same,
+     *  only the tiles of the ContourTiles cache that touch the modified grid points are traced again.
+     *  After zooming in, only the tiles that are in view are traced and drawn, so the cost of a redraw is proportional to the number of visible cells.
+     *  Grids with more points than the plot has pixels are contoured at a reduced resolution, picked from the display-resolution pyramid of the dataset.
      *  For more information, the reader is referred to example \ref example7.
      */
     class PlotContour : public Plot, public RegionSelection {
@@ -42,18 +49,84 @@ namespace Gtk {
       PlotContour() = delete; ///< no default constructor
       PlotContour(const PlotContour &) = delete; ///< no copy constructor
       PlotContour &operator=(const PlotContour &) = delete; ///< no assignment operator
+
+      /** Stroke contour lines and draw their labels
+       *
+       * Labels are spread out evenly along each line, at intervals that depend on the size of the plot window, and the line is interrupted underneath each of them.
+       * \param lines the complete, stitched contour lines
+       */
+      void draw_labelled_lines(const std::vector<const ContourLine *> &lines);
+
+      /** Bring \c contour_tiles up to date with the levels and the modifications of the data, without tracing anything yet
+       *
+       * \param level the level of the display-resolution pyramid of the dataset that will be contoured
+       */
+      void update_contour_tiles(unsigned int level);
     protected:
       unsigned int nlevels; ///< Number of contour levels to draw
       Gdk::RGBA edge_color; ///< Defines pen color used for contours defining edges.
       double edge_width; ///< Defines line width used for contours defining edges.
       bool showing_labels; ///< \c true will draw the contour labels, \c false hides them
+      int labels_exponent_limit; ///< labels of values whose decimal exponent reaches this limit in absolute value are written in exponential notation
+      int labels_significant_digits; ///< the number of significant digits of the labels
       //TODO: add BoxStyle???
       double zmin; ///< Minimum of \c z, used to determine the contour edges
       double zmax; ///< Maximum of \c z, used to determine the contour edges
       std::vector<double> clevels; ///< Vector containing the data levels corresponding to the edges of each region that will be plotted. To work properly the levels should be monotonic.
+      ContourTiles contour_tiles; ///< the cached contour lines, organized in tiles that can be traced again separately
+      bool contour_tiles_valid; ///< \c false if \c contour_tiles needs to be traced again from scratch before it can be used
+      unsigned int contour_tiles_level; ///< the level of the display-resolution pyramid of the dataset that \c contour_tiles holds the contour lines of
+      std::size_t contour_tiles_dirty[4]; ///< the rectangle of grid points at full resolution that was modified since \c contour_tiles was last traced, in the format used by merge_grid_region()
+      ContourTiles export_tiles; ///< the cached contour lines at full resolution, as returned by get_contour_lines(), kept apart from \c contour_tiles which follows the resolution of the display
+      bool export_tiles_valid; ///< \c false if \c export_tiles needs to be traced again from scratch before it can be used
+      std::size_t export_tiles_dirty[4]; ///< the rectangle of grid points that was modified since \c export_tiles was last traced, in the format used by merge_grid_region()
+      std::size_t data_region_pending[4]; ///< the rectangle of grid points that was modified since plot_data_modified() was last called
 
       virtual void plot_data_modified() override; ///< a method that will update the \c _range variables when datasets are added, modified or removed.
 
+      /** Called by plot_data_modified() when the extremes of the dataset did not change, and only a rectangle of its grid points needs to be redrawn
+       *
+       * Derived classes that cache geometry of their own should override this method to mark the affected part as outdated, and call the base class method.
+       * \param ix0 the first index of the rectangle along the first dimension
+       * \param iy0 the first index of the rectangle along the second dimension
+       * \param nx the extent of the rectangle along the first dimension
+       * \param ny the extent of the rectangle along the second dimension
+       */
+      virtual void plot_data_region_modified(std::size_t ix0, std::size_t iy0, std::size_t nx, std::size_t ny);
+
+      /** Called when the levels of the contours are recalculated, because the extremes of the dataset or the number of levels changed
+       *
+       * All cached contour lines are discarded. Derived classes that cache geometry of their own should override this method to discard it as well, and call the base class method.
+       */
+      virtual void plot_levels_modified();
+
+      /** Stroke the cached contour lines, using the current color and line width, and draw their labels if requested
+       *
+       * Only the tiles of the contour cache that are in view are traced. When labels are shown, their fragments are stitched together first,
+       * so that the labels are placed along polylines that run up to the border of these tiles.
+       */
+      void draw_contour_lines();
+
+      /** Get the rectangle of grid points that covers the currently plotted range
+       *
+       * The rectangle is found by binary search of the grid coordinates, and contains a margin of one grid point on either side
+       * of the cells that are in view. It always contains at least one cell.
+       * \param grid the level of the display-resolution pyramid of the dataset
+       * \param ix0 the first index of the rectangle along the first dimension
+       * \param iy0 the first index of the rectangle along the second dimension
+       * \param nx the extent of the rectangle along the first dimension
+       * \param ny the extent of the rectangle along the second dimension
+       */
+      void get_visible_region(const SurfacePyramidLevel &grid, std::size_t &ix0, std::size_t &iy0, std::size_t &nx, std::size_t &ny);
+
+      /** Pick the level of the display-resolution pyramid of the dataset that matches the current size of the plot window and zoom
+       *
+       * This is the coarsest level that still has at least as many grid points in view as the plot window has pixels along both dimensions.
+       * Must be called after the viewport and window of the plot have been set.
+       * \returns the level
+       */
+      unsigned int select_pyramid_level();
+
       /** Constructor
        *
        * This protected constructor is meant to be used in derived classes only to circumvent the problem of calling add_data() in a constructor which calls PlotContour's public constructor.
@@ -177,6 +250,33 @@ namespace Gtk {
        */
       bool is_showing_labels() const;
 
+      /** Set the number format of the contour labels
+       *
+       * The meaning of the arguments is the same as for PLplot's \c plsetcontlabelformat(), and the labels of PlotContourShades use the same format when drawn by PLplot.
+       * Values whose decimal exponent is less than \c exponent_limit in absolute value are written in fixed-point notation, all others in exponential notation.
+       * The default corresponds to PLplot's: an exponent limit of 4 and 2 significant digits.
+       * \param exponent_limit the smallest absolute value of the exponent that requires exponential notation
+       * \param significant_digits the number of significant digits
+       * \exception Gtk::PLplot::Exception
+       */
+      void set_labels_format(int exponent_limit, int significant_digits);
+
+      /** Get the number format of the contour labels
+       *
+       * \param exponent_limit the smallest absolute value of the exponent that requires exponential notation
+       * \param significant_digits the number of significant digits
+       */
+      void get_labels_format(int &exponent_limit, int &significant_digits);
+
+      /** Get the contour lines of the plot
+       *
+       * The contour lines are traced if the data or the number of levels changed since the last call, and are cached otherwise.
+       * If only a part of the data changed, only the tiles of the grid that are affected are traced again.
+       * The lines are traced at full resolution, regardless of the resolution at which the plot is drawn, and are cached separately from the lines used for drawing the plot.
+       * \returns a reference to the contour lines, which remains valid until the next call of this method
+       */
+      const std::vector<ContourLine> &get_contour_lines();
+
       /** Method to draw the plot with all of its datasets
        *
        * This method is virtual allowing inheriting classes to implement their own method with the same signature.
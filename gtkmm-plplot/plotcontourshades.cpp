@@ -20,6 +20,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <gtkmm-plplot/exception.h>
 #include <gtkmm-plplot/utils.h>
 #include <iostream>
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <cmath>
+#include <cstdint>
 #include <plConfig.h>
 #include <plstream.h>
 
@@ -29,8 +34,78 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 	#define PLCALLBACK plstream
 #endif
 
+#define PLOTCONTOURSHADES_RASTER_MIN_ROWS_PER_THREAD 64
+
 using namespace Gtk::PLplot;
 
+// find for each pixel along an axis the grid cell its center falls into, and its relative position within that cell.
+// the center of pixel p has world coordinate start + (p + 0.5) * step. Pixels outside of the grid get cell -1.
+static void map_pixels_to_grid(const std::vector<double> &grid, double start, double step, std::size_t npixels,
+                               std::vector<long> &cell, std::vector<double> &fraction) {
+  cell.resize(npixels);
+  fraction.resize(npixels);
+
+  for (std::size_t p = 0 ; p < npixels ; p++) {
+    const double world = start + (p + 0.5) * step;
+    if (world < grid.front() || world > grid.back()) {
+      cell[p] = -1;
+      fraction[p] = 0.0;
+      continue;
+    }
+    const long i = std::min<long>(std::upper_bound(grid.begin(), grid.end(), world) - grid.begin() - 1, grid.size() - 2);
+    cell[p] = i;
+    fraction[p] = (world - grid[i]) / (grid[i + 1] - grid[i]);
+  }
+}
+
+// fill columns [column_first, column_last) of rows [first, last) of the transposed image: row r corresponds to column r of device pixels, and its elements run from the top of the plot window to the bottom.
+static void rasterize_rows(StridedArray2D z,
+                           const std::vector<long> &cell_x, const std::vector<double> &fraction_x,
+                           const std::vector<long> &cell_y, const std::vector<double> &fraction_y,
+                           double zmin, double zmax, unsigned int nlevels, const std::vector<uint32_t> &lut,
+                           unsigned char *data, int stride, std::size_t first, std::size_t last,
+                           std::size_t column_first, std::size_t column_last) {
+  const std::size_t ncolumns = cell_y.size();
+  std::vector<double> values(ncolumns);
+
+  for (std::size_t r = first ; r < last ; r++) {
+    uint32_t *row = reinterpret_cast<uint32_t *>(data + r * stride);
+    const long i = cell_x[r];
+    if (i < 0) {
+      std::fill(row + column_first, row + column_last, 0);
+      continue;
+    }
+
+    //interpolate bilinearly between the corners of the cells
+    const double fx = fraction_x[r];
+    for (std::size_t c = column_first ; c < column_last ; c++) {
+      const long j = cell_y[c];
+      if (j < 0) {
+        values[c] = std::numeric_limits<double>::quiet_NaN();
+        continue;
+      }
+      const double fy = fraction_y[c];
+      values[c] = (1.0 - fx) * ((1.0 - fy) * z(i, j) + fy * z(i, j + 1)) +
+                  fx * ((1.0 - fy) * z(i + 1, j) + fy * z(i + 1, j + 1));
+    }
+
+    map_values_to_shades(values.data() + column_first, column_last - column_first, zmin, zmax, nlevels, lut, row + column_first);
+  }
+}
+
+// the part of a grid that is passed to PLplot, which reads it through shades_grid_eval() in the manner of a PLfGrid2,
+// allowing strided grids to be shaded without first copying them into an array of arrays
+struct ShadesGrid {
+  StridedArray2D z;
+  std::size_t ix0;
+  std::size_t iy0;
+};
+
+static PLFLT shades_grid_eval(PLINT ix, PLINT iy, PLPointer p) {
+  const ShadesGrid *grid = static_cast<const ShadesGrid *>(p);
+  return grid->z(grid->ix0 + ix, grid->iy0 + iy);
+}
+
 
 PlotContourShades::PlotContourShades(
   const Glib::ustring &_axis_title_x,
@@ -56,7 +131,9 @@ PlotContourShades::PlotContourShades(
   colorbar_title("Magnitude"),
   colormap_palette(_colormap_palette),
   area_fill_pattern(SOLID),
-  fill_width(PLOTDATA_DEFAULT_LINE_WIDTH) {}
+  fill_width(PLOTDATA_DEFAULT_LINE_WIDTH),
+  shades_rendering(SHADES_POLYGONS),
+  raster_dirty{0, 0, 0, 0} {}
 
 PlotContourShades::PlotContourShades(
   PlotDataSurface &_data,
@@ -88,14 +165,14 @@ void PlotContourShades::show_colorbar() {
   if (showing_colorbar)
     return;
   showing_colorbar = true;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 void PlotContourShades::hide_colorbar() {
   if (!showing_colorbar)
     return;
   showing_colorbar = false;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 bool PlotContourShades::is_showing_colorbar() {
@@ -106,14 +183,14 @@ void PlotContourShades::set_colorbar_title(Glib::ustring _colorbar_title) {
   if (_colorbar_title == colorbar_title)
     return;
   colorbar_title = _colorbar_title;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 void PlotContourShades::set_colormap_palette(ColormapPalette _colormap_palette) {
   if (_colormap_palette == colormap_palette)
     return;
   colormap_palette = _colormap_palette;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 ColormapPalette PlotContourShades::get_colormap_palette() {
@@ -124,7 +201,7 @@ void PlotContourShades::set_area_fill_pattern(AreaFillPattern _area_fill_pattern
   if (_area_fill_pattern == area_fill_pattern)
     return;
   area_fill_pattern = _area_fill_pattern;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 AreaFillPattern PlotContourShades::get_area_fill_pattern() {
@@ -137,25 +214,47 @@ void PlotContourShades::set_area_lines_width(double _width) {
   if (_width <= 0.0)
     throw Exception("Gtk::PLplot::PlotContourShades::set_area_lines_width -> width must be greater than zero");
   fill_width = _width;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 double PlotContourShades::get_area_lines_width() {
   return fill_width;
 }
 
+void PlotContourShades::set_shades_rendering(ShadesRendering _shades_rendering) {
+  if (_shades_rendering == shades_rendering)
+    return;
+  shades_rendering = _shades_rendering;
+  notify_changed();
+}
+
+void PlotContourShades::plot_data_region_modified(std::size_t ix0, std::size_t iy0, std::size_t nx, std::size_t ny) {
+  PlotContour::plot_data_region_modified(ix0, iy0, nx, ny);
+  merge_grid_region(raster_dirty, ix0, iy0, nx, ny);
+}
+
+void PlotContourShades::plot_levels_modified() {
+  PlotContour::plot_levels_modified();
+  //the levels may change and be restored again before the next redraw, so do not rely on raster_key to detect this
+  raster_image = Cairo::RefPtr<Cairo::ImageSurface>();
+}
+
+ShadesRendering PlotContourShades::get_shades_rendering() {
+  return shades_rendering;
+}
+
 void PlotContourShades::show_edges() {
   if (showing_edges)
     return;
   showing_edges = true;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 void PlotContourShades::hide_edges() {
   if (!showing_edges)
     return;
   showing_edges = false;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 bool PlotContourShades::is_showing_edges() {
@@ -181,44 +280,63 @@ void PlotContourShades::draw_plot(const Cairo::RefPtr<Cairo::Context> &cr, const
   //draw the actual plot
   change_plstream_colormap(pls, colormap_palette);
 
-	change_plstream_color(pls, edge_color, false);
-
-	pls->psty(area_fill_pattern);
-
-  auto data = dynamic_cast<PlotDataSurface*>(plot_data[0]);
-  std::vector<double> x = data->get_vector_x();
-  std::vector<double> y = data->get_vector_y();
-  PLcGrid cgrid;
-  cgrid.xg = &x[0];
-  cgrid.yg = &y[0];
-  cgrid.nx = x.size();
-  cgrid.ny = y.size();
-  double **z = data->get_array2d_z();
-
-	int cont_color = GTKMM_PLPLOT_DEFAULT_COLOR_INDEX;
-	double cont_width = edge_width;
-
-	if (!showing_edges) {
-		cont_color = 0;
-		cont_width = 0.0;
-	}
-
-	//this will only work if showing_edges is true!
-	pls->setcontlabelparam(0.01, 0.6, 0.1, is_showing_labels());
-
-	pls->shades(z, x.size(), y.size(), NULL, x.front(), x.back(), y.front(), y.back(),
-              &clevels[0], nlevels, fill_width,
-              cont_color, cont_width,
-              PLCALLBACK::fill, true, PLCALLBACK::tr1, (void *) &cgrid);
-
+  if (shades_rendering == SHADES_RASTER) {
+    draw_raster(cr);
+
+    if (showing_edges) {
+      change_plstream_color(pls, edge_color);
+      pls->width(edge_width);
+      draw_contour_lines();
+    }
+  }
+  else {
+    change_plstream_color(pls, edge_color, false);
+
+    pls->psty(area_fill_pattern);
+
+    auto data = dynamic_cast<PlotDataSurface*>(plot_data[0]);
+    const SurfacePyramidLevel &grid = data->get_pyramid_level(select_pyramid_level());
+    const std::vector<double> &x = grid.get_data_x();
+    const std::vector<double> &y = grid.get_data_y();
+
+    //only pass the part of the grid that is in view to PLplot
+    std::size_t ix0, iy0, nx, ny;
+    get_visible_region(grid, ix0, iy0, nx, ny);
+
+    ShadesGrid zgrid = {grid.get_data_z(), ix0, iy0};
+
+    //PLplot does not modify the grid, even though PLcGrid holds non-const pointers
+    PLcGrid cgrid;
+    cgrid.xg = const_cast<double *>(x.data() + ix0);
+    cgrid.yg = const_cast<double *>(y.data() + iy0);
+    cgrid.nx = nx;
+    cgrid.ny = ny;
+
+    //fill the shades one by one, the way plshades() does, spreading their colors evenly over cmap1
+    for (unsigned int i = 0 ; i + 1 < nlevels ; i++) {
+      const double shade_color = nlevels > 2 ? i / (double) (nlevels - 2) : 0.0;
+      pls->fshade(shades_grid_eval, &zgrid, NULL, NULL, nx, ny,
+                  cgrid.xg[0], cgrid.xg[nx - 1], cgrid.yg[0], cgrid.yg[ny - 1],
+                  clevels[i], clevels[i + 1],
+                  1, shade_color, fill_width,
+                  0, 0.0, 0, 0.0,
+                  PLCALLBACK::fill, true, PLCALLBACK::tr1, (void *) &cgrid);
+    }
+
+    //the edges are drawn afterwards, so the next shade cannot partially cover them
+    if (showing_edges && edge_width > 0.0) {
+      pls->setcontlabelparam(0.01, 0.6, 0.1, is_showing_labels());
+      pls->setcontlabelformat(labels_exponent_limit, labels_significant_digits);
+      pls->col0(GTKMM_PLPLOT_DEFAULT_COLOR_INDEX);
+      pls->width(edge_width);
+      pls->fcont(shades_grid_eval, &zgrid, nx, ny, 1, nx, 1, ny, &clevels[0], nlevels, PLCALLBACK::tr1, (void *) &cgrid);
+    }
+  }
 
   //draw colorbar if requested
   if (showing_colorbar)
     draw_colorbar(cr, pls);
 
-  free_array2d((void **) z, x.size());
-
-
   //plot the box with its axes
   change_plstream_color(pls, axes_color);
   pls->box("bcnst", 0.0, 0, "bcnstv", 0.0, 0);
@@ -231,85 +349,136 @@ void PlotContourShades::draw_plot(const Cairo::RefPtr<Cairo::Context> &cr, const
                                       cairo_range_x[1], cairo_range_y[1]);
 }
 
+void PlotContourShades::draw_raster(const Cairo::RefPtr<Cairo::Context> &cr) {
+  auto data = dynamic_cast<PlotDataSurface*>(plot_data[0]);
+  const unsigned int level = select_pyramid_level();
+  const SurfacePyramidLevel &grid = data->get_pyramid_level(level);
+  const std::vector<double> &x = grid.get_data_x();
+  const std::vector<double> &y = grid.get_data_y();
+  const StridedArray2D z = grid.get_data_z();
+
+  //the plot window, in the coordinates of cr, which has been translated to the top left corner of the plot by draw_plot_init()
+  double nxmin, nxmax, nymin, nymax;
+  double wxmin, wxmax, wymin, wymax;
+  pls->gvpd(nxmin, nxmax, nymin, nymax);
+  pls->gvpw(wxmin, wxmax, wymin, wymax);
+
+  const double left = plot_width * nxmin;
+  const double right = plot_width * nxmax;
+  const double top = plot_height * (1.0 - nymax);
+  const double bottom = plot_height * (1.0 - nymin);
+
+  //one image pixel per device pixel
+  double scale_x = 1.0, scale_y = 1.0;
+  cr->user_to_device_distance(scale_x, scale_y);
+  const int width = std::ceil((right - left) * std::fabs(scale_x));
+  const int height = std::ceil((bottom - top) * std::fabs(scale_y));
+
+  if (width <= 0 || height <= 0 || nlevels < 2 || !(zmax > zmin))
+    return;
+
+  std::vector<long> cell_x, cell_y;
+  std::vector<double> fraction_x, fraction_y;
+  map_pixels_to_grid(x, wxmin, (wxmax - wxmin) / width, width, cell_x, fraction_x);
+  map_pixels_to_grid(y, wymax, (wymin - wymax) / height, height, cell_y, fraction_y);
+
+  //the part of the transposed image that needs to be rendered
+  std::size_t row_first = 0, row_last = width;
+  std::size_t column_first = 0, column_last = height;
+
+  const std::vector<double> key = {
+    static_cast<double>(width), static_cast<double>(height),
+    wxmin, wxmax, wymin, wymax,
+    zmin, zmax, static_cast<double>(nlevels), static_cast<double>(colormap_palette),
+    static_cast<double>(level), static_cast<double>(x.size()), static_cast<double>(y.size())
+  };
+
+  if (!raster_image || key != raster_key) {
+    //the image is stored transposed: each of its rows corresponds to a column of device pixels,
+    //ensuring that the Z-values needed to fill a row are close together in memory
+    raster_image = Cairo::ImageSurface::create(Cairo::FORMAT_ARGB32, height, width);
+    raster_key = key;
+  }
+  else if (raster_dirty[0] < raster_dirty[2] && raster_dirty[1] < raster_dirty[3]) {
+    //only the pixels in cells with a modified corner have to be rendered again. Cells run monotonically along both axes of the image,
+    //so these pixels form a rectangle. Cell i has corners i and i + 1.
+    std::size_t region[4];
+    pyramid_grid_region(raster_dirty, level, region);
+    const long cell_x_first = static_cast<long>(std::max<std::size_t>(region[0], 1)) - 1;
+    const long cell_x_last = region[2];
+    const long cell_y_first = static_cast<long>(std::max<std::size_t>(region[1], 1)) - 1;
+    const long cell_y_last = region[3];
+
+    row_first = width;
+    row_last = 0;
+    for (std::size_t r = 0 ; r < static_cast<std::size_t>(width) ; r++) {
+      if (cell_x[r] >= cell_x_first && cell_x[r] < cell_x_last) {
+        row_first = std::min(row_first, r);
+        row_last = r + 1;
+      }
+    }
+
+    column_first = height;
+    column_last = 0;
+    for (std::size_t c = 0 ; c < static_cast<std::size_t>(height) ; c++) {
+      if (cell_y[c] >= cell_y_first && cell_y[c] < cell_y_last) {
+        column_first = std::min(column_first, c);
+        column_last = c + 1;
+      }
+    }
+  }
+  else {
+    row_first = row_last = 0;
+  }
+  raster_dirty[0] = raster_dirty[2] = 0;
+
+  if (row_first < row_last && column_first < column_last) {
+    //the same colors as the colorbar, which PLplot picks from the palette loaded by change_plstream_colormap()
+    const std::vector<uint32_t> lut = cmap1_lookup_table(colormap_palette, nlevels - 1);
+
+    raster_image->flush();
+    unsigned char *image_data = raster_image->get_data();
+    const int stride = raster_image->get_stride();
+
+    const std::size_t nrows = row_last - row_first;
+    std::size_t nthreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    nthreads = std::min(nthreads, std::max<std::size_t>(nrows / PLOTCONTOURSHADES_RASTER_MIN_ROWS_PER_THREAD, 1));
+
+    std::vector<std::thread> threads;
+    for (std::size_t thread = 1 ; thread < nthreads ; thread++) {
+      threads.emplace_back(rasterize_rows, z, std::cref(cell_x), std::cref(fraction_x), std::cref(cell_y), std::cref(fraction_y),
+                           zmin, zmax, nlevels, std::cref(lut), image_data, stride,
+                           row_first + thread * nrows / nthreads, row_first + (thread + 1) * nrows / nthreads,
+                           column_first, column_last);
+    }
+    rasterize_rows(z, cell_x, fraction_x, cell_y, fraction_y, zmin, zmax, nlevels, lut,
+                   image_data, stride, row_first, row_first + nrows / nthreads, column_first, column_last);
+    for (auto &thread : threads)
+      thread.join();
+
+    raster_image->mark_dirty();
+  }
+
+  //map the transposed image onto the plot window and paint it in one go
+  cr->save();
+  cairo_matrix_t matrix;
+  cairo_matrix_init(&matrix, 0.0, (bottom - top) / height, (right - left) / width, 0.0, left, top);
+  cairo_transform(cr->cobj(), &matrix);
+  auto pattern = Cairo::SurfacePattern::create(raster_image);
+  pattern->set_filter(Cairo::FILTER_NEAREST);
+  cr->set_source(pattern);
+  cr->rectangle(0.0, 0.0, height, width);
+  cr->fill();
+  cr->restore();
+}
+
 void PlotContourShades::draw_colorbar(
 	const Cairo::RefPtr<Cairo::Context> &cr,
 	plstream *pls) {
 
-	change_plstream_colormap(pls, colormap_palette);
-
-	change_plstream_color(pls, axes_color, false, GTKMM_PLPLOT_DEFAULT_COLOR_INDEX);
-
 	pls->psty(area_fill_pattern);
 	//cannot pass the fill_width to the colorbar :-(
 	//pls->width(fill_width);
 
-	int cont_color = GTKMM_PLPLOT_DEFAULT_COLOR_INDEX;
-	double cont_width = 1.0;
-
-	/*if (!showing_edges) {
-		cont_color = 0;
-		cont_width = 0.0;
-	}*/
-
-	// Smaller text
-	pls->schr(0.0, 0.75);
-	// Small ticks on the vertical axis
-	pls->smaj(0.0, 0.5);
-	pls->smin(0.0, 0.5);
-
-#define NUM_AXES 1
-	PLINT n_axis_opts = NUM_AXES;
-	const char *axis_opts[] = {
-		"bcvtm",
-	};
-	PLINT num_values[NUM_AXES];
-	double *values[NUM_AXES];
-	double axis_ticks[NUM_AXES] = {
-		0.0,
-	};
-	PLINT axis_subticks[NUM_AXES] = {
-		0,
-	};
-	num_values[0] = nlevels;
-	values[0] = &clevels[0];
-	double colorbar_width, colorbar_height;
-#define NUM_LABELS 1
-	PLINT n_labels = NUM_LABELS;
-	PLINT label_opts[] = {
-		PL_COLORBAR_LABEL_BOTTOM,
-	};
-	const char *labels[1] = {
-					colorbar_title.c_str(),
-	};
-	pls->colorbar(
-		&colorbar_width,
-		&colorbar_height,
-		PL_COLORBAR_SHADE | PL_COLORBAR_SHADE_LABEL, //options
-		0, //position
-		0.005, //X offset
-		0.0, //Y offset
-		0.0375, //X length
-		0.875, //Y length
-		0, //background color
-		0, //bounding box color
-		1, //bounding box style
-		0.0, //low end color bar cap
-		0.0, //high end color bar cap
-		cont_color, //contour color
-		cont_width, //contour width
-		n_labels, //number of labels
-		label_opts,//label options
-		labels,//label text
-		n_axis_opts,//number of axes
-		axis_opts,//axes options
-		axis_ticks,//major tick mark spacings
-		axis_subticks,//number of subticks
-		num_values,//number of contour levels
-		(const double * const *) values //contour levels
-	);
-
-	// Reset text and tick sizes
-	pls->schr( 0.0, 1.0 );
-	pls->smaj( 0.0, 1.0 );
-	pls->smin( 0.0, 1.0 );
+	draw_plstream_colorbar(pls, colormap_palette, axes_color, clevels, colorbar_title, true, GTKMM_PLPLOT_DEFAULT_COLOR_INDEX, 1.0);
 }
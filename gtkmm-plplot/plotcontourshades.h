@@ -30,6 +30,8 @@ namespace Gtk {
      *  A class for contour plots with shaded regions. Construction requires a
      *  single PlotDataSurface dataset, and no datasets may be added afterwards.
      *  This class offers one property on top of those offered by parent class Plot: whether to draw a colorbar or not.
+     *  For large grids, set_shades_rendering() can be used to replace the polygons that PLplot fills for each level with
+     *  a single image at the resolution of the display, which is much faster to draw and keeps vector output small.
      *  Important is that whenever a property is changed, \c signal_changed() is emitted, which will eventually
      *  be picked up by the \c canvas that will hold the plot.
      *  For more information, the reader is referred to example \ref example8.
@@ -42,10 +44,25 @@ namespace Gtk {
        ColormapPalette colormap_palette; ///< The colormap that will be used to render the contourplot shades.
        AreaFillPattern area_fill_pattern; ///< The pattern that will be used to draw the shaded regions.
        double fill_width; ///< Defines line width used by the fill pattern.
+       ShadesRendering shades_rendering; ///< Determines whether the shaded regions are drawn as polygons or as an image.
+       Cairo::RefPtr<Cairo::ImageSurface> raster_image; ///< the image that was painted most recently by draw_raster()
+       std::vector<double> raster_key; ///< the device size, plot window, levels, palette, pyramid level and grid dimensions \c raster_image was rendered for
+       std::size_t raster_dirty[4]; ///< the rectangle of grid points at full resolution that was modified since \c raster_image was rendered, in the format used by merge_grid_region()
        PlotContourShades() = delete; ///< no default constructor
        PlotContourShades(const PlotContourShades &) = delete; ///< no default copy constructor
        PlotContourShades &operator=(const PlotContourShades &) = delete; ///< no assignment operator
+
+       /** Paint the shaded regions as a single image
+        *
+        * Every device pixel of the plot window is mapped to the shade of the level its bilinearly interpolated Z-value falls into.
+        * The image is cached: if only a part of the data was modified since it was rendered, only the pixels that depend on the modified grid points are updated.
+        * \param cr the cairo context to draw to.
+        */
+       void draw_raster(const Cairo::RefPtr<Cairo::Context> &cr);
      protected:
+      virtual void plot_data_region_modified(std::size_t ix0, std::size_t iy0, std::size_t nx, std::size_t ny) override; ///< marks the part of the cached image that depends on the modified grid points as outdated
+      virtual void plot_levels_modified() override; ///< discards the cached image, as all of its pixels may have to change shade
+
       /** Constructor
        *
        * This protected constructor is meant to be used in derived classes only to circumvent the problem of calling add_data() in a constructor which calls PlotContourShades's public constructor.
@@ -174,6 +191,20 @@ namespace Gtk {
        */
       double get_area_lines_width();
 
+      /** Changes how the shaded regions are rendered
+       *
+       * With SHADES_RASTER, the Z-values are mapped onto the colormap palette in parallel, and the result is painted with a single image draw.
+       * The area fill pattern is ignored in this mode, while the contour edges and the colorbar are drawn on top of the image, if requested.
+       * \param shades_rendering the new rendering mode
+       */
+      void set_shades_rendering(ShadesRendering shades_rendering);
+
+      /** Get how the shaded regions are currently rendered
+       *
+       * \returns the current rendering mode
+       */
+      ShadesRendering get_shades_rendering();
+
       /** Marks the contour edges for showing
        *
        */
@@ -16,13 +16,17 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <gtkmm-plplot/plotdata.h>
+#include <gtkmm-plplot/exception.h>
 
 using namespace Gtk::PLplot;
 
 PlotData::PlotData() :
   Glib::ObjectBase("GtkmmPLplotPlotData"),
   name(""),
-  shown(true) {
+  shown(true),
+  updates_frozen(0),
+  changed_pending(false),
+  data_modified_pending(false) {
 
   this->signal_changed().connect(sigc::mem_fun(*this,
                &PlotData::on_changed));
@@ -41,9 +45,54 @@ void PlotData::on_data_modified() {
   //do nothing
 }
 
+void PlotData::notify_changed() {
+  if (updates_frozen > 0) {
+    changed_pending = true;
+    return;
+  }
+  _signal_changed.emit();
+}
+
+void PlotData::notify_data_modified() {
+  if (updates_frozen > 0) {
+    data_modified_pending = true;
+    return;
+  }
+  _signal_data_modified.emit();
+}
+
+bool PlotData::get_data_modified_pending() const {
+  return data_modified_pending;
+}
+
+void PlotData::freeze_updates() {
+  updates_frozen++;
+}
+
+void PlotData::thaw_updates() {
+  if (updates_frozen == 0)
+    throw Exception("Gtk::PLplot::PlotData::thaw_updates -> updates are not frozen");
+
+  if (--updates_frozen > 0)
+    return;
+
+  if (data_modified_pending) {
+    data_modified_pending = false;
+    _signal_data_modified.emit();
+  }
+  if (changed_pending) {
+    changed_pending = false;
+    _signal_changed.emit();
+  }
+}
+
+bool PlotData::get_updates_frozen() const {
+  return updates_frozen > 0;
+}
+
 void PlotData::set_name(Glib::ustring _name) {
   name = _name;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 Glib::ustring PlotData::get_name() {
@@ -52,12 +101,12 @@ Glib::ustring PlotData::get_name() {
 
 void PlotData::show() {
   shown = true;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 void PlotData::hide() {
   shown = false;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 bool PlotData::is_showing() const {
@@ -38,6 +38,9 @@ namespace Gtk {
     private:
       Glib::ustring name; ///< the name that will be assigned to the dataset. Will be used to generate legends if supported by the Plot type
       bool shown; ///< \c true means the plot is currently visible, \c false means it is not plotted
+      unsigned int updates_frozen; ///< the number of freeze_updates() calls that have not been matched by thaw_updates() yet
+      bool changed_pending; ///< \c true when signal_changed was postponed because updates were frozen
+      bool data_modified_pending; ///< \c true when signal_data_modified was postponed because updates were frozen
       PlotData &operator=(const PlotData &) = delete; ///< no move assignment operator
       PlotData(const PlotData &source) = delete; ///< no default copy constructor;
     protected:
@@ -58,6 +61,28 @@ namespace Gtk {
        */
       virtual void on_data_modified();
 
+      /** Emit signal_changed
+       *
+       * Derived classes should call this method instead of emitting \c _signal_changed directly.
+       * While updates are frozen, the emission is postponed until thaw_updates() is called.
+       */
+      void notify_changed();
+
+      /** Emit signal_data_modified
+       *
+       * Derived classes should call this method instead of emitting \c _signal_data_modified directly.
+       * While updates are frozen, the emission is postponed until thaw_updates() is called.
+       */
+      void notify_data_modified();
+
+      /** Returns whether the emission of signal_data_modified is currently being postponed
+       *
+       * Datasets that keep track of which part of their data was modified can use this to decide whether a modification should be merged
+       * with the previous ones, which have not been reported yet.
+       * \return \c true if notify_data_modified() was called while updates were frozen, and thaw_updates() has not emitted the signal yet
+       */
+      bool get_data_modified_pending() const;
+
       /** Constructor
        *
        */
@@ -96,6 +121,27 @@ namespace Gtk {
        */
       bool is_showing() const;
 
+      /** Postpone the emission of signal_changed and signal_data_modified
+       *
+       * Use this method before making several changes to the dataset, such as adding many datapoints or changing several of its properties.
+       * Each signal will be emitted at most once when the matching thaw_updates() is called, resulting in a single update of the plot ranges and a single redraw.
+       * Calls may be nested. Consider using UpdateGuard to ensure that every freeze is matched by a thaw.
+       */
+      void freeze_updates();
+
+      /** Emit the signals that were postponed since freeze_updates() was called
+       *
+       * Signals are only emitted when this call matches the outermost freeze_updates() call.
+       * \exception Gtk::PLplot::Exception
+       */
+      void thaw_updates();
+
+      /** Returns whether updates are currently frozen
+       *
+       * \return \c true if freeze_updates() was called more often than thaw_updates(), \c false if not
+       */
+      bool get_updates_frozen() const;
+
       /** signal_changed is emitted whenever any of the dataset properties has changed.
        *
        * See default handler on_changed()
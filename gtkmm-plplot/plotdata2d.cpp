@@ -19,20 +19,33 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <gtkmm-plplot/exception.h>
 #include <gtkmm-plplot/utils.h>
 #include <plstream.h>
+#include <cmath>
+#include <algorithm>
+
+#define PLOTDATA2D_DECIMATION_INDEX_BLOCK_SIZE 64
+#define PLOTDATA2D_CULLING_CHUNK_SIZE 256
 
 using namespace Gtk::PLplot;
 
 PlotData2D::PlotData2D(
-  const std::vector<double> &_x,
-  const std::vector<double> &_y,
+  PlotDataBuffer _x,
+  PlotDataBuffer _y,
   Gdk::RGBA _color,
   LineStyle _line_style,
   double _line_width) :
   Glib::ObjectBase("GtkmmPLplotPlotData2D"),
   PlotDataLine(_color, _line_style, _line_width),
-  x(_x), y(_y),
+  x(std::move(_x)), y(std::move(_y)),
   symbol(""), symbol_color(Gdk::RGBA("Red")),
-  symbol_scale_factor(1.0) {
+  symbol_scale_factor(1.0),
+  decimation(true),
+  view_columns(0),
+  view_log10_x(false),
+  view_log10_y(false),
+  append_only(true),
+  sorted_x(true),
+  sorted_x_checked(0),
+  decimation_index(false) {
 
    //ensure both arrays have the same size
   if (x.size() != y.size()) {
@@ -42,38 +55,116 @@ PlotData2D::PlotData2D(
   if (x.size() < 2) {
     throw Exception("Gtk::PLplot::PlotData2D::PlotData2D -> data arrays x and y must have at least two elements");
   }
+
+  update_extremes(0);
 }
 
+PlotData2D::PlotData2D(
+  const std::vector<double> &_x,
+  const std::vector<double> &_y,
+  Gdk::RGBA _color,
+  LineStyle _line_style,
+  double _line_width) :
+  PlotData2D(PlotDataBuffer(_x), PlotDataBuffer(_y),
+  _color, _line_style, _line_width) {}
+
+PlotData2D::PlotData2D(
+  std::vector<double> &&_x,
+  std::vector<double> &&_y,
+  Gdk::RGBA _color,
+  LineStyle _line_style,
+  double _line_width) :
+  PlotData2D(PlotDataBuffer(std::move(_x)), PlotDataBuffer(std::move(_y)),
+  _color, _line_style, _line_width) {}
+
 PlotData2D::PlotData2D(
   const std::valarray<double> &_x,
   const std::valarray<double> &_y,
   Gdk::RGBA _color,
   LineStyle _line_style,
   double _line_width) :
-  PlotData2D(std::vector<double>(std::begin(_x), std::end(_x)),
-  std::vector<double>(std::begin(_y), std::end(_y)),
+  PlotData2D(PlotDataBuffer(_x), PlotDataBuffer(_y),
+  _color, _line_style, _line_width) {}
+
+// build the X-values of a uniformly sampled signal, before moving the Y-values
+static std::pair<PlotDataBuffer, PlotDataBuffer> uniform_xy(double x0, double dx, PlotDataBuffer &&y) {
+  PlotDataBuffer x = PlotDataBuffer::uniform(x0, dx, y.size());
+  return std::make_pair(std::move(x), std::move(y));
+}
+
+PlotData2D::PlotData2D(
+  std::pair<PlotDataBuffer, PlotDataBuffer> _xy,
+  Gdk::RGBA _color,
+  LineStyle _line_style,
+  double _line_width) :
+  PlotData2D(std::move(_xy.first), std::move(_xy.second),
+  _color, _line_style, _line_width) {}
+
+PlotData2D::PlotData2D(
+  double _x0,
+  double _dx,
+  PlotDataBuffer _y,
+  Gdk::RGBA _color,
+  LineStyle _line_style,
+  double _line_width) :
+  PlotData2D(uniform_xy(_x0, _dx, std::move(_y)),
   _color, _line_style, _line_width) {}
 
 PlotData2D::PlotData2D(
+  double _x0,
+  double _dx,
   const std::vector<double> &_y,
   Gdk::RGBA _color,
   LineStyle _line_style,
   double _line_width) :
-  PlotData2D(indgen(_y.size()), _y, _color, _line_style, _line_width) {}
+  PlotData2D(_x0, _dx, PlotDataBuffer(_y),
+  _color, _line_style, _line_width) {}
 
 PlotData2D::PlotData2D(
+  double _x0,
+  double _dx,
+  std::vector<double> &&_y,
+  Gdk::RGBA _color,
+  LineStyle _line_style,
+  double _line_width) :
+  PlotData2D(_x0, _dx, PlotDataBuffer(std::move(_y)),
+  _color, _line_style, _line_width) {}
+
+PlotData2D::PlotData2D(
+  double _x0,
+  double _dx,
   const std::valarray<double> &_y,
-  Gdk::RGBA _color, LineStyle _line_style,
+  Gdk::RGBA _color,
+  LineStyle _line_style,
   double _line_width) :
-  PlotData2D(std::vector<double>(indgen(_y.size())),
-  std::vector<double>(std::begin(_y), std::end(_y)),
+  PlotData2D(_x0, _dx, PlotDataBuffer(_y),
   _color, _line_style, _line_width) {}
 
+PlotData2D::PlotData2D(
+  const std::vector<double> &_y,
+  Gdk::RGBA _color,
+  LineStyle _line_style,
+  double _line_width) :
+  PlotData2D(0.0, 1.0, _y, _color, _line_style, _line_width) {}
+
+PlotData2D::PlotData2D(
+  std::vector<double> &&_y,
+  Gdk::RGBA _color,
+  LineStyle _line_style,
+  double _line_width) :
+  PlotData2D(0.0, 1.0, std::move(_y), _color, _line_style, _line_width) {}
+
+PlotData2D::PlotData2D(
+  const std::valarray<double> &_y,
+  Gdk::RGBA _color, LineStyle _line_style,
+  double _line_width) :
+  PlotData2D(0.0, 1.0, _y, _color, _line_style, _line_width) {}
+
 PlotData2D::~PlotData2D() {}
 
 void PlotData2D::set_symbol(Glib::ustring _symbol) {
   symbol = _symbol;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 Glib::ustring PlotData2D::get_symbol() {
@@ -82,7 +173,7 @@ Glib::ustring PlotData2D::get_symbol() {
 
 void PlotData2D::set_symbol_color(Gdk::RGBA _color) {
   symbol_color = _color;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 Gdk::RGBA PlotData2D::get_symbol_color() {
@@ -94,17 +185,395 @@ void PlotData2D::set_symbol_height_scale_factor(double _scale_factor) {
     throw Exception("Gtk::PLplot::PlotData2D::set_symbol_height_scale_factor -> scale factor must be strictly positive");
   }
   symbol_scale_factor = _scale_factor;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 double PlotData2D::get_symbol_height_scale_factor() {
   return symbol_scale_factor;
 }
 
+void PlotData2D::set_decimation(bool _decimation) {
+  decimation = _decimation;
+  notify_changed();
+}
+
+bool PlotData2D::get_decimation() {
+  return decimation;
+}
+
+bool PlotData2D::is_sorted_x() {
+  if (x.is_uniform())
+    return x.get_uniform_step() >= 0.0;
+
+  if (sorted_x_checked == 0)
+    sorted_x_checked = 1;
+
+  // only the datapoints that were added since the last call need to be checked
+  if (sorted_x && sorted_x_checked < x.size()) {
+    sorted_x = x.find_descending(sorted_x_checked - 1, x.size()) == x.size();
+    sorted_x_checked = x.size();
+  }
+
+  return sorted_x;
+}
+
+std::size_t PlotData2D::find_x(std::size_t first, std::size_t last, double value, bool upper) {
+  if (x.is_uniform() && x.get_uniform_step() > 0.0) {
+    auto before = [&](std::size_t i) {
+      return upper ? x[i] <= value : x[i] < value;
+    };
+
+    // start from the calculated index, and correct it for rounding errors
+    const double guess = std::ceil((value - x.get_uniform_start()) / x.get_uniform_step());
+    std::size_t i = first;
+    if (guess >= last)
+      i = last;
+    else if (guess > first)
+      i = static_cast<std::size_t>(guess);
+
+    while (i > first && !before(i - 1))
+      i--;
+    while (i < last && before(i))
+      i++;
+    return i;
+  }
+
+  return x.search_sorted(first, last, value, upper);
+}
+
+void PlotData2D::set_decimation_index(bool _decimation_index) {
+  decimation_index = _decimation_index;
+
+  if (!decimation_index) {
+    std::vector<std::vector<std::size_t>>().swap(decimation_index_min);
+    std::vector<std::vector<std::size_t>>().swap(decimation_index_max);
+  }
+  notify_changed();
+}
+
+bool PlotData2D::get_decimation_index() {
+  return decimation_index;
+}
+
+void PlotData2D::update_decimation_index() {
+  // level 0 summarizes the complete blocks of PLOTDATA2D_DECIMATION_INDEX_BLOCK_SIZE datapoints,
+  // while each element of the next levels summarizes a pair of elements of the level below
+  if (decimation_index_min.empty()) {
+    decimation_index_min.resize(1);
+    decimation_index_max.resize(1);
+  }
+
+  const std::size_t nblocks = y.size() / PLOTDATA2D_DECIMATION_INDEX_BLOCK_SIZE;
+
+  for (std::size_t block = decimation_index_min[0].size() ; block < nblocks ; block++) {
+    const std::size_t offset = block * PLOTDATA2D_DECIMATION_INDEX_BLOCK_SIZE;
+    std::size_t imin, imax;
+    y.find_extremes(offset, offset + PLOTDATA2D_DECIMATION_INDEX_BLOCK_SIZE, imin, imax);
+    decimation_index_min[0].push_back(imin);
+    decimation_index_max[0].push_back(imax);
+  }
+
+  for (std::size_t level = 1 ; decimation_index_min[level - 1].size() >= 2 ; level++) {
+    if (level == decimation_index_min.size()) {
+      decimation_index_min.resize(level + 1);
+      decimation_index_max.resize(level + 1);
+    }
+    const std::vector<std::size_t> &below_min = decimation_index_min[level - 1];
+    const std::vector<std::size_t> &below_max = decimation_index_max[level - 1];
+    std::vector<std::size_t> &current_min = decimation_index_min[level];
+    std::vector<std::size_t> &current_max = decimation_index_max[level];
+
+    for (std::size_t i = current_min.size() ; i < below_min.size() / 2 ; i++) {
+      const std::size_t min1 = below_min[2 * i], min2 = below_min[2 * i + 1];
+      const std::size_t max1 = below_max[2 * i], max2 = below_max[2 * i + 1];
+      current_min.push_back(y[min2] < y[min1] ? min2 : min1);
+      current_max.push_back(y[max2] > y[max1] ? max2 : max1);
+    }
+  }
+}
+
+void PlotData2D::get_decimation_index_extremes(std::size_t first, std::size_t last, std::size_t &imin, std::size_t &imax) {
+  imin = imax = first;
+
+  auto consider = [&](std::size_t candidate_min, std::size_t candidate_max) {
+    if (y[candidate_min] < y[imin])
+      imin = candidate_min;
+    if (y[candidate_max] > y[imax])
+      imax = candidate_max;
+  };
+
+  auto consider_range = [&](std::size_t range_first, std::size_t range_last) {
+    if (range_first >= range_last)
+      return;
+    std::size_t range_min, range_max;
+    y.find_extremes(range_first, range_last, range_min, range_max);
+    consider(range_min, range_max);
+  };
+
+  // the datapoints before the first and after the last complete block are examined directly
+  std::size_t block_first = (first + PLOTDATA2D_DECIMATION_INDEX_BLOCK_SIZE - 1) / PLOTDATA2D_DECIMATION_INDEX_BLOCK_SIZE;
+  std::size_t block_last = last / PLOTDATA2D_DECIMATION_INDEX_BLOCK_SIZE;
+
+  if (block_first >= block_last) {
+    consider_range(first, last);
+    return;
+  }
+
+  consider_range(first, block_first * PLOTDATA2D_DECIMATION_INDEX_BLOCK_SIZE);
+  consider_range(block_last * PLOTDATA2D_DECIMATION_INDEX_BLOCK_SIZE, last);
+
+  // the complete blocks are covered by walking up the pyramid
+  for (std::size_t level = 0 ; block_first < block_last ; level++) {
+    if (block_first & 1) {
+      consider(decimation_index_min[level][block_first], decimation_index_max[level][block_first]);
+      block_first++;
+    }
+    if (block_last & 1) {
+      block_last--;
+      consider(decimation_index_min[level][block_last], decimation_index_max[level][block_last]);
+    }
+    block_first /= 2;
+    block_last /= 2;
+  }
+}
+
+void PlotData2D::update_culling_boxes() {
+  // a chunk is only added once the first datapoint of the next chunk is available
+  const std::size_t nchunks = (x.size() - 1) / PLOTDATA2D_CULLING_CHUNK_SIZE;
+
+  for (std::size_t chunk = culling_boxes.size() / 4 ; chunk < nchunks ; chunk++) {
+    const std::size_t offset = chunk * PLOTDATA2D_CULLING_CHUNK_SIZE;
+    const std::size_t end = offset + PLOTDATA2D_CULLING_CHUNK_SIZE + 1;
+    std::size_t imin_x, imax_x, imin_y, imax_y;
+    x.find_extremes(offset, end, imin_x, imax_x);
+    y.find_extremes(offset, end, imin_y, imax_y);
+    culling_boxes.push_back(x[imin_x]);
+    culling_boxes.push_back(x[imax_x]);
+    culling_boxes.push_back(y[imin_y]);
+    culling_boxes.push_back(y[imax_y]);
+  }
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> PlotData2D::get_visible_ranges(std::size_t first, std::size_t last, double margin_x, double margin_y, bool line) {
+  std::vector<std::pair<std::size_t, std::size_t>> ranges;
+
+  // without information about the plot window, everything needs to be drawn
+  if (view_columns <= 0 || first >= last) {
+    if (first < last)
+      ranges.emplace_back(first, last);
+    return ranges;
+  }
+
+  // the plot window in world coordinates
+  double window_x[2] = {view_range_x[0] - margin_x, view_range_x[1] + margin_x};
+  double window_y[2] = {view_range_y[0] - margin_y, view_range_y[1] + margin_y};
+
+  for (int i = 0 ; i < 2 ; i++) {
+    if (view_log10_x)
+      window_x[i] = pow(10.0, window_x[i]);
+    if (view_log10_y)
+      window_y[i] = pow(10.0, window_y[i]);
+  }
+
+  if (is_sorted_x()) {
+    std::size_t visible_first = find_x(first, last, window_x[0], false);
+    std::size_t visible_last = find_x(visible_first, last, window_x[1], true);
+
+    // keep the line segments that enter and leave the plot window
+    if (line) {
+      if (visible_first > first)
+        visible_first--;
+      if (visible_last < last)
+        visible_last++;
+    }
+
+    if (visible_last > visible_first)
+      ranges.emplace_back(visible_first, visible_last);
+  }
+  else if (append_only) {
+    update_culling_boxes();
+
+    // merge consecutive visible chunks into ranges. Chunks without bounding box have not been completed yet and are always visible.
+    const std::size_t nboxes = culling_boxes.size() / 4;
+    bool in_range = false;
+    std::size_t range_first = first;
+
+    for (std::size_t chunk = first / PLOTDATA2D_CULLING_CHUNK_SIZE ; chunk * PLOTDATA2D_CULLING_CHUNK_SIZE < last ; chunk++) {
+      const bool visible = chunk >= nboxes ||
+                           (culling_boxes[4 * chunk] <= window_x[1] && culling_boxes[4 * chunk + 1] >= window_x[0] &&
+                            culling_boxes[4 * chunk + 2] <= window_y[1] && culling_boxes[4 * chunk + 3] >= window_y[0]);
+
+      if (visible && !in_range) {
+        range_first = std::max(first, chunk * PLOTDATA2D_CULLING_CHUNK_SIZE);
+        in_range = true;
+      }
+      else if (!visible && in_range) {
+        // the bounding box of the previous chunk includes the first datapoint of this one
+        ranges.emplace_back(range_first, std::min(last, chunk * PLOTDATA2D_CULLING_CHUNK_SIZE + 1));
+        in_range = false;
+      }
+    }
+
+    if (in_range)
+      ranges.emplace_back(range_first, last);
+  }
+  else {
+    ranges.emplace_back(first, last);
+  }
+
+  return ranges;
+}
+
+void PlotData2D::draw_line(plstream *pls, std::size_t first, std::size_t n) {
+  for (auto &range : get_visible_ranges(first, first + n, 0.0, 0.0, true))
+    draw_line_decimated(pls, range.first, range.second);
+}
+
+void PlotData2D::draw_symbols(plstream *pls, std::size_t first, std::size_t n) {
+  // symbols centered just outside of the plot window may still be partially visible,
+  // so the plot window is extended with the symbol height
+  double margin_x = 0.0, margin_y = 0.0;
+
+  if (view_columns > 0) {
+    double char_default, char_height;
+    pls->gchr(char_default, char_height);
+    double page_xmin, page_xmax, page_ymin, page_ymax;
+    pls->gspa(page_xmin, page_xmax, page_ymin, page_ymax);
+    double viewport_xmin, viewport_xmax, viewport_ymin, viewport_ymax;
+    pls->gvpd(viewport_xmin, viewport_xmax, viewport_ymin, viewport_ymax);
+
+    const double viewport_width = (viewport_xmax - viewport_xmin) * (page_xmax - page_xmin);
+    const double viewport_height = (viewport_ymax - viewport_ymin) * (page_ymax - page_ymin);
+
+    if (viewport_width > 0.0 && viewport_height > 0.0) {
+      margin_x = char_height / viewport_width * (view_range_x[1] - view_range_x[0]);
+      margin_y = char_height / viewport_height * (view_range_y[1] - view_range_y[0]);
+    }
+  }
+
+  for (auto &range : get_visible_ranges(first, first + n, margin_x, margin_y, false)) {
+    PlotDataBuffer::for_each_chunk({&x, &y}, range.first, range.second, false, [pls, this](std::size_t chunk_n, const double * const *values){
+      pls->string(chunk_n, values[0], values[1], symbol.c_str());
+    });
+  }
+}
+
+void PlotData2D::draw_line_decimated(plstream *pls, std::size_t first, std::size_t last) {
+  const std::size_t n = last - first;
+
+  if (!decimation ||
+      view_columns <= 0 ||
+      n <= 4 * static_cast<std::size_t>(view_columns) ||
+      view_range_x[1] <= view_range_x[0] ||
+      !is_sorted_x()) {
+    PlotDataBuffer::for_each_chunk({&x, &y}, first, last, true, [pls](std::size_t chunk_n, const double * const *values){
+      pls->line(chunk_n, values[0], values[1]);
+    });
+    return;
+  }
+
+  decimated_x.clear();
+  decimated_y.clear();
+
+  // keep the selected datapoints in their original order, without duplicates
+  auto select = [&](std::size_t column_first, std::size_t imin, std::size_t imax, std::size_t column_last) {
+    const std::size_t selection[4] = {column_first, std::min(imin, imax), std::max(imin, imax), column_last};
+    for (int j = 0 ; j < 4 ; j++) {
+      if (j > 0 && selection[j] == selection[j - 1])
+        continue;
+      decimated_x.push_back(x[selection[j]]);
+      decimated_y.push_back(y[selection[j]]);
+    }
+  };
+
+  const double scale = view_columns / (view_range_x[1] - view_range_x[0]);
+
+  // datapoints outside of the plot window end up in the columns -1 and view_columns,
+  // which preserves the line segments that enter and leave the window.
+  // the column boundaries are looked up with find_x(), and the extremes within each column in the pyramid if available
+  if (decimation_index)
+    update_decimation_index();
+
+  std::size_t column_first = first;
+  for (int column = 0 ; column <= view_columns + 1 && column_first < last ; column++) {
+    std::size_t column_last = last;
+    if (column <= view_columns) {
+      double boundary = view_range_x[0] + column / scale;
+      if (view_log10_x)
+        boundary = pow(10.0, boundary);
+      column_last = find_x(column_first, last, boundary, false);
+    }
+    if (column_last == column_first)
+      continue;
+    std::size_t imin, imax;
+    if (decimation_index)
+      get_decimation_index_extremes(column_first, column_last, imin, imax);
+    else
+      y.find_extremes(column_first, column_last, imin, imax);
+    select(column_first, imin, imax, column_last - 1);
+    column_first = column_last;
+  }
+
+  pls->line(decimated_x.size(), &decimated_x[0], &decimated_y[0]);
+}
+
 void PlotData2D::add_datapoint(double _x, double _y) {
   x.push_back(_x);
   y.push_back(_y);
-  _signal_data_modified.emit();
+  update_extremes(x.size() - 1);
+  notify_data_modified();
+}
+
+void PlotData2D::add_datapoints(const double *_x, const double *_y, std::size_t n) {
+  if (n == 0)
+    return;
+
+  const std::size_t first = x.size();
+  x.append(_x, n);
+  y.append(_y, n);
+  update_extremes(first);
+  notify_data_modified();
+}
+
+void PlotData2D::add_datapoint(double _y) {
+  if (!x.is_uniform())
+    throw Exception("Gtk::PLplot::PlotData2D::add_datapoint -> the X-values of this dataset are not uniformly spaced");
+
+  y.push_back(_y);
+  x.extend(1);
+  update_extremes(x.size() - 1);
+  notify_data_modified();
+}
+
+void PlotData2D::add_datapoints(const double *_y, std::size_t n) {
+  if (!x.is_uniform())
+    throw Exception("Gtk::PLplot::PlotData2D::add_datapoints -> the X-values of this dataset are not uniformly spaced");
+
+  if (n == 0)
+    return;
+
+  const std::size_t first = x.size();
+  y.append(_y, n);
+  x.extend(n);
+  update_extremes(first);
+  notify_data_modified();
+}
+
+void PlotData2D::add_datapoints(const std::vector<double> &_x, const std::vector<double> &_y) {
+  if (_x.size() != _y.size())
+    throw Exception("Gtk::PLplot::PlotData2D::add_datapoints -> data arrays x and y must have the same size!");
+
+  add_datapoints(_x.data(), _y.data(), _x.size());
+}
+
+void PlotData2D::add_datapoints(const std::valarray<double> &_x, const std::valarray<double> &_y) {
+  if (_x.size() != _y.size())
+    throw Exception("Gtk::PLplot::PlotData2D::add_datapoints -> data arrays x and y must have the same size!");
+
+  if (_x.size() == 0)
+    return;
+
+  add_datapoints(&_x[0], &_y[0], _x.size());
 }
 
 void PlotData2D::add_datapoint(std::pair<double, double> _xy_pair) {
@@ -115,35 +584,79 @@ void PlotData2D::draw_plot_data(const Cairo::RefPtr<Cairo::Context> &cr, plstrea
   if (!is_showing())
     return;
 
-  double *x_pl = &x[0], *y_pl = &y[0];
-
   // plot the line if requested
   if (line_style != LineStyle::NONE) {
     change_plstream_color(pls, color);
     pls->lsty(line_style);
     pls->width(line_width);
-    pls->line(x.size(), x_pl, y_pl);
+    draw_line(pls, 0, x.size());
   }
 
   // plot the symbols if requested
   if (!symbol.empty()) {
     change_plstream_color(pls, symbol_color);
     pls->schr(0, symbol_scale_factor);
-    pls->string(x.size(), x_pl, y_pl, symbol.c_str());
+    draw_symbols(pls, 0, x.size());
   }
 }
 
+void PlotData2D::external_data_modified() {
+  // everything that was derived from the data needs to be recalculated
+  sorted_x = true;
+  sorted_x_checked = 0;
+  decimation_index_min.clear();
+  decimation_index_max.clear();
+  culling_boxes.clear();
+  update_extremes(0);
+  notify_data_modified();
+}
+
 std::vector<double> PlotData2D::get_vector_x() {
-  return x;
+  return std::vector<double>(x.begin(), x.end());
 }
 
 std::vector<double> PlotData2D::get_vector_y() {
+  return std::vector<double>(y.begin(), y.end());
+}
+
+const PlotDataBuffer &PlotData2D::get_data_x() const {
+  return x;
+}
+
+const PlotDataBuffer &PlotData2D::get_data_y() const {
   return y;
 }
 
+void PlotData2D::update_extremes(std::size_t first) {
+  if (first == 0) {
+    extremes_x[0] = extremes_x[1] = x[0];
+    extremes_y[0] = extremes_y[1] = y[0];
+  }
+
+  if (first >= x.size())
+    return;
+
+  std::size_t imin, imax;
+
+  // uniformly spaced X-values are monotonic, so their extremes are found at both ends
+  if (x.is_uniform()) {
+    extremes_x[0] = std::min(x[0], x.back());
+    extremes_x[1] = std::max(x[0], x.back());
+  }
+  else {
+    x.find_extremes(first, x.size(), imin, imax);
+    extremes_x[0] = std::min(extremes_x[0], x[imin]);
+    extremes_x[1] = std::max(extremes_x[1], x[imax]);
+  }
+
+  y.find_extremes(first, y.size(), imin, imax);
+  extremes_y[0] = std::min(extremes_y[0], y[imin]);
+  extremes_y[1] = std::max(extremes_y[1], y[imax]);
+}
+
 void PlotData2D::get_extremes(double &xmin, double &xmax, double &ymin, double &ymax) {
-  xmin = *std::min_element(x.begin(), x.end());
-  xmax = *std::max_element(x.begin(), x.end());
-  ymin = *std::min_element(y.begin(), y.end());
-  ymax = *std::max_element(y.begin(), y.end());
+  xmin = extremes_x[0];
+  xmax = extremes_x[1];
+  ymin = extremes_y[0];
+  ymax = extremes_y[1];
 }
@@ -20,8 +20,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <vector>
 #include <valarray>
+#include <utility>
 #include <glibmm/ustring.h>
 #include <gtkmm-plplot/plotdataline.h>
+#include <gtkmm-plplot/plotdatabuffer.h>
 #include <gdkmm/rgba.h>
 
 
@@ -35,6 +37,8 @@ namespace Gtk {
      *  the appearance of the plot. Data may be represented as a line, symbols or both.
      *  The constructors of this class allow to use either std::vector or std::valarray as sources of data,
      *  for added flexibility. Internally they are stored only as std::vector though.
+     *  For uniformly sampled signals, the X-values do not need to be stored at all: datasets created using only Y-values,
+     *  or using a start value and a step for the X-axis, calculate them when needed, and can be extended with Y-values only.
      *  Important is that whenever a property is changed, \c signal_changed() is emitted, which will eventually
      *  be picked up by the \c canvas that will hold the plot.
      *  Several of the methods that are offered by this class are demonstrated in \ref example5
@@ -44,12 +48,134 @@ namespace Gtk {
       PlotData2D() = delete; ///< no default constructor
       PlotData2D &operator=(const PlotData2D &) = delete; ///< no assignment operator
       PlotData2D(const PlotData2D &source) = delete; ///< no default copy constructor;
+      friend class Plot2D;
+
+      /** Constructor used by the constructors for uniformly sampled signals
+       *
+       * Taking both buffers as a single argument ensures that the size of the Y-values is known before they are moved.
+       * \param xy the X- and Y-values
+       * \param color the line color
+       * \param line_style the line style
+       * \param line_width the line width
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotData2D(std::pair<PlotDataBuffer, PlotDataBuffer> xy,
+                 Gdk::RGBA color,
+                 LineStyle line_style,
+                 double line_width);
     protected:
-      std::vector<double> x; ///< The X-values of the dataset
-      std::vector<double> y; ///< The Y-values of the dataset
+      PlotDataBuffer x; ///< The X-values of the dataset
+      PlotDataBuffer y; ///< The Y-values of the dataset
       Glib::ustring symbol; ///< If not an empty string, the symbol will be plotted at each of the data points from \c x and \c y.
       Gdk::RGBA symbol_color; ///< The color the symbol will be plotted in
       double symbol_scale_factor; ///< Scale factor that will determine the size of the symbols. Default is 1.
+      double extremes_x[2]; ///< the minimum and maximum of the dataset along the X-axis, as returned by get_extremes()
+      double extremes_y[2]; ///< the minimum and maximum of the dataset along the Y-axis, as returned by get_extremes()
+
+      /** Update \c extremes_x and \c extremes_y to take into account the datapoints starting at index \c first
+       *
+       * Called whenever datapoints are appended, which allows the extremes to be maintained without rescanning the complete dataset.
+       * Derived classes whose extremes are not determined by \c x and \c y alone, such as those with errorbars, should override this method.
+       * \param first index of the first datapoint that has not been taken into account yet. Pass 0 to recalculate the extremes from scratch.
+       */
+      virtual void update_extremes(std::size_t first);
+
+      bool decimation; ///< \c true if the line may be decimated before it is drawn. See set_decimation().
+      int view_columns; ///< the number of device pixel columns spanned by the plot window during the current draw, or 0 if unknown. Set by Plot2D.
+      double view_range_x[2]; ///< the X-range (in PLplot coordinates) spanned by the plot window during the current draw. Set by Plot2D.
+      double view_range_y[2]; ///< the Y-range (in PLplot coordinates) spanned by the plot window during the current draw. Set by Plot2D.
+      bool view_log10_x; ///< \c true if the X-axis is logarithmic during the current draw. Set by Plot2D.
+      bool view_log10_y; ///< \c true if the Y-axis is logarithmic during the current draw. Set by Plot2D.
+      bool append_only; ///< \c true if datapoints are only ever appended to \c x and \c y, which allows information about them to be cached incrementally
+      std::vector<double> decimated_x; ///< scratch buffer holding the X-values of the decimated line, kept around to avoid reallocating it on every draw
+      std::vector<double> decimated_y; ///< scratch buffer holding the Y-values of the decimated line, kept around to avoid reallocating it on every draw
+      bool sorted_x; ///< \c true if the X-values up to \c sorted_x_checked are in ascending order
+      std::size_t sorted_x_checked; ///< the number of X-values that were checked by is_sorted_x()
+      bool decimation_index; ///< \c true if a min/max pyramid is maintained to speed up decimation. See set_decimation_index().
+      std::vector<std::vector<std::size_t>> decimation_index_min; ///< the levels of the min/max pyramid: each element holds the index of the minimum Y-value in a block of datapoints, whose size doubles with each level
+      std::vector<std::vector<std::size_t>> decimation_index_max; ///< the levels of the min/max pyramid: each element holds the index of the maximum Y-value in a block of datapoints, whose size doubles with each level
+      std::vector<double> culling_boxes; ///< the bounding boxes (xmin, xmax, ymin, ymax) of consecutive chunks of datapoints, used to skip invisible parts of unsorted datasets
+
+      /** Extend the min/max pyramid to cover the datapoints that were appended since the previous call
+       *
+       */
+      void update_decimation_index();
+
+      /** Find the datapoints with the minimum and maximum Y-values in the range [\c first, \c last)
+       *
+       * Uses the min/max pyramid, which must be up to date, to do so in logarithmic time.
+       * \param first the index of the first datapoint in the range
+       * \param last the index one past the last datapoint in the range. Must be greater than \c first.
+       * \param imin the index of the minimum Y-value
+       * \param imax the index of the maximum Y-value
+       */
+      void get_decimation_index_extremes(std::size_t first, std::size_t last, std::size_t &imin, std::size_t &imax);
+
+      /** Extend \c culling_boxes to cover the datapoints that were appended since the previous call
+       *
+       * The bounding box of each chunk also includes the first datapoint of the next chunk,
+       * ensuring that every line segment is covered by at least one of the boxes.
+       */
+      void update_culling_boxes();
+
+      /** Find the parts of the range [\c first, \c last) that may be visible in the plot window
+       *
+       * For sorted datasets, this is found with a binary search. Otherwise \c culling_boxes is used, provided the dataset is append-only.
+       * \param first the index of the first datapoint in the range
+       * \param last the index one past the last datapoint in the range
+       * \param margin_x extra margin (in PLplot coordinates) to add to the plot window along the X-axis
+       * \param margin_y extra margin (in PLplot coordinates) to add to the plot window along the Y-axis
+       * \param line \c true if the datapoints will be connected by a line, in which case the datapoints just outside the plot window are included as well
+       * \return a list of (first, last) index pairs
+       */
+      std::vector<std::pair<std::size_t, std::size_t>> get_visible_ranges(std::size_t first, std::size_t last, double margin_x, double margin_y, bool line);
+
+      /** Check if the X-values of the dataset are in ascending order
+       *
+       * Only the datapoints that were appended since the previous call are examined.
+       * \return \c true if the X-values are sorted
+       */
+      virtual bool is_sorted_x();
+
+      /** Find the first datapoint in the range [\c first, \c last) whose X-value is not less than \c value, or greater than \c value if \c upper is \c true
+       *
+       * The X-values must be sorted. For uniformly spaced X-values, the index is calculated directly, otherwise a binary search is used.
+       * \param first the index of the first datapoint in the range
+       * \param last the index one past the last datapoint in the range
+       * \param value the X-value to look for
+       * \param upper \c true to skip the X-values equal to \c value as well
+       * \return the index of the datapoint, or \c last if there is none
+       */
+      std::size_t find_x(std::size_t first, std::size_t last, double value, bool upper);
+
+      /** Draw a line connecting the \c n datapoints starting at index \c first
+       *
+       * Only the parts of the line that cross the plot window are passed to PLplot.
+       * In addition, if decimation is enabled, the X-values are sorted and there are many more datapoints than pixel columns in the plot window,
+       * only the first, last, minimum and maximum datapoint of each pixel column are passed to PLplot, which leaves the rendered line unchanged.
+       * \param pls the PLplot plstream object that will do the actual plotting
+       * \param first the index of the first datapoint in \c x and \c y
+       * \param n the number of datapoints
+       */
+      void draw_line(plstream *pls, std::size_t first, std::size_t n);
+
+      /** Draw a line connecting the datapoints in the range [\c first, \c last), decimating it if appropriate
+       *
+       * \param pls the PLplot plstream object that will do the actual plotting
+       * \param first the index of the first datapoint in \c x and \c y
+       * \param last the index one past the last datapoint
+       */
+      void draw_line_decimated(plstream *pls, std::size_t first, std::size_t last);
+
+      /** Draw a symbol at each of the \c n datapoints starting at index \c first
+       *
+       * Only the symbols that may be visible in the plot window are passed to PLplot.
+       * The symbol color and scale factor must have been set on \c pls before.
+       * \param pls the PLplot plstream object that will do the actual plotting
+       * \param first the index of the first datapoint in \c x and \c y
+       * \param n the number of datapoints
+       */
+      void draw_symbols(plstream *pls, std::size_t first, std::size_t n);
     public:
       /** Constructor
        *
@@ -68,6 +194,45 @@ namespace Gtk {
                  LineStyle line_style = CONTINUOUS,
                  double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
 
+      /** Constructor
+       *
+       * This constructor initializes a new dataset using two vectors, one for the X-values, and one for the Y-values.
+       * The contents of both vectors are moved into the dataset instead of being copied, leaving them empty.
+       * Optionally, one can also use the constructor to override the default color, line style and line width.
+       * \param x the X-values, as std::vector
+       * \param y the Y-values, as std::vector
+       * \param color the line color, default is red
+       * \param line_style the line style, default is CONTINUOUS
+       * \param line_width the line width, default is 1.0
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotData2D(std::vector<double> &&x,
+                 std::vector<double> &&y,
+                 Gdk::RGBA color = Gdk::RGBA("red"),
+                 LineStyle line_style = CONTINUOUS,
+                 double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
+
+      /** Constructor
+       *
+       * This constructor initializes a new dataset using two PlotDataBuffer objects, one for the X-values, and one for the Y-values.
+       * When these are views on external memory, no copy of the data is made: the memory must then remain valid for as long as the dataset exists,
+       * and external_data_modified() must be called whenever its contents have been changed.
+       * Datasets that use views cannot be extended with add_datapoint() or add_datapoints().
+       * The buffers may also store their values as float or integers instead of double, in which case they are converted only when drawn.
+       * Optionally, one can also use the constructor to override the default color, line style and line width.
+       * \param x the X-values, as PlotDataBuffer
+       * \param y the Y-values, as PlotDataBuffer
+       * \param color the line color, default is red
+       * \param line_style the line style, default is CONTINUOUS
+       * \param line_width the line width, default is 1.0
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotData2D(PlotDataBuffer x,
+                 PlotDataBuffer y,
+                 Gdk::RGBA color = Gdk::RGBA("red"),
+                 LineStyle line_style = CONTINUOUS,
+                 double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
+
       /** Constructor
        *
        * This constructor initializes a new dataset using two valarrays, one for the X-values, and one for the Y-values.
@@ -86,8 +251,91 @@ namespace Gtk {
 
       /** Constructor
        *
-       * This constructor initializes a new dataset using a single vector for the Y-values. The X-values will be
-       * set to a vector of the same size with elements set to correspond to their array subscript.
+       * This constructor initializes a new dataset for a uniformly sampled signal, using a single vector for the Y-values.
+       * The X-values are not stored, but calculated as \c x0 + \c i * \c dx. Additional Y-values can be appended with add_datapoint(double) and add_datapoints(const double *, std::size_t).
+       * Optionally, one can also use the constructor to override the default color, line style and line width.
+       * \param x0 the X-value of the first datapoint
+       * \param dx the difference between the X-values of consecutive datapoints
+       * \param y the Y-values, as std::vector
+       * \param color the line color, default is red
+       * \param line_style the line style, default is CONTINUOUS
+       * \param line_width the line width, default is 1.0
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotData2D(double x0,
+                 double dx,
+                 const std::vector<double> &y,
+                 Gdk::RGBA color = Gdk::RGBA("red"),
+                 LineStyle line_style = CONTINUOUS,
+                 double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
+
+      /** Constructor
+       *
+       * This constructor initializes a new dataset for a uniformly sampled signal, using a single vector for the Y-values,
+       * whose contents are moved into the dataset instead of being copied.
+       * The X-values are not stored, but calculated as \c x0 + \c i * \c dx. Additional Y-values can be appended with add_datapoint(double) and add_datapoints(const double *, std::size_t).
+       * Optionally, one can also use the constructor to override the default color, line style and line width.
+       * \param x0 the X-value of the first datapoint
+       * \param dx the difference between the X-values of consecutive datapoints
+       * \param y the Y-values, as std::vector
+       * \param color the line color, default is red
+       * \param line_style the line style, default is CONTINUOUS
+       * \param line_width the line width, default is 1.0
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotData2D(double x0,
+                 double dx,
+                 std::vector<double> &&y,
+                 Gdk::RGBA color = Gdk::RGBA("red"),
+                 LineStyle line_style = CONTINUOUS,
+                 double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
+
+      /** Constructor
+       *
+       * This constructor initializes a new dataset for a uniformly sampled signal, using a single valarray for the Y-values.
+       * The X-values are not stored, but calculated as \c x0 + \c i * \c dx. Additional Y-values can be appended with add_datapoint(double) and add_datapoints(const double *, std::size_t).
+       * Optionally, one can also use the constructor to override the default color, line style and line width.
+       * \param x0 the X-value of the first datapoint
+       * \param dx the difference between the X-values of consecutive datapoints
+       * \param y the Y-values, as std::valarray
+       * \param color the line color, default is red
+       * \param line_style the line style, default is CONTINUOUS
+       * \param line_width the line width, default is 1.0
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotData2D(double x0,
+                 double dx,
+                 const std::valarray<double> &y,
+                 Gdk::RGBA color = Gdk::RGBA("red"),
+                 LineStyle line_style = CONTINUOUS,
+                 double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
+
+      /** Constructor
+       *
+       * This constructor initializes a new dataset for a uniformly sampled signal, using a PlotDataBuffer for the Y-values.
+       * This makes it possible to store the Y-values as float or integers, or to use a view on external memory.
+       * The X-values are not stored, but calculated as \c x0 + \c i * \c dx. Additional Y-values can be appended with add_datapoint(double) and add_datapoints(const double *, std::size_t),
+       * unless \c y is a view.
+       * Optionally, one can also use the constructor to override the default color, line style and line width.
+       * \param x0 the X-value of the first datapoint
+       * \param dx the difference between the X-values of consecutive datapoints
+       * \param y the Y-values, as PlotDataBuffer
+       * \param color the line color, default is red
+       * \param line_style the line style, default is CONTINUOUS
+       * \param line_width the line width, default is 1.0
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotData2D(double x0,
+                 double dx,
+                 PlotDataBuffer y,
+                 Gdk::RGBA color = Gdk::RGBA("red"),
+                 LineStyle line_style = CONTINUOUS,
+                 double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
+
+      /** Constructor
+       *
+       * This constructor initializes a new dataset using a single vector for the Y-values. The X-values will
+       * correspond to their array subscript. They are not stored, but calculated when needed.
        * Optionally, one can also use the constructor to override the default color, line style and line width.
        * \param y the Y-values, as std::vector
        * \param color the line color, default is red
@@ -101,8 +349,23 @@ namespace Gtk {
 
       /** Constructor
        *
-       * This constructor initializes a new dataset using a single valarray for the Y-values. The X-values will be
-       * set to a vector of the same size with elements set to correspond to their array subscript.
+       * This constructor initializes a new dataset using a single vector for the Y-values, whose contents are moved into the dataset instead of being copied.
+       * The X-values will correspond to their array subscript. They are not stored, but calculated when needed.
+       * Optionally, one can also use the constructor to override the default color, line style and line width.
+       * \param y the Y-values, as std::vector
+       * \param color the line color, default is red
+       * \param line_style the line style, default is CONTINUOUS
+       * \param line_width the line width, default is 1.0
+       */
+      PlotData2D(std::vector<double> &&y,
+                 Gdk::RGBA color = Gdk::RGBA("red"),
+                 LineStyle line_style = CONTINUOUS,
+                 double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
+
+      /** Constructor
+       *
+       * This constructor initializes a new dataset using a single valarray for the Y-values. The X-values will
+       * correspond to their array subscript. They are not stored, but calculated when needed.
        * Optionally, one can also use the constructor to override the default color, line style and line width.
        * \param y the Y-values, as std::valarray
        * \param color the line color, default is red
@@ -119,17 +382,38 @@ namespace Gtk {
        */
       virtual ~PlotData2D();
 
+      /** Inform the dataset that the external memory its views refer to has been modified
+       *
+       * This method must be called by the owner of the memory after each change, to ensure that the extremes and other information
+       * derived from the data are recalculated, and that the plot is updated.
+       */
+      virtual void external_data_modified();
+
       /**
        *
        * \returns a copy of the dataset X-values
        */
-      std::vector<double> get_vector_x();
+      virtual std::vector<double> get_vector_x();
 
       /**
        *
        * \returns a copy of the dataset Y-values
        */
-      std::vector<double> get_vector_y();
+      virtual std::vector<double> get_vector_y();
+
+      /** Get read-only access to the X-values, without copying them
+       *
+       * For PlotData2DStrip datasets, the values are returned in the order in which they are stored in the circular buffer.
+       * \returns a reference to the dataset X-values
+       */
+      const PlotDataBuffer &get_data_x() const;
+
+      /** Get read-only access to the Y-values, without copying them
+       *
+       * For PlotData2DStrip datasets, the values are returned in the order in which they are stored in the circular buffer.
+       * \returns a reference to the dataset Y-values
+       */
+      const PlotDataBuffer &get_data_y() const;
 
       /** Get the data extremes: minima and maxima along both X- and Y-axes
        *
@@ -188,12 +472,47 @@ namespace Gtk {
        */
       double get_symbol_height_scale_factor();
 
+      /** Enable or disable decimation of the line connecting the datapoints
+       *
+       * When the X-values are in ascending order and the dataset contains many more datapoints than there are pixel columns in the plot,
+       * only the first, last, minimum and maximum datapoints of each pixel column are used to draw the line.
+       * This leads to the same image, while massively reducing the time needed to render large datasets.
+       * Symbols are always drawn at every datapoint. Decimation is enabled by default.
+       * \param decimation \c true to enable decimation, \c false to disable it
+       */
+      void set_decimation(bool decimation);
+
+      /** Check if decimation of the line connecting the datapoints is enabled
+       *
+       * See set_decimation() for more information
+       * \return \c true if decimation is enabled
+       */
+      bool get_decimation();
+
+      /** Enable or disable the min/max pyramid that speeds up decimation
+       *
+       * When enabled, a multi-resolution index of the Y-minima and maxima is built once and extended whenever datapoints are added.
+       * This reduces the cost of decimating the line from linear in the number of datapoints to proportional to the plot width times the logarithm of the number of datapoints,
+       * which keeps zooming and panning responsive for very large datasets, at the expense of some extra memory.
+       * The pyramid is only used when decimation is enabled and the X-values are in ascending order. Disabled by default.
+       * \param decimation_index \c true to enable the min/max pyramid, \c false to disable and release it
+       */
+      virtual void set_decimation_index(bool decimation_index);
+
+      /** Check if the min/max pyramid that speeds up decimation is enabled
+       *
+       * See set_decimation_index() for more information
+       * \return \c true if the min/max pyramid is enabled
+       */
+      bool get_decimation_index();
+
       /** Add a single datapoint, consisting of an \c xval and \c yval value, to the dataset
        *
        * This datapoint will be added at the end of the std::vector's \c x and \c y.
        * After this method is called, the plot will be automatically updated to reflect the changes.
        * \param xval an X-value
        * \param yval an Y-value
+       * \exception Gtk::PLplot::Exception
        */
       virtual void add_datapoint(double xval, double yval);
 
@@ -202,9 +521,60 @@ namespace Gtk {
        * This datapoint will be added at the end of the std::vector's \c x and \c y.
        * After this method is called, the plot will be automatically updated to reflect the changes.
        * \param xy_pair a std::pair containing both an X- and a Y- value
+       * \exception Gtk::PLplot::Exception
        */
       virtual void add_datapoint(std::pair<double, double> xy_pair);
 
+      /** Add a single datapoint to a dataset whose X-values are uniformly spaced, such as those created using only Y-values
+       *
+       * The X-value of the datapoint follows from the spacing of the X-values, and is not stored.
+       * After this method is called, the plot will be automatically updated to reflect the changes.
+       * \param yval an Y-value
+       * \exception Gtk::PLplot::Exception
+       */
+      virtual void add_datapoint(double yval);
+
+      /** Add several datapoints to the dataset
+       *
+       * The datapoints will be added at the end of the std::vector's \c x and \c y.
+       * Contrary to calling add_datapoint() repeatedly, the plot will be updated only once, after all datapoints have been added.
+       * \param x pointer to \c n X-values
+       * \param y pointer to \c n Y-values
+       * \param n the number of datapoints to add
+       * \exception Gtk::PLplot::Exception
+       */
+      virtual void add_datapoints(const double *x, const double *y, std::size_t n);
+
+      /** Add several datapoints to a dataset whose X-values are uniformly spaced, such as those created using only Y-values
+       *
+       * The X-values of the datapoints follow from the spacing of the X-values, and are not stored.
+       * Contrary to calling add_datapoint() repeatedly, the plot will be updated only once, after all datapoints have been added.
+       * \param y pointer to \c n Y-values
+       * \param n the number of datapoints to add
+       * \exception Gtk::PLplot::Exception
+       */
+      virtual void add_datapoints(const double *y, std::size_t n);
+
+      /** Add several datapoints to the dataset
+       *
+       * The datapoints will be added at the end of the std::vector's \c x and \c y.
+       * Contrary to calling add_datapoint() repeatedly, the plot will be updated only once, after all datapoints have been added.
+       * \param x the X-values, as std::vector
+       * \param y the Y-values, as std::vector
+       * \exception Gtk::PLplot::Exception
+       */
+      void add_datapoints(const std::vector<double> &x, const std::vector<double> &y);
+
+      /** Add several datapoints to the dataset
+       *
+       * The datapoints will be added at the end of the std::vector's \c x and \c y.
+       * Contrary to calling add_datapoint() repeatedly, the plot will be updated only once, after all datapoints have been added.
+       * \param x the X-values, as std::valarray
+       * \param y the Y-values, as std::valarray
+       * \exception Gtk::PLplot::Exception
+       */
+      void add_datapoints(const std::valarray<double> &x, const std::valarray<double> &y);
+
       /** Method to draw the dataset
        *
        * This method is virtual allowing inheriting classes to implement their own method with the same signature.
@@ -19,25 +19,26 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <gtkmm-plplot/exception.h>
 #include <gtkmm-plplot/utils.h>
 #include <plstream.h>
+#include <algorithm>
 
 using namespace Gtk::PLplot;
 
 PlotData2DErrorX::PlotData2DErrorX(
-  const std::vector<double> &_x,
-  const std::vector<double> &_y,
-  const std::vector<double> &_errorx_low,
-  const std::vector<double> &_errorx_high,
+  std::vector<double> &&_x,
+  std::vector<double> &&_y,
+  std::vector<double> &&_errorx_low,
+  std::vector<double> &&_errorx_high,
   Gdk::RGBA _color,
   LineStyle _line_style,
   double _line_width) :
   Glib::ObjectBase("GtkmmPLplotPlotData2DErrorX"),
-  PlotData2D(_x, _y, _color, _line_style, _line_width),
-  errorx_low(_errorx_low),
-  errorx_high(_errorx_high),
+  PlotData2D(std::move(_x), std::move(_y), _color, _line_style, _line_width),
+  errorx_low(std::move(_errorx_low)),
+  errorx_high(std::move(_errorx_high)),
   errorx_color(_color) {
 
   //ensure all arrays have the same size
-  if (y.size() != _errorx_low.size() || y.size() != _errorx_high.size()) {
+  if (y.size() != errorx_low.size() || y.size() != errorx_high.size()) {
     throw Exception("Gtk::PLplot::PlotData2DErrorX::PlotData2DErrorX -> data arrays x, y, errorx_low and errorx_high must have the same size!");
   }
 
@@ -48,8 +49,25 @@ PlotData2DErrorX::PlotData2DErrorX(
     else if (errorx_high[i] < x[i])
       throw Exception("Gtk::PLplot::PlotData2DErrorX::PlotData2DErrorX -> errorx_high elements must be greater than the corresponding elements in x");
   }
+
+  update_extremes(0);
 }
 
+PlotData2DErrorX::PlotData2DErrorX(
+  const std::vector<double> &_x,
+  const std::vector<double> &_y,
+  const std::vector<double> &_errorx_low,
+  const std::vector<double> &_errorx_high,
+  Gdk::RGBA _color,
+  LineStyle _line_style,
+  double _line_width) :
+  PlotData2DErrorX(
+    std::vector<double>(_x),
+    std::vector<double>(_y),
+    std::vector<double>(_errorx_low),
+    std::vector<double>(_errorx_high),
+    _color, _line_style, _line_width) {}
+
 PlotData2DErrorX::PlotData2DErrorX(
   const std::valarray<double> &_x,
   const std::valarray<double> &_y,
@@ -83,18 +101,92 @@ std::vector<double> PlotData2DErrorX::get_vector_error_x_high() {
   return errorx_high;
 }
 
-void PlotData2DErrorX::get_extremes(double &xmin, double &xmax, double &ymin, double &ymax) {
-  xmin = *std::min_element(errorx_low.begin(), errorx_low.end());
-  xmax = *std::max_element(errorx_high.begin(), errorx_high.end());
-  ymin = *std::min_element(y.begin(), y.end());
-  ymax = *std::max_element(y.begin(), y.end());
+const std::vector<double> &PlotData2DErrorX::get_data_error_x_low() const {
+  return errorx_low;
+}
+
+const std::vector<double> &PlotData2DErrorX::get_data_error_x_high() const {
+  return errorx_high;
+}
+
+void PlotData2DErrorX::update_extremes(std::size_t first) {
+  if (first == 0) {
+    extremes_x[0] = errorx_low[0];
+    extremes_x[1] = errorx_high[0];
+    extremes_y[0] = extremes_y[1] = y[0];
+  }
+
+  if (first >= x.size())
+    return;
+
+  for (std::size_t i = first ; i < x.size() ; i++) {
+    extremes_x[0] = std::min(extremes_x[0], errorx_low[i]);
+    extremes_x[1] = std::max(extremes_x[1], errorx_high[i]);
+  }
+
+  std::size_t imin, imax;
+  y.find_extremes(first, y.size(), imin, imax);
+  extremes_y[0] = std::min(extremes_y[0], y[imin]);
+  extremes_y[1] = std::max(extremes_y[1], y[imax]);
+}
+
+void PlotData2DErrorX::add_datapoints(const double *_x, const double *_y, std::size_t n) {
+  throw Exception("Gtk::PLplot::PlotData2DErrorX::add_datapoints -> This method is not supported for PlotData2DErrorX");
+}
+
+void PlotData2DErrorX::add_datapoints(const double *_x, const double *_y, const double *_errorx_low, const double *_errorx_high, std::size_t n) {
+  if (n == 0)
+    return;
+
+  // sanity check
+  for (std::size_t i = 0 ; i < n ; i++) {
+    if (_errorx_low[i] > _x[i])
+      throw Exception("Gtk::PLplot::PlotData2DErrorX::add_datapoints -> errorx_low elements must be less than the corresponding elements in x");
+    else if (_errorx_high[i] < _x[i])
+      throw Exception("Gtk::PLplot::PlotData2DErrorX::add_datapoints -> errorx_high elements must be greater than the corresponding elements in x");
+  }
+
+  const std::size_t first = x.size();
+  x.append(_x, n);
+  y.append(_y, n);
+  errorx_low.insert(errorx_low.end(), _errorx_low, _errorx_low + n);
+  errorx_high.insert(errorx_high.end(), _errorx_high, _errorx_high + n);
+  update_extremes(first);
+  notify_data_modified();
+}
+
+void PlotData2DErrorX::add_datapoints(
+  const std::vector<double> &_x,
+  const std::vector<double> &_y,
+  const std::vector<double> &_errorx_low,
+  const std::vector<double> &_errorx_high) {
+
+  if (_x.size() != _y.size() || _x.size() != _errorx_low.size() || _x.size() != _errorx_high.size())
+    throw Exception("Gtk::PLplot::PlotData2DErrorX::add_datapoints -> data arrays x, y, errorx_low and errorx_high must have the same size!");
+
+  add_datapoints(_x.data(), _y.data(), _errorx_low.data(), _errorx_high.data(), _x.size());
+}
+
+void PlotData2DErrorX::add_datapoints(
+  const std::valarray<double> &_x,
+  const std::valarray<double> &_y,
+  const std::valarray<double> &_errorx_low,
+  const std::valarray<double> &_errorx_high) {
+
+  if (_x.size() != _y.size() || _x.size() != _errorx_low.size() || _x.size() != _errorx_high.size())
+    throw Exception("Gtk::PLplot::PlotData2DErrorX::add_datapoints -> data arrays x, y, errorx_low and errorx_high must have the same size!");
+
+  if (_x.size() == 0)
+    return;
+
+  add_datapoints(&_x[0], &_y[0], &_errorx_low[0], &_errorx_high[0], _x.size());
 }
 
 void PlotData2DErrorX::set_error_x_color(Gdk::RGBA _errorx_color) {
   if (_errorx_color == errorx_color)
     return;
   errorx_color = _errorx_color;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 Gdk::RGBA PlotData2DErrorX::get_error_x_color() {
@@ -112,14 +204,14 @@ void PlotData2DErrorX::add_datapoint(double xval, double yval, double xval_error
   y.push_back(yval);
   errorx_low.push_back(xval_error_low);
   errorx_high.push_back(xval_error_high);
-  _signal_data_modified.emit();
+  update_extremes(x.size() - 1);
+  notify_data_modified();
 }
 
 void PlotData2DErrorX::draw_plot_data(const Cairo::RefPtr<Cairo::Context> &cr, plstream *pls) {
   if (!is_showing())
     return;
 
-  double *x_pl = &x[0], *y_pl = &y[0];
   double *errorx_low_pl = &errorx_low[0];
   double *errorx_high_pl = &errorx_high[0];
 
@@ -128,18 +220,19 @@ void PlotData2DErrorX::draw_plot_data(const Cairo::RefPtr<Cairo::Context> &cr, p
     change_plstream_color(pls, color);
     pls->lsty(line_style);
     pls->width(line_width);
-    pls->line(x.size(), x_pl, y_pl);
+    draw_line(pls, 0, x.size());
   }
 
   // plot the x errorbars
   change_plstream_color(pls, errorx_color);
   // need to see what happens with the errorbars when changing the line_width and line_style
-  pls->errx(x.size(), errorx_low_pl, errorx_high_pl, y_pl);
+  // y was constructed from a std::vector<double>, so get_contiguous() returns a pointer into it
+  pls->errx(x.size(), errorx_low_pl, errorx_high_pl, y.get_contiguous(0, y.size(), decimated_y));
 
   // plot the symbols if requested
   if (!symbol.empty()) {
     change_plstream_color(pls, symbol_color);
     pls->schr(0, symbol_scale_factor);
-    pls->string(x.size(), x_pl, y_pl, symbol.c_str());
+    draw_symbols(pls, 0, x.size());
   }
 }
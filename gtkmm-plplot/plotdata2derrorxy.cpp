@@ -19,9 +19,29 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <gtkmm-plplot/exception.h>
 #include <gtkmm-plplot/utils.h>
 #include <plstream.h>
+#include <algorithm>
 
 using namespace Gtk::PLplot;
 
+PlotData2DErrorXY::PlotData2DErrorXY(
+  std::vector<double> &&_x,
+  std::vector<double> &&_y,
+  std::vector<double> &&_errorx_low,
+  std::vector<double> &&_errorx_high,
+  std::vector<double> &&_errory_low,
+  std::vector<double> &&_errory_high,
+  Gdk::RGBA _color,
+  LineStyle _line_style,
+  double _line_width) :
+  Glib::ObjectBase("GtkmmPLplotPlotData2DErrorXY"),
+  PlotData2D(std::move(_x), std::move(_y), _color, _line_style, _line_width),
+  //the X- and Y-values passed to the parent classes are ignored, since the virtual PlotData2D base has already been initialized above
+  PlotData2DErrorX(std::vector<double>(), std::vector<double>(), std::move(_errorx_low), std::move(_errorx_high), _color, _line_style, _line_width),
+  PlotData2DErrorY(std::vector<double>(), std::vector<double>(), std::move(_errory_low), std::move(_errory_high), _color, _line_style, _line_width) {
+
+  update_extremes(0);
+}
+
 PlotData2DErrorXY::PlotData2DErrorXY(
   const std::vector<double> &_x,
   const std::vector<double> &_y,
@@ -32,11 +52,14 @@ PlotData2DErrorXY::PlotData2DErrorXY(
   Gdk::RGBA _color,
   LineStyle _line_style,
   double _line_width) :
-  Glib::ObjectBase("GtkmmPLplotPlotData2DErrorXY"),
-  PlotData2D(_x, _y, _color, _line_style, _line_width),
-  PlotData2DErrorX(_x, _y, _errorx_low, _errorx_high, _color, _line_style, _line_width),
-  PlotData2DErrorY(_x, _y, _errory_low, _errory_high, _color, _line_style, _line_width)
-   {}
+  PlotData2DErrorXY(
+    std::vector<double>(_x),
+    std::vector<double>(_y),
+    std::vector<double>(_errorx_low),
+    std::vector<double>(_errorx_high),
+    std::vector<double>(_errory_low),
+    std::vector<double>(_errory_high),
+    _color, _line_style, _line_width) {}
 
 PlotData2DErrorXY::PlotData2DErrorXY(
   const std::valarray<double> &_x,
@@ -71,11 +94,90 @@ void PlotData2DErrorXY::add_datapoint(double _x, double _y, double _v, double _w
   throw Exception("Gtk::PLplot::PlotData2DErrorXY::add_datapoint -> This method is not supported for PlotData2DErrorXY");
 }
 
-void PlotData2DErrorXY::get_extremes(double &xmin, double &xmax, double &ymin, double &ymax) {
-  xmin = *std::min_element(errorx_low.begin(), errorx_low.end());
-  xmax = *std::max_element(errorx_high.begin(), errorx_high.end());
-  ymin = *std::min_element(errory_low.begin(), errory_low.end());
-  ymax = *std::max_element(errory_high.begin(), errory_high.end());
+void PlotData2DErrorXY::update_extremes(std::size_t first) {
+  if (first == 0) {
+    extremes_x[0] = errorx_low[0];
+    extremes_x[1] = errorx_high[0];
+    extremes_y[0] = errory_low[0];
+    extremes_y[1] = errory_high[0];
+  }
+
+  for (std::size_t i = first ; i < x.size() ; i++) {
+    extremes_x[0] = std::min(extremes_x[0], errorx_low[i]);
+    extremes_x[1] = std::max(extremes_x[1], errorx_high[i]);
+    extremes_y[0] = std::min(extremes_y[0], errory_low[i]);
+    extremes_y[1] = std::max(extremes_y[1], errory_high[i]);
+  }
+}
+
+void PlotData2DErrorXY::add_datapoints(const double *_x, const double *_y, std::size_t n) {
+  throw Exception("Gtk::PLplot::PlotData2DErrorXY::add_datapoints -> This method is not supported for PlotData2DErrorXY");
+}
+
+void PlotData2DErrorXY::add_datapoints(const double *_x, const double *_y, const double *_v, const double *_w, std::size_t n) {
+  throw Exception("Gtk::PLplot::PlotData2DErrorXY::add_datapoints -> This method is not supported for PlotData2DErrorXY");
+}
+
+void PlotData2DErrorXY::add_datapoints(const double *_x, const double *_y, const double *_errorx_low, const double *_errorx_high, const double *_errory_low, const double *_errory_high, std::size_t n) {
+  if (n == 0)
+    return;
+
+  // sanity check
+  for (std::size_t i = 0 ; i < n ; i++) {
+    if (_errorx_low[i] > _x[i])
+      throw Exception("Gtk::PLplot::PlotData2DErrorXY::add_datapoints -> errorx_low elements must be less than the corresponding elements in x");
+    else if (_errorx_high[i] < _x[i])
+      throw Exception("Gtk::PLplot::PlotData2DErrorXY::add_datapoints -> errorx_high elements must be greater than the corresponding elements in x");
+    if (_errory_low[i] > _y[i])
+      throw Exception("Gtk::PLplot::PlotData2DErrorXY::add_datapoints -> errory_low elements must be less than the corresponding elements in y");
+    else if (_errory_high[i] < _y[i])
+      throw Exception("Gtk::PLplot::PlotData2DErrorXY::add_datapoints -> errory_high elements must be greater than the corresponding elements in y");
+  }
+
+  const std::size_t first = x.size();
+  x.append(_x, n);
+  y.append(_y, n);
+  errorx_low.insert(errorx_low.end(), _errorx_low, _errorx_low + n);
+  errorx_high.insert(errorx_high.end(), _errorx_high, _errorx_high + n);
+  errory_low.insert(errory_low.end(), _errory_low, _errory_low + n);
+  errory_high.insert(errory_high.end(), _errory_high, _errory_high + n);
+  update_extremes(first);
+  notify_data_modified();
+}
+
+void PlotData2DErrorXY::add_datapoints(
+  const std::vector<double> &_x,
+  const std::vector<double> &_y,
+  const std::vector<double> &_errorx_low,
+  const std::vector<double> &_errorx_high,
+  const std::vector<double> &_errory_low,
+  const std::vector<double> &_errory_high) {
+
+  if (_x.size() != _y.size() ||
+      _x.size() != _errorx_low.size() || _x.size() != _errorx_high.size() ||
+      _x.size() != _errory_low.size() || _x.size() != _errory_high.size())
+    throw Exception("Gtk::PLplot::PlotData2DErrorXY::add_datapoints -> data arrays x, y, errorx_low, errorx_high, errory_low and errory_high must have the same size!");
+
+  add_datapoints(_x.data(), _y.data(), _errorx_low.data(), _errorx_high.data(), _errory_low.data(), _errory_high.data(), _x.size());
+}
+
+void PlotData2DErrorXY::add_datapoints(
+  const std::valarray<double> &_x,
+  const std::valarray<double> &_y,
+  const std::valarray<double> &_errorx_low,
+  const std::valarray<double> &_errorx_high,
+  const std::valarray<double> &_errory_low,
+  const std::valarray<double> &_errory_high) {
+
+  if (_x.size() != _y.size() ||
+      _x.size() != _errorx_low.size() || _x.size() != _errorx_high.size() ||
+      _x.size() != _errory_low.size() || _x.size() != _errory_high.size())
+    throw Exception("Gtk::PLplot::PlotData2DErrorXY::add_datapoints -> data arrays x, y, errorx_low, errorx_high, errory_low and errory_high must have the same size!");
+
+  if (_x.size() == 0)
+    return;
+
+  add_datapoints(&_x[0], &_y[0], &_errorx_low[0], &_errorx_high[0], &_errory_low[0], &_errory_high[0], _x.size());
 }
 
 void PlotData2DErrorXY::add_datapoint(double xval, double yval, double xval_error_low, double xval_error_high, double yval_error_low, double yval_error_high) {
@@ -95,14 +197,14 @@ void PlotData2DErrorXY::add_datapoint(double xval, double yval, double xval_erro
   errorx_high.push_back(xval_error_high);
   errory_low.push_back(yval_error_low);
   errory_high.push_back(yval_error_high);
-  _signal_data_modified.emit();
+  update_extremes(x.size() - 1);
+  notify_data_modified();
 }
 
 void PlotData2DErrorXY::draw_plot_data(const Cairo::RefPtr<Cairo::Context> &cr, plstream *pls) {
   if (!is_showing())
     return;
 
-  double *x_pl = &x[0], *y_pl = &y[0];
   double *errorx_low_pl = &errorx_low[0];
   double *errorx_high_pl = &errorx_high[0];
   double *errory_low_pl = &errory_low[0];
@@ -113,22 +215,23 @@ void PlotData2DErrorXY::draw_plot_data(const Cairo::RefPtr<Cairo::Context> &cr,
     change_plstream_color(pls, color);
     pls->lsty(line_style);
     pls->width(line_width);
-    pls->line(x.size(), x_pl, y_pl);
+    draw_line(pls, 0, x.size());
   }
 
   // plot the x errorbars
   change_plstream_color(pls, errorx_color);
   // need to see what happens with the errorbars when changing the line_width and line_style
-  pls->errx(x.size(), errorx_low_pl, errorx_high_pl, y_pl);
+  // both x and y were constructed from a std::vector<double>, so get_contiguous() returns pointers into them
+  pls->errx(x.size(), errorx_low_pl, errorx_high_pl, y.get_contiguous(0, y.size(), decimated_y));
   // plot the x errorbars
   change_plstream_color(pls, errory_color);
   // need to see what happens with the errorbars when changing the line_width and line_style
-  pls->erry(x.size(), x_pl, errory_low_pl, errory_high_pl);
+  pls->erry(x.size(), x.get_contiguous(0, x.size(), decimated_x), errory_low_pl, errory_high_pl);
 
   // plot the symbols if requested
   if (!symbol.empty()) {
     change_plstream_color(pls, symbol_color);
     pls->schr(0, symbol_scale_factor);
-    pls->string(x.size(), x_pl, y_pl, symbol.c_str());
+    draw_symbols(pls, 0, x.size());
   }
 }
@@ -44,7 +44,15 @@ namespace Gtk {
       virtual void add_datapoint(double xval, double yval) final; ///< disable this method
       virtual void add_datapoint(std::pair<double, double> xy_pair) final; ///< disable this method;
       virtual void add_datapoint(double xval, double yval, double xval_error_low, double xval_error_high) final; ///< disable this method
+      virtual void add_datapoints(const double *x, const double *y, std::size_t n) final; ///< disable this method
+      virtual void add_datapoints(const double *x, const double *y, const double *xval_error_low, const double *xval_error_high, std::size_t n) final; ///< disable this method
     protected:
+      /** Update \c extremes_x and \c extremes_y to take into account the datapoints starting at index \c first
+       *
+       * The extremes are determined by the errorbars instead of by the X- and Y-values.
+       * \param first index of the first datapoint that has not been taken into account yet. Pass 0 to recalculate the extremes from scratch.
+       */
+      virtual void update_extremes(std::size_t first) override;
     public:
       /** Constructor
        *
@@ -74,6 +82,35 @@ namespace Gtk {
                         LineStyle line_style = CONTINUOUS,
                         double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
 
+      /** Constructor
+       *
+       * This constructor initializes a new dataset using six vectors, one for the X-values, one for the Y-values,
+       * and four vectors to define the errorsbars of the X-data and Y-data.
+       * The contents of the vectors are moved into the dataset instead of being copied, leaving them empty.
+       * Optionally, one can also use the constructor to override the default color, line style and line width.
+       * By default, the color of the errorbars will be the same as the one chosen at construction time for the line.
+       * Override this by calling set_error_x_color() and set_error_y_color() after constructing the dataset.
+       * \param x the X-values, as std::vector
+       * \param y the Y-values, as std::vector
+       * \param errorx_low the lower values of the X-data errorbars. Each value must be less than its X-data counterpart.
+       * \param errorx_high the upper values of the X-data errorbars. Each value must be greater than its X-data counterpart.
+       * \param errory_low the lower values of the Y-data errorbars. Each value must be less than its Y-data counterpart.
+       * \param errory_high the upper values of the Y-data errorbars. Each value must be greater than its Y-data counterpart.
+       * \param color the line color, default is red
+       * \param line_style the line style, default is CONTINUOUS
+       * \param line_width the line width, default is 1.0
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotData2DErrorXY(std::vector<double> &&x,
+                        std::vector<double> &&y,
+                        std::vector<double> &&errorx_low,
+                        std::vector<double> &&errorx_high,
+                        std::vector<double> &&errory_low,
+                        std::vector<double> &&errory_high,
+                        Gdk::RGBA color = Gdk::RGBA("red"),
+                        LineStyle line_style = CONTINUOUS,
+                        double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
+
       /** Constructor
        *
        * This constructor initializes a new dataset using four valarrays, one for the X-values, one for the Y-values,
@@ -106,15 +143,6 @@ namespace Gtk {
        */
       virtual ~PlotData2DErrorXY();
 
-      /** Get the data extremes: minima and maxima along both X- and Y-axes
-       *
-       * \param xmin X minimum value
-       * \param xmax X maximum value
-       * \param ymin Y minimum value
-       * \param ymax Y minimum value
-       */
-      virtual void get_extremes(double &xmin, double &xmax, double &ymin, double &ymax) override;
-
       /** Add a single datapoint, consisting of an \c xval and \c yval value, as well as the errors associated with the \c xval and \c yval values, to the dataset
        *
        * This datapoint will be added at the end of the std::vector's \c x and \c y.
@@ -128,6 +156,49 @@ namespace Gtk {
        */
       virtual void add_datapoint(double xval, double yval, double xval_error_low, double xval_error_high, double yval_error_low, double yval_error_high);
 
+      /** Add several datapoints, including the errors associated with their X- and Y-values, to the dataset
+       *
+       * The datapoints will be added at the end of the std::vector's \c x and \c y.
+       * Contrary to calling add_datapoint() repeatedly, the plot will be updated only once, after all datapoints have been added.
+       * \param x pointer to \c n X-values
+       * \param y pointer to \c n Y-values
+       * \param errorx_low pointer to \c n lower endpoints of the X-data errorbars
+       * \param errorx_high pointer to \c n upper endpoints of the X-data errorbars
+       * \param errory_low pointer to \c n lower endpoints of the Y-data errorbars
+       * \param errory_high pointer to \c n upper endpoints of the Y-data errorbars
+       * \param n the number of datapoints to add
+       * \exception Gtk::PLplot::Exception
+       */
+      virtual void add_datapoints(const double *x, const double *y, const double *errorx_low, const double *errorx_high, const double *errory_low, const double *errory_high, std::size_t n);
+
+      /** Add several datapoints, including the errors associated with their X- and Y-values, to the dataset
+       *
+       * The datapoints will be added at the end of the std::vector's \c x and \c y.
+       * Contrary to calling add_datapoint() repeatedly, the plot will be updated only once, after all datapoints have been added.
+       * \param x the X-values, as std::vector
+       * \param y the Y-values, as std::vector
+       * \param errorx_low the lower endpoints of the X-data errorbars, as std::vector
+       * \param errorx_high the upper endpoints of the X-data errorbars, as std::vector
+       * \param errory_low the lower endpoints of the Y-data errorbars, as std::vector
+       * \param errory_high the upper endpoints of the Y-data errorbars, as std::vector
+       * \exception Gtk::PLplot::Exception
+       */
+      void add_datapoints(const std::vector<double> &x, const std::vector<double> &y, const std::vector<double> &errorx_low, const std::vector<double> &errorx_high, const std::vector<double> &errory_low, const std::vector<double> &errory_high);
+
+      /** Add several datapoints, including the errors associated with their X- and Y-values, to the dataset
+       *
+       * The datapoints will be added at the end of the std::vector's \c x and \c y.
+       * Contrary to calling add_datapoint() repeatedly, the plot will be updated only once, after all datapoints have been added.
+       * \param x the X-values, as std::valarray
+       * \param y the Y-values, as std::valarray
+       * \param errorx_low the lower endpoints of the X-data errorbars, as std::valarray
+       * \param errorx_high the upper endpoints of the X-data errorbars, as std::valarray
+       * \param errory_low the lower endpoints of the Y-data errorbars, as std::valarray
+       * \param errory_high the upper endpoints of the Y-data errorbars, as std::valarray
+       * \exception Gtk::PLplot::Exception
+       */
+      void add_datapoints(const std::valarray<double> &x, const std::valarray<double> &y, const std::valarray<double> &errorx_low, const std::valarray<double> &errorx_high, const std::valarray<double> &errory_low, const std::valarray<double> &errory_high);
+
       /** Method to draw the dataset
        *
        * This method is virtual allowing inheriting classes to implement their own method with the same signature.
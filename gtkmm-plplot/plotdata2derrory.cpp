@@ -19,25 +19,26 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <gtkmm-plplot/exception.h>
 #include <gtkmm-plplot/utils.h>
 #include <plstream.h>
+#include <algorithm>
 
 using namespace Gtk::PLplot;
 
 PlotData2DErrorY::PlotData2DErrorY(
-  const std::vector<double> &_x,
-  const std::vector<double> &_y,
-  const std::vector<double> &_errory_low,
-  const std::vector<double> &_errory_high,
+  std::vector<double> &&_x,
+  std::vector<double> &&_y,
+  std::vector<double> &&_errory_low,
+  std::vector<double> &&_errory_high,
   Gdk::RGBA _color,
   LineStyle _line_style,
   double _line_width) :
   Glib::ObjectBase("GtkmmPLplotPlotData2DErrorY"),
-  PlotData2D(_x, _y, _color, _line_style, _line_width),
-  errory_low(_errory_low),
-  errory_high(_errory_high),
+  PlotData2D(std::move(_x), std::move(_y), _color, _line_style, _line_width),
+  errory_low(std::move(_errory_low)),
+  errory_high(std::move(_errory_high)),
   errory_color(_color) {
 
   //ensure all arrays have the same size
-  if (y.size() != _errory_low.size() || y.size() != _errory_high.size()) {
+  if (y.size() != errory_low.size() || y.size() != errory_high.size()) {
     throw Exception("Gtk::PLplot::PlotData2DErrorY::PlotData2DErrorY -> data arrays x, y, errory_low and errory_high must have the same size!");
   }
 
@@ -48,8 +49,25 @@ PlotData2DErrorY::PlotData2DErrorY(
     else if (errory_high[i] < y[i])
       throw Exception("Gtk::PLplot::PlotData2DErrorY::PlotData2DErrorY -> errory_high elements must be greater than the corresponding elements in y");
   }
+
+  update_extremes(0);
 }
 
+PlotData2DErrorY::PlotData2DErrorY(
+  const std::vector<double> &_x,
+  const std::vector<double> &_y,
+  const std::vector<double> &_errory_low,
+  const std::vector<double> &_errory_high,
+  Gdk::RGBA _color,
+  LineStyle _line_style,
+  double _line_width) :
+  PlotData2DErrorY(
+    std::vector<double>(_x),
+    std::vector<double>(_y),
+    std::vector<double>(_errory_low),
+    std::vector<double>(_errory_high),
+    _color, _line_style, _line_width) {}
+
 PlotData2DErrorY::PlotData2DErrorY(
   const std::valarray<double> &_x,
   const std::valarray<double> &_y,
@@ -83,18 +101,92 @@ std::vector<double> PlotData2DErrorY::get_vector_error_y_high() {
   return errory_high;
 }
 
-void PlotData2DErrorY::get_extremes(double &xmin, double &xmax, double &ymin, double &ymax) {
-  xmin = *std::min_element(x.begin(), x.end());
-  xmax = *std::max_element(x.begin(), x.end());
-  ymin = *std::min_element(errory_low.begin(), errory_low.end());
-  ymax = *std::max_element(errory_high.begin(), errory_high.end());
+const std::vector<double> &PlotData2DErrorY::get_data_error_y_low() const {
+  return errory_low;
+}
+
+const std::vector<double> &PlotData2DErrorY::get_data_error_y_high() const {
+  return errory_high;
+}
+
+void PlotData2DErrorY::update_extremes(std::size_t first) {
+  if (first == 0) {
+    extremes_x[0] = extremes_x[1] = x[0];
+    extremes_y[0] = errory_low[0];
+    extremes_y[1] = errory_high[0];
+  }
+
+  if (first >= x.size())
+    return;
+
+  std::size_t imin, imax;
+  x.find_extremes(first, x.size(), imin, imax);
+  extremes_x[0] = std::min(extremes_x[0], x[imin]);
+  extremes_x[1] = std::max(extremes_x[1], x[imax]);
+
+  for (std::size_t i = first ; i < x.size() ; i++) {
+    extremes_y[0] = std::min(extremes_y[0], errory_low[i]);
+    extremes_y[1] = std::max(extremes_y[1], errory_high[i]);
+  }
+}
+
+void PlotData2DErrorY::add_datapoints(const double *_x, const double *_y, std::size_t n) {
+  throw Exception("Gtk::PLplot::PlotData2DErrorY::add_datapoints -> This method is not supported for PlotData2DErrorY");
+}
+
+void PlotData2DErrorY::add_datapoints(const double *_x, const double *_y, const double *_errory_low, const double *_errory_high, std::size_t n) {
+  if (n == 0)
+    return;
+
+  // sanity check
+  for (std::size_t i = 0 ; i < n ; i++) {
+    if (_errory_low[i] > _y[i])
+      throw Exception("Gtk::PLplot::PlotData2DErrorY::add_datapoints -> errory_low elements must be less than the corresponding elements in y");
+    else if (_errory_high[i] < _y[i])
+      throw Exception("Gtk::PLplot::PlotData2DErrorY::add_datapoints -> errory_high elements must be greater than the corresponding elements in y");
+  }
+
+  const std::size_t first = x.size();
+  x.append(_x, n);
+  y.append(_y, n);
+  errory_low.insert(errory_low.end(), _errory_low, _errory_low + n);
+  errory_high.insert(errory_high.end(), _errory_high, _errory_high + n);
+  update_extremes(first);
+  notify_data_modified();
+}
+
+void PlotData2DErrorY::add_datapoints(
+  const std::vector<double> &_x,
+  const std::vector<double> &_y,
+  const std::vector<double> &_errory_low,
+  const std::vector<double> &_errory_high) {
+
+  if (_x.size() != _y.size() || _x.size() != _errory_low.size() || _x.size() != _errory_high.size())
+    throw Exception("Gtk::PLplot::PlotData2DErrorY::add_datapoints -> data arrays x, y, errory_low and errory_high must have the same size!");
+
+  add_datapoints(_x.data(), _y.data(), _errory_low.data(), _errory_high.data(), _x.size());
+}
+
+void PlotData2DErrorY::add_datapoints(
+  const std::valarray<double> &_x,
+  const std::valarray<double> &_y,
+  const std::valarray<double> &_errory_low,
+  const std::valarray<double> &_errory_high) {
+
+  if (_x.size() != _y.size() || _x.size() != _errory_low.size() || _x.size() != _errory_high.size())
+    throw Exception("Gtk::PLplot::PlotData2DErrorY::add_datapoints -> data arrays x, y, errory_low and errory_high must have the same size!");
+
+  if (_x.size() == 0)
+    return;
+
+  add_datapoints(&_x[0], &_y[0], &_errory_low[0], &_errory_high[0], _x.size());
 }
 
 void PlotData2DErrorY::set_error_y_color(Gdk::RGBA _errory_color) {
   if (_errory_color == errory_color)
     return;
   errory_color = _errory_color;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 Gdk::RGBA PlotData2DErrorY::get_error_y_color() {
@@ -112,14 +204,14 @@ void PlotData2DErrorY::add_datapoint(double xval, double yval, double yval_error
   y.push_back(yval);
   errory_low.push_back(yval_error_low);
   errory_high.push_back(yval_error_high);
-  _signal_data_modified.emit();
+  update_extremes(x.size() - 1);
+  notify_data_modified();
 }
 
 void PlotData2DErrorY::draw_plot_data(const Cairo::RefPtr<Cairo::Context> &cr, plstream *pls) {
   if (!is_showing())
     return;
 
-  double *x_pl = &x[0], *y_pl = &y[0];
   double *errory_low_pl = &errory_low[0];
   double *errory_high_pl = &errory_high[0];
 
@@ -128,18 +220,19 @@ void PlotData2DErrorY::draw_plot_data(const Cairo::RefPtr<Cairo::Context> &cr, p
     change_plstream_color(pls, color);
     pls->lsty(line_style);
     pls->width(line_width);
-    pls->line(x.size(), x_pl, y_pl);
+    draw_line(pls, 0, x.size());
   }
 
   // plot the y errorbars
   change_plstream_color(pls, errory_color);
   // need to see what happens with the errorbars when changing the line_width and line_style
-  pls->erry(x.size(), x_pl, errory_low_pl, errory_high_pl);
+  // x was constructed from a std::vector<double>, so get_contiguous() returns a pointer into it
+  pls->erry(x.size(), x.get_contiguous(0, x.size(), decimated_x), errory_low_pl, errory_high_pl);
 
   // plot the symbols if requested
   if (!symbol.empty()) {
     change_plstream_color(pls, symbol_color);
     pls->schr(0, symbol_scale_factor);
-    pls->string(x.size(), x_pl, y_pl, symbol.c_str());
+    draw_symbols(pls, 0, x.size());
   }
 }
@@ -42,10 +42,18 @@ namespace Gtk {
       PlotData2DErrorY(const PlotData2DErrorY &source) = delete; ///< no default copy constructor;
       virtual void add_datapoint(double xval, double yval) override; ///< disable this method
       virtual void add_datapoint(std::pair<double, double> xy_pair) override; ///< disable this method;
+      virtual void add_datapoints(const double *x, const double *y, std::size_t n) override; ///< disable this method
     protected:
       std::vector<double> errory_low; ///< The lower error margins of the Y-data
       std::vector<double> errory_high; ///< The upper error margins of the Y-data
       Gdk::RGBA errory_color; ///< The color of the Y-data errorbars
+
+      /** Update \c extremes_x and \c extremes_y to take into account the datapoints starting at index \c first
+       *
+       * The Y-extremes are determined by the errorbars instead of by the Y-values.
+       * \param first index of the first datapoint that has not been taken into account yet. Pass 0 to recalculate the extremes from scratch.
+       */
+      virtual void update_extremes(std::size_t first) override;
     public:
       /** Constructor
        *
@@ -71,6 +79,31 @@ namespace Gtk {
                        LineStyle line_style = CONTINUOUS,
                        double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
 
+      /** Constructor
+       *
+       * This constructor initializes a new dataset using four vectors, one for the X-values, one for the Y-values,
+       * and two vectors to define the errorsbar of the Y-data.
+       * The contents of the vectors are moved into the dataset instead of being copied, leaving them empty.
+       * Optionally, one can also use the constructor to override the default color, line style and line width.
+       * By default, the color of the errorbars will be the same as the one chosen at construction time for the line.
+       * Override this by calling set_error_y_color() after constructing the dataset.
+       * \param x the X-values, as std::vector
+       * \param y the Y-values, as std::vector
+       * \param errory_low the lower values of the Y-data errorbars. Each value must be less than its Y-data counterpart.
+       * \param errory_high the upper values of the Y-data errorbars. Each value must be greater than its Y-data counterpart.
+       * \param color the line color, default is red
+       * \param line_style the line style, default is CONTINUOUS
+       * \param line_width the line width, default is 1.0
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotData2DErrorY(std::vector<double> &&x,
+                       std::vector<double> &&y,
+                       std::vector<double> &&errory_low,
+                       std::vector<double> &&errory_high,
+                       Gdk::RGBA color = Gdk::RGBA("red"),
+                       LineStyle line_style = CONTINUOUS,
+                       double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
+
       /** Constructor
        *
        * This constructor initializes a new dataset using four valarrays, one for the X-values, one for the Y-values,
@@ -111,14 +144,17 @@ namespace Gtk {
        */
       std::vector<double> get_vector_error_y_high();
 
-      /** Get the data extremes: minima and maxima along both X- and Y-axes
+      /** Get read-only access to the Y-values lower error values, without copying them
+       *
+       * \returns a reference to the dataset Y-values lower error values
+       */
+      const std::vector<double> &get_data_error_y_low() const;
+
+      /** Get read-only access to the Y-values higher error values, without copying them
        *
-       * \param xmin X minimum value
-       * \param xmax X maximum value
-       * \param ymin Y minimum value
-       * \param ymax Y minimum value
+       * \returns a reference to the dataset Y-values higher error values
        */
-      virtual void get_extremes(double &xmin, double &xmax, double &ymin, double &ymax) override;
+      const std::vector<double> &get_data_error_y_high() const;
 
       /** Set the Y-dataset errorbar color
        *
@@ -143,6 +179,43 @@ namespace Gtk {
        */
       virtual void add_datapoint(double xval, double yval, double yval_error_low, double yval_error_high);
 
+      /** Add several datapoints, including the errors associated with their Y-values, to the dataset
+       *
+       * The datapoints will be added at the end of the std::vector's \c x and \c y.
+       * Contrary to calling add_datapoint() repeatedly, the plot will be updated only once, after all datapoints have been added.
+       * \param x pointer to \c n X-values
+       * \param y pointer to \c n Y-values
+       * \param errory_low pointer to \c n lower endpoints of the Y-data errorbars
+       * \param errory_high pointer to \c n upper endpoints of the Y-data errorbars
+       * \param n the number of datapoints to add
+       * \exception Gtk::PLplot::Exception
+       */
+      virtual void add_datapoints(const double *x, const double *y, const double *errory_low, const double *errory_high, std::size_t n);
+
+      /** Add several datapoints, including the errors associated with their Y-values, to the dataset
+       *
+       * The datapoints will be added at the end of the std::vector's \c x and \c y.
+       * Contrary to calling add_datapoint() repeatedly, the plot will be updated only once, after all datapoints have been added.
+       * \param x the X-values, as std::vector
+       * \param y the Y-values, as std::vector
+       * \param errory_low the lower endpoints of the Y-data errorbars, as std::vector
+       * \param errory_high the upper endpoints of the Y-data errorbars, as std::vector
+       * \exception Gtk::PLplot::Exception
+       */
+      void add_datapoints(const std::vector<double> &x, const std::vector<double> &y, const std::vector<double> &errory_low, const std::vector<double> &errory_high);
+
+      /** Add several datapoints, including the errors associated with their Y-values, to the dataset
+       *
+       * The datapoints will be added at the end of the std::vector's \c x and \c y.
+       * Contrary to calling add_datapoint() repeatedly, the plot will be updated only once, after all datapoints have been added.
+       * \param x the X-values, as std::valarray
+       * \param y the Y-values, as std::valarray
+       * \param errory_low the lower endpoints of the Y-data errorbars, as std::valarray
+       * \param errory_high the upper endpoints of the Y-data errorbars, as std::valarray
+       * \exception Gtk::PLplot::Exception
+       */
+      void add_datapoints(const std::valarray<double> &x, const std::valarray<double> &y, const std::valarray<double> &errory_low, const std::valarray<double> &errory_high);
+
       /** Method to draw the dataset
        *
        * This method is virtual allowing inheriting classes to implement their own method with the same signature.
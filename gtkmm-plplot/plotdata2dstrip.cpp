@@ -0,0 +1,240 @@
+/*
+Copyright (C) 2016 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtkmm-plplot/plotdata2dstrip.h>
+#include <gtkmm-plplot/exception.h>
+#include <gtkmm-plplot/utils.h>
+#include <plstream.h>
+
+using namespace Gtk::PLplot;
+
+typedef std::deque<std::pair<std::size_t, double>> MonotonicQueue;
+
+// push a value with sequence number seq onto a monotonic queue, and drop entries older than oldest from its front.
+// for minima, entries that are greater than or equal to the new value can never become the front again, and vice versa for maxima.
+static void monotonic_queue_push(MonotonicQueue &queue, std::size_t seq, double value, std::size_t oldest, bool minimum) {
+  if (minimum) {
+    while (!queue.empty() && queue.back().second >= value)
+      queue.pop_back();
+  }
+  else {
+    while (!queue.empty() && queue.back().second <= value)
+      queue.pop_back();
+  }
+  queue.emplace_back(seq, value);
+
+  while (queue.front().first < oldest)
+    queue.pop_front();
+}
+
+PlotData2DStrip::PlotData2DStrip(
+  std::size_t _capacity,
+  std::vector<double> &&_x,
+  std::vector<double> &&_y,
+  Gdk::RGBA _color,
+  LineStyle _line_style,
+  double _line_width) :
+  Glib::ObjectBase("GtkmmPLplotPlotData2DStrip"),
+  PlotData2D(std::move(_x), std::move(_y), _color, _line_style, _line_width),
+  capacity(_capacity),
+  head(0) {
+
+  append_only = false;
+
+  if (capacity < 2) {
+    throw Exception("Gtk::PLplot::PlotData2DStrip::PlotData2DStrip -> capacity must be at least 2");
+  }
+
+  // keep only the most recent datapoints
+  if (x.size() > capacity) {
+    y.erase_front(y.size() - capacity);
+    x.erase_front(x.size() - capacity);
+  }
+  x.reserve(capacity);
+  y.reserve(capacity);
+
+  sequence = x.size();
+  update_extremes(0);
+}
+
+PlotData2DStrip::PlotData2DStrip(
+  std::size_t _capacity,
+  const std::vector<double> &_x,
+  const std::vector<double> &_y,
+  Gdk::RGBA _color,
+  LineStyle _line_style,
+  double _line_width) :
+  PlotData2DStrip(_capacity, std::vector<double>(_x), std::vector<double>(_y),
+  _color, _line_style, _line_width) {}
+
+PlotData2DStrip::PlotData2DStrip(
+  std::size_t _capacity,
+  const std::valarray<double> &_x,
+  const std::valarray<double> &_y,
+  Gdk::RGBA _color,
+  LineStyle _line_style,
+  double _line_width) :
+  PlotData2DStrip(_capacity,
+  std::vector<double>(std::begin(_x), std::end(_x)),
+  std::vector<double>(std::begin(_y), std::end(_y)),
+  _color, _line_style, _line_width) {}
+
+PlotData2DStrip::~PlotData2DStrip() {}
+
+std::size_t PlotData2DStrip::get_capacity() {
+  return capacity;
+}
+
+std::vector<double> PlotData2DStrip::get_vector_x() {
+  std::vector<double> rv(x.begin() + head, x.end());
+  rv.insert(rv.end(), x.begin(), x.begin() + head);
+  return rv;
+}
+
+std::vector<double> PlotData2DStrip::get_vector_y() {
+  std::vector<double> rv(y.begin() + head, y.end());
+  rv.insert(rv.end(), y.begin(), y.begin() + head);
+  return rv;
+}
+
+void PlotData2DStrip::push_datapoint(double _x, double _y) {
+  // keep track of the order of the X-values: the pair formed by the two oldest datapoints
+  // disappears when the buffer is full, while a new pair is formed with the newest datapoint
+  if (!x.empty()) {
+    const std::size_t newest = (head + x.size() - 1) % x.size();
+    if (x.size() == capacity && x[(head + 1) % capacity] < x[head])
+      descending_pairs--;
+    if (_x < x[newest])
+      descending_pairs++;
+  }
+
+  if (x.size() < capacity) {
+    x.push_back(_x);
+    y.push_back(_y);
+  }
+  else {
+    x.set(head, _x);
+    y.set(head, _y);
+    head = (head + 1) % capacity;
+  }
+
+  const std::size_t seq = sequence++;
+  const std::size_t oldest = sequence - x.size();
+
+  monotonic_queue_push(window_min_x, seq, _x, oldest, true);
+  monotonic_queue_push(window_max_x, seq, _x, oldest, false);
+  monotonic_queue_push(window_min_y, seq, _y, oldest, true);
+  monotonic_queue_push(window_max_y, seq, _y, oldest, false);
+}
+
+void PlotData2DStrip::refresh_extremes() {
+  extremes_x[0] = window_min_x.front().second;
+  extremes_x[1] = window_max_x.front().second;
+  extremes_y[0] = window_min_y.front().second;
+  extremes_y[1] = window_max_y.front().second;
+}
+
+void PlotData2DStrip::update_extremes(std::size_t first) {
+  if (first == 0) {
+    window_min_x.clear();
+    window_max_x.clear();
+    window_min_y.clear();
+    window_max_y.clear();
+
+    descending_pairs = 0;
+
+    const std::size_t oldest = sequence - x.size();
+
+    // walk through the buffer from oldest to newest
+    for (std::size_t i = 0 ; i < x.size() ; i++) {
+      const std::size_t index = (head + i) % x.size();
+      if (i > 0 && x[index] < x[(head + i - 1) % x.size()])
+        descending_pairs++;
+      monotonic_queue_push(window_min_x, oldest + i, x[index], oldest, true);
+      monotonic_queue_push(window_max_x, oldest + i, x[index], oldest, false);
+      monotonic_queue_push(window_min_y, oldest + i, y[index], oldest, true);
+      monotonic_queue_push(window_max_y, oldest + i, y[index], oldest, false);
+    }
+  }
+
+  refresh_extremes();
+}
+
+void PlotData2DStrip::set_decimation_index(bool _decimation_index) {
+  throw Exception("Gtk::PLplot::PlotData2DStrip::set_decimation_index -> This method is not supported for PlotData2DStrip");
+}
+
+bool PlotData2DStrip::is_sorted_x() {
+  return descending_pairs == 0;
+}
+
+void PlotData2DStrip::add_datapoint(double _x, double _y) {
+  push_datapoint(_x, _y);
+  refresh_extremes();
+  notify_data_modified();
+}
+
+void PlotData2DStrip::add_datapoints(const double *_x, const double *_y, std::size_t n) {
+  if (n == 0)
+    return;
+
+  // datapoints that would be evicted by the same call anyway can be skipped
+  if (n > capacity) {
+    sequence += n - capacity;
+    _x += n - capacity;
+    _y += n - capacity;
+    n = capacity;
+  }
+
+  for (std::size_t i = 0 ; i < n ; i++)
+    push_datapoint(_x[i], _y[i]);
+
+  refresh_extremes();
+  notify_data_modified();
+}
+
+void PlotData2DStrip::draw_plot_data(const Cairo::RefPtr<Cairo::Context> &cr, plstream *pls) {
+  // as long as the buffer has not wrapped around, the data is contiguous
+  if (head == 0) {
+    PlotData2D::draw_plot_data(cr, pls);
+    return;
+  }
+
+  if (!is_showing())
+    return;
+
+  // the oldest datapoints are found in [head, x.size()), the newest in [0, head)
+  const std::size_t n_old = x.size() - head;
+
+  // plot the line if requested
+  if (line_style != LineStyle::NONE) {
+    change_plstream_color(pls, color);
+    pls->lsty(line_style);
+    pls->width(line_width);
+    draw_line(pls, head, n_old);
+    pls->join(x.back(), y.back(), x[0], y[0]);
+    draw_line(pls, 0, head);
+  }
+
+  // plot the symbols if requested
+  if (!symbol.empty()) {
+    change_plstream_color(pls, symbol_color);
+    pls->schr(0, symbol_scale_factor);
+    draw_symbols(pls, head, n_old);
+    draw_symbols(pls, 0, head);
+  }
+}
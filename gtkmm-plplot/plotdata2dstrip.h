@@ -0,0 +1,197 @@
+/*
+Copyright (C) 2016 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GTKMM_PLPLOT_PLOTDATA2D_STRIP_H
+#define GTKMM_PLPLOT_PLOTDATA2D_STRIP_H
+
+#include <gtkmm-plplot/plotdata2d.h>
+#include <deque>
+#include <utility>
+
+namespace Gtk {
+  namespace PLplot {
+    /** \class PlotData2DStrip plotdata2dstrip.h <gtkmm-plplot/plotdata2dstrip.h>
+     *  \brief a class that will hold a fixed number of the most recent datapoints of a continuously growing XY dataset
+     *
+     *  Instances of this class are meant for strip charts: datapoints are added one by one (or in blocks)
+     *  with add_datapoint() and add_datapoints(), and once the capacity chosen at construction time has been reached,
+     *  each new datapoint replaces the oldest one. Memory usage therefore remains constant, no matter how long the data keeps coming in.
+     *  Internally, \c x and \c y are used as circular buffers, while the minima and maxima of the datapoints currently
+     *  in the buffer are kept up to date using monotonic queues, making the cost of adding a datapoint independent of the capacity.
+     *  Apart from this, instances of this class behave exactly like their PlotData2D parent class.
+     */
+    class PlotData2DStrip : public PlotData2D {
+    private:
+      PlotData2DStrip() = delete; ///< no default constructor
+      PlotData2DStrip &operator=(const PlotData2DStrip &) = delete; ///< no assignment operator
+      PlotData2DStrip(const PlotData2DStrip &source) = delete; ///< no default copy constructor;
+      virtual void set_decimation_index(bool decimation_index) override; ///< disable this method, since the circular buffer is overwritten in place
+
+      /** Append a datapoint to the circular buffer, evicting the oldest one if the buffer is full
+       *
+       * This does not emit any signals and does not update \c extremes_x and \c extremes_y.
+       * \param xval an X-value
+       * \param yval an Y-value
+       */
+      void push_datapoint(double xval, double yval);
+
+      /** Copy the fronts of the monotonic queues into \c extremes_x and \c extremes_y
+       *
+       */
+      void refresh_extremes();
+    protected:
+      std::size_t capacity; ///< the maximum number of datapoints that will be kept
+      std::size_t head; ///< the index in \c x and \c y of the oldest datapoint. Always 0 as long as the buffer is not full.
+      std::size_t sequence; ///< the total number of datapoints that were ever added to the dataset
+      std::deque<std::pair<std::size_t, double>> window_min_x; ///< monotonic queue of (sequence number, value) pairs, whose front is the current X minimum
+      std::deque<std::pair<std::size_t, double>> window_max_x; ///< monotonic queue of (sequence number, value) pairs, whose front is the current X maximum
+      std::deque<std::pair<std::size_t, double>> window_min_y; ///< monotonic queue of (sequence number, value) pairs, whose front is the current Y minimum
+      std::deque<std::pair<std::size_t, double>> window_max_y; ///< monotonic queue of (sequence number, value) pairs, whose front is the current Y maximum
+      std::size_t descending_pairs; ///< the number of consecutive datapoints in the buffer whose X-values are in descending order
+
+      /** Update \c extremes_x and \c extremes_y
+       *
+       * Since the monotonic queues are updated whenever a datapoint is added, they only need to be rebuilt if \c first is 0.
+       * \param first pass 0 to rebuild the monotonic queues from scratch.
+       */
+      virtual void update_extremes(std::size_t first) override;
+
+      /** Check if the X-values of the datapoints in the buffer are in ascending order, from oldest to newest
+       *
+       * \return \c true if the X-values are sorted
+       */
+      virtual bool is_sorted_x() override;
+    public:
+      /** Constructor
+       *
+       * This constructor initializes a new dataset using two vectors, one for the X-values, and one for the Y-values.
+       * If these contain more than \c capacity datapoints, only the last \c capacity ones will be retained.
+       * Optionally, one can also use the constructor to override the default color, line style and line width.
+       * \param capacity the maximum number of datapoints that will be kept. Must be at least 2.
+       * \param x the X-values, as std::vector
+       * \param y the Y-values, as std::vector
+       * \param color the line color, default is red
+       * \param line_style the line style, default is CONTINUOUS
+       * \param line_width the line width, default is 1.0
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotData2DStrip(std::size_t capacity,
+                      const std::vector<double> &x,
+                      const std::vector<double> &y,
+                      Gdk::RGBA color = Gdk::RGBA("red"),
+                      LineStyle line_style = CONTINUOUS,
+                      double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
+
+      /** Constructor
+       *
+       * This constructor initializes a new dataset using two vectors, one for the X-values, and one for the Y-values.
+       * The contents of both vectors are moved into the dataset instead of being copied, leaving them empty.
+       * If these contain more than \c capacity datapoints, only the last \c capacity ones will be retained.
+       * Optionally, one can also use the constructor to override the default color, line style and line width.
+       * \param capacity the maximum number of datapoints that will be kept. Must be at least 2.
+       * \param x the X-values, as std::vector
+       * \param y the Y-values, as std::vector
+       * \param color the line color, default is red
+       * \param line_style the line style, default is CONTINUOUS
+       * \param line_width the line width, default is 1.0
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotData2DStrip(std::size_t capacity,
+                      std::vector<double> &&x,
+                      std::vector<double> &&y,
+                      Gdk::RGBA color = Gdk::RGBA("red"),
+                      LineStyle line_style = CONTINUOUS,
+                      double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
+
+      /** Constructor
+       *
+       * This constructor initializes a new dataset using two valarrays, one for the X-values, and one for the Y-values.
+       * If these contain more than \c capacity datapoints, only the last \c capacity ones will be retained.
+       * Optionally, one can also use the constructor to override the default color, line style and line width.
+       * \param capacity the maximum number of datapoints that will be kept. Must be at least 2.
+       * \param x the X-values, as std::valarray
+       * \param y the Y-values, as std::valarray
+       * \param color the line color, default is red
+       * \param line_style the line style, default is CONTINUOUS
+       * \param line_width the line width, default is 1.0
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotData2DStrip(std::size_t capacity,
+                      const std::valarray<double> &x,
+                      const std::valarray<double> &y,
+                      Gdk::RGBA color = Gdk::RGBA("red"),
+                      LineStyle line_style = CONTINUOUS,
+                      double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
+
+      /** Destructor
+       *
+       */
+      virtual ~PlotData2DStrip();
+
+      /** Get the maximum number of datapoints that will be kept
+       *
+       * \returns the capacity
+       */
+      std::size_t get_capacity();
+
+      /**
+       *
+       * \returns a copy of the dataset X-values, from oldest to newest
+       */
+      virtual std::vector<double> get_vector_x() override;
+
+      /**
+       *
+       * \returns a copy of the dataset Y-values, from oldest to newest
+       */
+      virtual std::vector<double> get_vector_y() override;
+
+      using PlotData2D::add_datapoint;
+      using PlotData2D::add_datapoints;
+
+      /** Add a single datapoint, consisting of an \c xval and \c yval value, to the dataset
+       *
+       * If the dataset already holds \c capacity datapoints, the oldest one will be discarded.
+       * After this method is called, the plot will be automatically updated to reflect the changes.
+       * \param xval an X-value
+       * \param yval an Y-value
+       */
+      virtual void add_datapoint(double xval, double yval) override;
+
+      /** Add several datapoints to the dataset
+       *
+       * For each datapoint beyond \c capacity, the oldest one will be discarded.
+       * Contrary to calling add_datapoint() repeatedly, the plot will be updated only once, after all datapoints have been added.
+       * \param x pointer to \c n X-values
+       * \param y pointer to \c n Y-values
+       * \param n the number of datapoints to add
+       */
+      virtual void add_datapoints(const double *x, const double *y, std::size_t n) override;
+
+      /** Method to draw the dataset
+       *
+       * Once the circular buffer has wrapped around, the two contiguous parts of the buffer are passed to PLplot
+       * (and decimated, if appropriate) separately, avoiding the need for a linearized copy of the data.
+       * \param cr the cairo context to draw to.
+       * \param pls the PLplot plstream object that will do the actual plotting on the Cairo context
+       */
+      virtual void draw_plot_data(const Cairo::RefPtr<Cairo::Context> &cr, plstream *pls) override;
+    };
+  }
+}
+
+#endif
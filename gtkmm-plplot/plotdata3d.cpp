@@ -19,26 +19,50 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <gtkmm-plplot/exception.h>
 #include <gtkmm-plplot/utils.h>
 #include <plstream.h>
+#include <algorithm>
+
 
 using namespace Gtk::PLplot;
 
 PlotData3D::PlotData3D(
-  const std::vector<double> &_x,
-  const std::vector<double> &_y,
-  const std::vector<double> &_z,
+  PlotDataBuffer _x,
+  PlotDataBuffer _y,
+  PlotDataBuffer _z,
   Gdk::RGBA _color,
   LineStyle _line_style,
   double _line_width) :
   Glib::ObjectBase("GtkmmPLplotPlotData3D"),
-  PlotData2D(_x, _y, _color, _line_style, _line_width),
-  z(_z) {
+  PlotData2D(std::move(_x), std::move(_y), _color, _line_style, _line_width),
+  z(std::move(_z)) {
 
   //ensure all arrays have the same size
   if (y.size() != z.size()) {
     throw Exception("Gtk::PLplot::PlotData3D::PlotData3D -> data arrays x, y and z must have the same size!");
   }
+
+  update_extremes(0);
 }
 
+PlotData3D::PlotData3D(
+  const std::vector<double> &_x,
+  const std::vector<double> &_y,
+  const std::vector<double> &_z,
+  Gdk::RGBA _color,
+  LineStyle _line_style,
+  double _line_width) :
+  PlotData3D(PlotDataBuffer(_x), PlotDataBuffer(_y), PlotDataBuffer(_z),
+  _color, _line_style, _line_width) {}
+
+PlotData3D::PlotData3D(
+  std::vector<double> &&_x,
+  std::vector<double> &&_y,
+  std::vector<double> &&_z,
+  Gdk::RGBA _color,
+  LineStyle _line_style,
+  double _line_width) :
+  PlotData3D(PlotDataBuffer(std::move(_x)), PlotDataBuffer(std::move(_y)), PlotDataBuffer(std::move(_z)),
+  _color, _line_style, _line_width) {}
+
 PlotData3D::PlotData3D(
   const std::valarray<double> &_x,
   const std::valarray<double> &_y,
@@ -46,9 +70,7 @@ PlotData3D::PlotData3D(
   Gdk::RGBA _color,
   LineStyle _line_style,
   double _line_width) :
-  PlotData3D(std::vector<double>(std::begin(_x), std::end(_x)),
-  std::vector<double>(std::begin(_y), std::end(_y)),
-  std::vector<double>(std::begin(_z), std::end(_z)),
+  PlotData3D(PlotDataBuffer(_x), PlotDataBuffer(_y), PlotDataBuffer(_z),
   _color, _line_style, _line_width) {}
 
 PlotData3D::~PlotData3D() {}
@@ -61,39 +83,107 @@ void PlotData3D::add_datapoint(std::pair<double, double> _xy_pair) {
   throw Exception("Gtk::PLplot::PlotData3D::add_datapoint -> This method is not supported for PlotData3D");
 }
 
+void PlotData3D::add_datapoint(double _y) {
+  throw Exception("Gtk::PLplot::PlotData3D::add_datapoint -> This method is not supported for PlotData3D");
+}
+
+void PlotData3D::add_datapoints(const double *_y, std::size_t n) {
+  throw Exception("Gtk::PLplot::PlotData3D::add_datapoints -> This method is not supported for PlotData3D");
+}
+
 void PlotData3D::add_datapoint(double _x, double _y, double _z) {
   x.push_back(_x);
   y.push_back(_y);
   z.push_back(_z);
-  _signal_data_modified.emit();
+  update_extremes(x.size() - 1);
+  notify_data_modified();
 }
 
 void PlotData3D::add_datapoint(std::tuple<double, double, double> _xyz) {
   add_datapoint(std::get<0>(_xyz), std::get<1>(_xyz), std::get<2>(_xyz));
 }
 
+void PlotData3D::add_datapoints(const double *_x, const double *_y, std::size_t n) {
+  throw Exception("Gtk::PLplot::PlotData3D::add_datapoints -> This method is not supported for PlotData3D");
+}
+
+void PlotData3D::add_datapoints(const double *_x, const double *_y, const double *_z, std::size_t n) {
+  if (n == 0)
+    return;
+
+  const std::size_t first = x.size();
+  x.append(_x, n);
+  y.append(_y, n);
+  z.append(_z, n);
+  update_extremes(first);
+  notify_data_modified();
+}
+
+void PlotData3D::add_datapoints(const std::vector<double> &_x, const std::vector<double> &_y, const std::vector<double> &_z) {
+  if (_x.size() != _y.size() || _x.size() != _z.size())
+    throw Exception("Gtk::PLplot::PlotData3D::add_datapoints -> data arrays x, y and z must have the same size!");
+
+  add_datapoints(_x.data(), _y.data(), _z.data(), _x.size());
+}
+
+void PlotData3D::add_datapoints(const std::valarray<double> &_x, const std::valarray<double> &_y, const std::valarray<double> &_z) {
+  if (_x.size() != _y.size() || _x.size() != _z.size())
+    throw Exception("Gtk::PLplot::PlotData3D::add_datapoints -> data arrays x, y and z must have the same size!");
+
+  if (_x.size() == 0)
+    return;
+
+  add_datapoints(&_x[0], &_y[0], &_z[0], _x.size());
+}
+
 std::vector<double> PlotData3D::get_vector_z() {
+  return std::vector<double>(z.begin(), z.end());
+}
+
+const PlotDataBuffer &PlotData3D::get_data_z() const {
   return z;
 }
 
+void PlotData3D::update_extremes(std::size_t first) {
+  PlotData2D::update_extremes(first);
+
+  if (first == 0)
+    extremes_z[0] = extremes_z[1] = z[0];
+
+  if (first < z.size()) {
+    std::size_t imin, imax;
+    z.find_extremes(first, z.size(), imin, imax);
+    extremes_z[0] = std::min(extremes_z[0], z[imin]);
+    extremes_z[1] = std::max(extremes_z[1], z[imax]);
+  }
+}
+
+void PlotData3D::get_extremes(double &xmin, double &xmax, double &ymin, double &ymax, double &zmin, double &zmax) {
+  get_extremes(xmin, xmax, ymin, ymax);
+  zmin = extremes_z[0];
+  zmax = extremes_z[1];
+}
+
 void PlotData3D::draw_plot_data(const Cairo::RefPtr<Cairo::Context> &cr, plstream *pls) {
   if (!is_showing())
     return;
 
-  double *x_pl = &x[0], *y_pl = &y[0], *z_pl = &z[0];
-
   // plot the line if requested
   if (line_style != LineStyle::NONE) {
     change_plstream_color(pls, color);
     pls->lsty(line_style);
     pls->width(line_width);
-    pls->line3(x.size(), x_pl, y_pl, z_pl);
+    PlotDataBuffer::for_each_chunk({&x, &y, &z}, 0, x.size(), true, [pls](std::size_t n, const double * const *values){
+      pls->line3(n, values[0], values[1], values[2]);
+    });
   }
 
   // plot the symbols if requested
   if (!symbol.empty()) {
     change_plstream_color(pls, symbol_color);
     pls->schr(0, symbol_scale_factor);
-    pls->string3(x.size(), x_pl, y_pl, z_pl, symbol.c_str());
+    PlotDataBuffer::for_each_chunk({&x, &y, &z}, 0, x.size(), false, [pls, this](std::size_t n, const double * const *values){
+      pls->string3(n, values[0], values[1], values[2], symbol.c_str());
+    });
   }
 }
@@ -61,8 +61,42 @@ namespace Gtk {
        * \exception Gtk::PLplot::Exception
        */
       virtual void add_datapoint(std::pair<double, double> xy_pair) final;
+
+      /** Add several datapoints, consisting of \c x and \c y values, to the dataset
+       *
+       * **Do not use this method for PlotData3D objects, an exception will be thrown!**
+       * \param x pointer to \c n X-values
+       * \param y pointer to \c n Y-values
+       * \param n the number of datapoints to add
+       * \exception Gtk::PLplot::Exception
+       */
+      virtual void add_datapoints(const double *x, const double *y, std::size_t n) final;
+
+      /** Add a single datapoint to a dataset whose X-values are uniformly spaced
+       *
+       * **Do not use this method for PlotData3D objects, an exception will be thrown!**
+       * \param yval an Y-value
+       * \exception Gtk::PLplot::Exception
+       */
+      virtual void add_datapoint(double yval) final;
+
+      /** Add several datapoints to a dataset whose X-values are uniformly spaced
+       *
+       * **Do not use this method for PlotData3D objects, an exception will be thrown!**
+       * \param y pointer to \c n Y-values
+       * \param n the number of datapoints to add
+       * \exception Gtk::PLplot::Exception
+       */
+      virtual void add_datapoints(const double *y, std::size_t n) final;
     protected:
-      std::vector<double> z; ///< The Z-values of the dataset
+      PlotDataBuffer z; ///< The Z-values of the dataset
+      double extremes_z[2]; ///< the minimum and maximum of the dataset along the Z-axis, as returned by get_extremes()
+
+      /** Update \c extremes_x, \c extremes_y and \c extremes_z to take into account the datapoints starting at index \c first
+       *
+       * \param first index of the first datapoint that has not been taken into account yet. Pass 0 to recalculate the extremes from scratch.
+       */
+      virtual void update_extremes(std::size_t first) override;
     public:
       /** Constructor
        *
@@ -83,6 +117,26 @@ namespace Gtk {
                  LineStyle line_style = CONTINUOUS,
                  double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
 
+      /** Constructor
+       *
+       * This constructor initializes a new dataset using three vectors, for the X-, Y- and Z-values.
+       * The contents of the vectors are moved into the dataset instead of being copied, leaving them empty.
+       * Optionally, one can also use the constructor to override the default color, line style and line width.
+       * \param x the X-values, as std::vector
+       * \param y the Y-values, as std::vector
+       * \param z the Z-values, as std::vector
+       * \param color the line color, default is red
+       * \param line_style the line style, default is CONTINUOUS
+       * \param line_width the line width, default is 1.0
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotData3D(std::vector<double> &&x,
+                 std::vector<double> &&y,
+                 std::vector<double> &&z,
+                 Gdk::RGBA color = Gdk::RGBA("red"),
+                 LineStyle line_style = CONTINUOUS,
+                 double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
+
       /** Constructor
        *
        * This constructor initializes a new dataset using two valarrays, one for the X-values, and one for the Y-values.
@@ -101,6 +155,28 @@ namespace Gtk {
                  LineStyle line_style = CONTINUOUS,
                  double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
 
+      /** Constructor
+       *
+       * This constructor initializes a new dataset using three PlotDataBuffer objects, for the X-, Y- and Z-values.
+       * When these are views on external memory, no copy of the data is made: the memory must then remain valid for as long as the dataset exists,
+       * and external_data_modified() must be called whenever its contents have been changed.
+       * Datasets that use views cannot be extended with add_datapoint() or add_datapoints().
+       * Optionally, one can also use the constructor to override the default color, line style and line width.
+       * \param x the X-values, as PlotDataBuffer
+       * \param y the Y-values, as PlotDataBuffer
+       * \param z the Z-values, as PlotDataBuffer
+       * \param color the line color, default is red
+       * \param line_style the line style, default is CONTINUOUS
+       * \param line_width the line width, default is 1.0
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotData3D(PlotDataBuffer x,
+                 PlotDataBuffer y,
+                 PlotDataBuffer z,
+                 Gdk::RGBA color = Gdk::RGBA("red"),
+                 LineStyle line_style = CONTINUOUS,
+                 double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
+
       /** Destructor
        *
        */
@@ -112,6 +188,25 @@ namespace Gtk {
        */
       std::vector<double> get_vector_z();
 
+      /** Get read-only access to the Z-values, without copying them
+       *
+       * \returns a reference to the dataset Z-values
+       */
+      const PlotDataBuffer &get_data_z() const;
+
+      using PlotData2D::get_extremes;
+
+      /** Get the data extremes: minima and maxima along the X-, Y- and Z-axes
+       *
+       * \param xmin X minimum value
+       * \param xmax X maximum value
+       * \param ymin Y minimum value
+       * \param ymax Y maximum value
+       * \param zmin Z minimum value
+       * \param zmax Z maximum value
+       */
+      virtual void get_extremes(double &xmin, double &xmax, double &ymin, double &ymax, double &zmin, double &zmax);
+
       /** Add a single datapoint, consisting of an \c xval, \c yval and \c zval value, to the dataset
        *
        * This datapoint will be added at the end of the std::vector's \c x, \c y and \c z.
@@ -130,6 +225,39 @@ namespace Gtk {
        */
       virtual void add_datapoint(std::tuple<double, double, double> xyz_tuple);
 
+      /** Add several datapoints to the dataset
+       *
+       * The datapoints will be added at the end of the std::vector's \c x, \c y and \c z.
+       * Contrary to calling add_datapoint() repeatedly, the plot will be updated only once, after all datapoints have been added.
+       * \param x pointer to \c n X-values
+       * \param y pointer to \c n Y-values
+       * \param z pointer to \c n Z-values
+       * \param n the number of datapoints to add
+       */
+      virtual void add_datapoints(const double *x, const double *y, const double *z, std::size_t n);
+
+      /** Add several datapoints to the dataset
+       *
+       * The datapoints will be added at the end of the std::vector's \c x, \c y and \c z.
+       * Contrary to calling add_datapoint() repeatedly, the plot will be updated only once, after all datapoints have been added.
+       * \param x the X-values, as std::vector
+       * \param y the Y-values, as std::vector
+       * \param z the Z-values, as std::vector
+       * \exception Gtk::PLplot::Exception
+       */
+      void add_datapoints(const std::vector<double> &x, const std::vector<double> &y, const std::vector<double> &z);
+
+      /** Add several datapoints to the dataset
+       *
+       * The datapoints will be added at the end of the std::vector's \c x, \c y and \c z.
+       * Contrary to calling add_datapoint() repeatedly, the plot will be updated only once, after all datapoints have been added.
+       * \param x the X-values, as std::valarray
+       * \param y the Y-values, as std::valarray
+       * \param z the Z-values, as std::valarray
+       * \exception Gtk::PLplot::Exception
+       */
+      void add_datapoints(const std::valarray<double> &x, const std::valarray<double> &y, const std::valarray<double> &z);
+
       /** Method to draw the dataset
        *
        * This method is virtual allowing inheriting classes to implement their own method with the same signature.
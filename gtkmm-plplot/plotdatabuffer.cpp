@@ -0,0 +1,481 @@
+/*
+Copyright (C) 2016 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtkmm-plplot/plotdatabuffer.h>
+#include <glibmm/ustring.h>
+#include <gtkmm-plplot/exception.h>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+using namespace Gtk::PLplot;
+
+// convert a double to the type in which the values are stored: integers are rounded to the nearest representable value
+template<typename T>
+static T sample_from_double(double value) {
+  if (std::isnan(value))
+    return 0;
+  else if (value <= std::numeric_limits<T>::min())
+    return std::numeric_limits<T>::min();
+  else if (value >= std::numeric_limits<T>::max())
+    return std::numeric_limits<T>::max();
+  return static_cast<T>(std::lround(value));
+}
+
+template<>
+float sample_from_double<float>(double value) {
+  return static_cast<float>(value);
+}
+
+template<typename T>
+static void append_samples(std::vector<T> &samples, const double *values, std::size_t n) {
+  samples.reserve(samples.size() + n);
+  for (std::size_t i = 0 ; i < n ; i++)
+    samples.push_back(sample_from_double<T>(values[i]));
+}
+
+template<typename T>
+static void convert_samples(const T *samples, std::size_t stride, std::size_t n, double *values) {
+  for (std::size_t i = 0 ; i < n ; i++)
+    values[i] = samples[i * stride];
+}
+
+// the kernels below are instantiated for each type of sample, and are called after looking up how the values are stored only once.
+// data points to the first stored value, and stride is the distance between consecutive values.
+template<typename T>
+static void find_extremes_kernel(const T *data, std::size_t stride, std::size_t first, std::size_t last, std::size_t &imin, std::size_t &imax) {
+  T vmin = data[first * stride], vmax = vmin;
+  imin = imax = first;
+
+  // a leading NaN is replaced by the first value that is not NaN
+  for (std::size_t i = first + 1 ; i < last ; i++) {
+    const T value = data[i * stride];
+    if (value < vmin || vmin != vmin) {
+      vmin = value;
+      imin = i;
+    }
+    if (value > vmax || vmax != vmax) {
+      vmax = value;
+      imax = i;
+    }
+  }
+}
+
+template<typename T>
+static std::size_t find_descending_kernel(const T *data, std::size_t stride, std::size_t first, std::size_t last) {
+  for (std::size_t i = first + 1 ; i < last ; i++) {
+    if (data[i * stride] < data[(i - 1) * stride])
+      return i;
+  }
+  return last;
+}
+
+template<typename T>
+static std::size_t search_sorted_kernel(const T *data, std::size_t stride, std::size_t first, std::size_t last, double value, bool upper) {
+  while (first < last) {
+    const std::size_t middle = first + (last - first) / 2;
+    const double middle_value = data[middle * stride];
+    if (upper ? middle_value <= value : middle_value < value)
+      first = middle + 1;
+    else
+      last = middle;
+  }
+  return first;
+}
+
+PlotDataBuffer::PlotDataBuffer() :
+  sample_type(SAMPLE_DOUBLE),
+  external(nullptr),
+  view_size(0),
+  stride(1),
+  uniform_values(false),
+  uniform_start(0.0),
+  uniform_step(0.0) {}
+
+PlotDataBuffer::PlotDataBuffer(const std::vector<double> &values) :
+  PlotDataBuffer() {
+
+  owned = values;
+}
+
+PlotDataBuffer::PlotDataBuffer(std::vector<double> &&values) :
+  PlotDataBuffer() {
+
+  owned = std::move(values);
+}
+
+PlotDataBuffer::PlotDataBuffer(const std::vector<float> &values) :
+  PlotDataBuffer() {
+
+  owned_float = values;
+  sample_type = SAMPLE_FLOAT;
+}
+
+PlotDataBuffer::PlotDataBuffer(std::vector<float> &&values) :
+  PlotDataBuffer() {
+
+  owned_float = std::move(values);
+  sample_type = SAMPLE_FLOAT;
+}
+
+PlotDataBuffer::PlotDataBuffer(const std::vector<int16_t> &values) :
+  PlotDataBuffer() {
+
+  owned_int16 = values;
+  sample_type = SAMPLE_INT16;
+}
+
+PlotDataBuffer::PlotDataBuffer(std::vector<int16_t> &&values) :
+  PlotDataBuffer() {
+
+  owned_int16 = std::move(values);
+  sample_type = SAMPLE_INT16;
+}
+
+PlotDataBuffer::PlotDataBuffer(const std::vector<int32_t> &values) :
+  PlotDataBuffer() {
+
+  owned_int32 = values;
+  sample_type = SAMPLE_INT32;
+}
+
+PlotDataBuffer::PlotDataBuffer(std::vector<int32_t> &&values) :
+  PlotDataBuffer() {
+
+  owned_int32 = std::move(values);
+  sample_type = SAMPLE_INT32;
+}
+
+PlotDataBuffer::PlotDataBuffer(const std::valarray<double> &values) :
+  PlotDataBuffer() {
+
+  owned.assign(std::begin(values), std::end(values));
+}
+
+PlotDataBuffer::PlotDataBuffer(const double *data, std::size_t size, std::size_t _stride) :
+  PlotDataBuffer() {
+
+  init_view(data, SAMPLE_DOUBLE, size, _stride);
+}
+
+PlotDataBuffer::PlotDataBuffer(const float *data, std::size_t size, std::size_t _stride) :
+  PlotDataBuffer() {
+
+  init_view(data, SAMPLE_FLOAT, size, _stride);
+}
+
+PlotDataBuffer::PlotDataBuffer(const int16_t *data, std::size_t size, std::size_t _stride) :
+  PlotDataBuffer() {
+
+  init_view(data, SAMPLE_INT16, size, _stride);
+}
+
+PlotDataBuffer::PlotDataBuffer(const int32_t *data, std::size_t size, std::size_t _stride) :
+  PlotDataBuffer() {
+
+  init_view(data, SAMPLE_INT32, size, _stride);
+}
+
+PlotDataBuffer::PlotDataBuffer(std::shared_ptr<const double> data, std::size_t size, std::size_t _stride) :
+  PlotDataBuffer(data.get(), size, _stride) {
+
+  shared = data;
+}
+
+PlotDataBuffer::PlotDataBuffer(std::shared_ptr<const float> data, std::size_t size, std::size_t _stride) :
+  PlotDataBuffer(data.get(), size, _stride) {
+
+  shared = data;
+}
+
+PlotDataBuffer::PlotDataBuffer(std::shared_ptr<const int16_t> data, std::size_t size, std::size_t _stride) :
+  PlotDataBuffer(data.get(), size, _stride) {
+
+  shared = data;
+}
+
+PlotDataBuffer::PlotDataBuffer(std::shared_ptr<const int32_t> data, std::size_t size, std::size_t _stride) :
+  PlotDataBuffer(data.get(), size, _stride) {
+
+  shared = data;
+}
+
+PlotDataBuffer PlotDataBuffer::uniform(double start, double step, std::size_t size) {
+  PlotDataBuffer rv;
+  rv.uniform_values = true;
+  rv.uniform_start = start;
+  rv.uniform_step = step;
+  rv.view_size = size;
+  return rv;
+}
+
+void PlotDataBuffer::init_view(const void *data, SampleType type, std::size_t size, std::size_t _stride) {
+  if (data == nullptr) {
+    throw Exception("Gtk::PLplot::PlotDataBuffer::PlotDataBuffer -> data cannot be a null pointer");
+  }
+  if (_stride == 0) {
+    throw Exception("Gtk::PLplot::PlotDataBuffer::PlotDataBuffer -> stride must be strictly positive");
+  }
+
+  external = data;
+  sample_type = type;
+  view_size = size;
+  stride = _stride;
+}
+
+void PlotDataBuffer::ensure_owned(const char *method) {
+  if (external) {
+    throw Exception(Glib::ustring("Gtk::PLplot::PlotDataBuffer::") + method + " -> cannot modify a view on external data");
+  }
+  else if (uniform_values) {
+    owned.assign(begin(), end());
+    uniform_values = false;
+    view_size = 0;
+  }
+}
+
+const double *PlotDataBuffer::get_contiguous(std::size_t first, std::size_t n, std::vector<double> &scratch) const {
+  if (is_contiguous())
+    return (external ? static_cast<const double *>(external) : owned.data()) + first;
+
+  scratch.resize(n);
+
+  if (uniform_values) {
+    for (std::size_t i = 0 ; i < n ; i++)
+      scratch[i] = uniform_start + (first + i) * uniform_step;
+    return scratch.data();
+  }
+
+  const std::size_t step = external ? stride : 1;
+
+  switch (sample_type) {
+    case SAMPLE_FLOAT:
+      convert_samples(external ? static_cast<const float *>(external) + first * step : owned_float.data() + first, step, n, scratch.data());
+      break;
+    case SAMPLE_INT16:
+      convert_samples(external ? static_cast<const int16_t *>(external) + first * step : owned_int16.data() + first, step, n, scratch.data());
+      break;
+    case SAMPLE_INT32:
+      convert_samples(external ? static_cast<const int32_t *>(external) + first * step : owned_int32.data() + first, step, n, scratch.data());
+      break;
+    default:
+      convert_samples(static_cast<const double *>(external) + first * step, step, n, scratch.data());
+      break;
+  }
+  return scratch.data();
+}
+
+void PlotDataBuffer::for_each_chunk(std::initializer_list<const PlotDataBuffer *> buffers, std::size_t first, std::size_t last, bool connected,
+                                    const std::function<void(std::size_t, const double * const *)> &function) {
+  if (last <= first)
+    return;
+
+  const bool contiguous = std::all_of(buffers.begin(), buffers.end(), [](const PlotDataBuffer *buffer){return buffer->is_contiguous();});
+  const std::size_t chunk_size = contiguous ? last - first : GTKMM_PLPLOT_CONVERSION_CHUNK_SIZE;
+
+  std::vector<std::vector<double>> scratch(buffers.size());
+  std::vector<const double *> values(buffers.size());
+
+  for (std::size_t chunk_first = first ; ; chunk_first += connected ? chunk_size - 1 : chunk_size) {
+    const std::size_t n = std::min(chunk_size, last - chunk_first);
+    std::size_t k = 0;
+    for (auto buffer : buffers) {
+      values[k] = buffer->get_contiguous(chunk_first, n, scratch[k]);
+      k++;
+    }
+    function(n, values.data());
+
+    if (chunk_first + n >= last)
+      break;
+  }
+}
+
+void PlotDataBuffer::extend(std::size_t n) {
+  if (!uniform_values) {
+    throw Exception("Gtk::PLplot::PlotDataBuffer::extend -> only buffers with uniformly spaced values can be extended");
+  }
+  view_size += n;
+}
+
+void PlotDataBuffer::push_back(double value) {
+  ensure_owned("push_back");
+  append(&value, 1);
+}
+
+void PlotDataBuffer::append(const double *values, std::size_t n) {
+  ensure_owned("append");
+
+  switch (sample_type) {
+    case SAMPLE_FLOAT:
+      append_samples(owned_float, values, n);
+      break;
+    case SAMPLE_INT16:
+      append_samples(owned_int16, values, n);
+      break;
+    case SAMPLE_INT32:
+      append_samples(owned_int32, values, n);
+      break;
+    default:
+      owned.insert(owned.end(), values, values + n);
+      break;
+  }
+}
+
+void PlotDataBuffer::set(std::size_t i, double value) {
+  ensure_owned("set");
+
+  switch (sample_type) {
+    case SAMPLE_FLOAT:
+      owned_float[i] = sample_from_double<float>(value);
+      break;
+    case SAMPLE_INT16:
+      owned_int16[i] = sample_from_double<int16_t>(value);
+      break;
+    case SAMPLE_INT32:
+      owned_int32[i] = sample_from_double<int32_t>(value);
+      break;
+    default:
+      owned[i] = value;
+      break;
+  }
+}
+
+void PlotDataBuffer::erase_front(std::size_t n) {
+  if (uniform_values) {
+    uniform_start += n * uniform_step;
+    view_size -= n;
+    return;
+  }
+  ensure_owned("erase_front");
+
+  switch (sample_type) {
+    case SAMPLE_FLOAT:
+      owned_float.erase(owned_float.begin(), owned_float.begin() + n);
+      break;
+    case SAMPLE_INT16:
+      owned_int16.erase(owned_int16.begin(), owned_int16.begin() + n);
+      break;
+    case SAMPLE_INT32:
+      owned_int32.erase(owned_int32.begin(), owned_int32.begin() + n);
+      break;
+    default:
+      owned.erase(owned.begin(), owned.begin() + n);
+      break;
+  }
+}
+
+void PlotDataBuffer::reserve(std::size_t n) {
+  if (uniform_values)
+    return;
+  ensure_owned("reserve");
+
+  switch (sample_type) {
+    case SAMPLE_FLOAT:
+      owned_float.reserve(n);
+      break;
+    case SAMPLE_INT16:
+      owned_int16.reserve(n);
+      break;
+    case SAMPLE_INT32:
+      owned_int32.reserve(n);
+      break;
+    default:
+      owned.reserve(n);
+      break;
+  }
+}
+
+const void *PlotDataBuffer::get_data() const {
+  if (external)
+    return external;
+
+  switch (sample_type) {
+    case SAMPLE_FLOAT:
+      return owned_float.data();
+    case SAMPLE_INT16:
+      return owned_int16.data();
+    case SAMPLE_INT32:
+      return owned_int32.data();
+    default:
+      return owned.data();
+  }
+}
+
+void PlotDataBuffer::find_extremes(std::size_t first, std::size_t last, std::size_t &imin, std::size_t &imax) const {
+  // uniformly spaced values are monotonic, so their extremes are found at both ends
+  if (uniform_values) {
+    imin = uniform_step >= 0.0 ? first : last - 1;
+    imax = uniform_step >= 0.0 ? last - 1 : first;
+    return;
+  }
+
+  const std::size_t step = external ? stride : 1;
+
+  switch (sample_type) {
+    case SAMPLE_FLOAT:
+      find_extremes_kernel(static_cast<const float *>(get_data()), step, first, last, imin, imax);
+      break;
+    case SAMPLE_INT16:
+      find_extremes_kernel(static_cast<const int16_t *>(get_data()), step, first, last, imin, imax);
+      break;
+    case SAMPLE_INT32:
+      find_extremes_kernel(static_cast<const int32_t *>(get_data()), step, first, last, imin, imax);
+      break;
+    default:
+      find_extremes_kernel(static_cast<const double *>(get_data()), step, first, last, imin, imax);
+      break;
+  }
+}
+
+std::size_t PlotDataBuffer::find_descending(std::size_t first, std::size_t last) const {
+  if (uniform_values)
+    return uniform_step < 0.0 && first + 1 < last ? first + 1 : last;
+
+  const std::size_t step = external ? stride : 1;
+
+  switch (sample_type) {
+    case SAMPLE_FLOAT:
+      return find_descending_kernel(static_cast<const float *>(get_data()), step, first, last);
+    case SAMPLE_INT16:
+      return find_descending_kernel(static_cast<const int16_t *>(get_data()), step, first, last);
+    case SAMPLE_INT32:
+      return find_descending_kernel(static_cast<const int32_t *>(get_data()), step, first, last);
+    default:
+      return find_descending_kernel(static_cast<const double *>(get_data()), step, first, last);
+  }
+}
+
+std::size_t PlotDataBuffer::search_sorted(std::size_t first, std::size_t last, double value, bool upper) const {
+  if (uniform_values) {
+    if (upper)
+      return std::upper_bound(begin() + first, begin() + last, value) - begin();
+    return std::lower_bound(begin() + first, begin() + last, value) - begin();
+  }
+
+  const std::size_t step = external ? stride : 1;
+
+  switch (sample_type) {
+    case SAMPLE_FLOAT:
+      return search_sorted_kernel(static_cast<const float *>(get_data()), step, first, last, value, upper);
+    case SAMPLE_INT16:
+      return search_sorted_kernel(static_cast<const int16_t *>(get_data()), step, first, last, value, upper);
+    case SAMPLE_INT32:
+      return search_sorted_kernel(static_cast<const int32_t *>(get_data()), step, first, last, value, upper);
+    default:
+      return search_sorted_kernel(static_cast<const double *>(get_data()), step, first, last, value, upper);
+  }
+}
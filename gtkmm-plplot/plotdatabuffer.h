@@ -0,0 +1,533 @@
+/*
+Copyright (C) 2016 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GTKMM_PLPLOT_PLOTDATABUFFER_H
+#define GTKMM_PLPLOT_PLOTDATABUFFER_H
+
+#include <gtkmm-plplot/enums.h>
+#include <vector>
+#include <valarray>
+#include <memory>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+
+/// the number of values that are converted to double at a time when passing a PlotDataBuffer to PLplot
+#define GTKMM_PLPLOT_CONVERSION_CHUNK_SIZE 4096
+
+namespace Gtk {
+  namespace PLplot {
+    /** \class PlotDataBuffer plotdatabuffer.h <gtkmm-plplot/plotdatabuffer.h>
+     *  \brief a sequence of values, used by the dataset classes to store their data
+     *
+     *  A PlotDataBuffer either owns its values, which are then stored in a std::vector,
+     *  or provides a read-only view on a block of memory that is owned by someone else, such as an acquisition layer.
+     *  In the latter case, no copy of the data is made at all. Views may have a stride, making it possible to plot
+     *  for example one channel of an interleaved buffer directly.
+     *  When the external memory is modified, the owner must notify the dataset that uses the view, through its \c external_data_modified() method.
+     *  Owned buffers can be appended to, while views cannot: attempting to do so leads to an exception being thrown.
+     *  Finally, buffers created with uniform() do not store their values at all, but calculate them from a start value and a step,
+     *  which is ideal for the X-values of uniformly sampled signals. Such buffers can be grown with extend(), and are converted into
+     *  owned buffers if a value is changed or appended explicitly.
+     *
+     *  Both owned values and views may be stored as double, float, 16-bit or 32-bit integers (see SampleType), which reduces the memory
+     *  needed for large datasets coming from for example an ADC considerably. The values are converted to double only when they are read,
+     *  and by get_contiguous(), which the dataset classes call on small chunks of data at a time when drawing.
+     *  Values that are appended to or changed in an integer buffer are rounded to the nearest integer that can be represented.
+     */
+    class PlotDataBuffer {
+    public:
+      /** \class const_iterator plotdatabuffer.h <gtkmm-plplot/plotdatabuffer.h>
+       *  \brief a random access iterator over the values of a PlotDataBuffer
+       *
+       *  Since the values are not necessarily stored as double, dereferencing the iterator returns them by value.
+       */
+      class const_iterator {
+      public:
+        typedef std::random_access_iterator_tag iterator_category; ///< the iterator category
+        typedef double value_type; ///< the type of the values
+        typedef std::ptrdiff_t difference_type; ///< the type of the distance between two iterators
+        typedef const double *pointer; ///< the pointer type
+        typedef double reference; ///< the type returned by the dereference operator, which is a value since it may have been converted
+      private:
+        const PlotDataBuffer *buffer; ///< the buffer that is iterated over
+        std::ptrdiff_t index; ///< the index of the current value
+      public:
+        const_iterator() : buffer(nullptr), index(0) {} ///< default constructor
+        const_iterator(const PlotDataBuffer *_buffer, std::ptrdiff_t _index) : buffer(_buffer), index(_index) {} ///< constructor
+        double operator*() const {return (*buffer)[index];} ///< dereference operator
+        double operator[](std::ptrdiff_t n) const {return (*buffer)[index + n];} ///< subscript operator
+        const_iterator &operator++() {index++; return *this;} ///< prefix increment
+        const_iterator operator++(int) {const_iterator rv(*this); index++; return rv;} ///< postfix increment
+        const_iterator &operator--() {index--; return *this;} ///< prefix decrement
+        const_iterator operator--(int) {const_iterator rv(*this); index--; return rv;} ///< postfix decrement
+        const_iterator &operator+=(std::ptrdiff_t n) {index += n; return *this;} ///< compound addition
+        const_iterator &operator-=(std::ptrdiff_t n) {index -= n; return *this;} ///< compound subtraction
+        const_iterator operator+(std::ptrdiff_t n) const {return const_iterator(buffer, index + n);} ///< addition
+        const_iterator operator-(std::ptrdiff_t n) const {return const_iterator(buffer, index - n);} ///< subtraction
+        std::ptrdiff_t operator-(const const_iterator &other) const {return index - other.index;} ///< difference
+        bool operator==(const const_iterator &other) const {return index == other.index;} ///< equality
+        bool operator!=(const const_iterator &other) const {return index != other.index;} ///< inequality
+        bool operator<(const const_iterator &other) const {return index < other.index;} ///< less than
+        bool operator>(const const_iterator &other) const {return index > other.index;} ///< greater than
+        bool operator<=(const const_iterator &other) const {return index <= other.index;} ///< less than or equal
+        bool operator>=(const const_iterator &other) const {return index >= other.index;} ///< greater than or equal
+      };
+    private:
+      std::vector<double> owned; ///< the values, if owned by the buffer and stored as double
+      std::vector<float> owned_float; ///< the values, if owned by the buffer and stored as float
+      std::vector<int16_t> owned_int16; ///< the values, if owned by the buffer and stored as 16-bit integers
+      std::vector<int32_t> owned_int32; ///< the values, if owned by the buffer and stored as 32-bit integers
+      SampleType sample_type; ///< the type in which the values are stored
+      std::shared_ptr<const void> shared; ///< keeps the external memory alive, if the view was constructed from a std::shared_ptr
+      const void *external; ///< the first value of the external memory, or \c nullptr if the values are not stored externally
+      std::size_t view_size; ///< the number of values, if they are not owned by the buffer
+      std::size_t stride; ///< the distance between consecutive values in the external memory
+      bool uniform_values; ///< \c true if the values are calculated from \c uniform_start and \c uniform_step instead of being stored
+      double uniform_start; ///< the first value, if \c uniform_values is \c true
+      double uniform_step; ///< the difference between consecutive values, if \c uniform_values is \c true
+
+      /** Turn the buffer into a read-only view on external memory
+       *
+       * \param data pointer to the first value
+       * \param type the type of the values
+       * \param size the number of values
+       * \param stride the distance (in number of values) between consecutive values
+       * \exception Gtk::PLplot::Exception
+       */
+      void init_view(const void *data, SampleType type, std::size_t size, std::size_t stride);
+
+      /** Ensure that the values are owned by the buffer, before they are modified
+       *
+       * Calculated values are converted into owned ones, while for views on external memory an exception is thrown.
+       * \param method the name of the method that attempted to modify the values
+       * \exception Gtk::PLplot::Exception
+       */
+      void ensure_owned(const char *method);
+
+      /** Get a pointer to the first stored value
+       *
+       * Loops over many values use this pointer, after looking up how the values are stored once, instead of operator[].
+       * \return a pointer to the external memory or to the owned values, of the type given by \c sample_type
+       */
+      const void *get_data() const;
+
+      /** Get a value from the external memory
+       *
+       * \param i the index of the value in the external memory, taking the stride into account
+       * \return the value
+       */
+      double get_external(std::size_t i) const {
+        switch (sample_type) {
+          case SAMPLE_FLOAT:
+            return static_cast<const float *>(external)[i];
+          case SAMPLE_INT16:
+            return static_cast<const int16_t *>(external)[i];
+          case SAMPLE_INT32:
+            return static_cast<const int32_t *>(external)[i];
+          default:
+            return static_cast<const double *>(external)[i];
+        }
+      }
+    public:
+      /** Constructor
+       *
+       * Creates an empty buffer that owns its values
+       */
+      PlotDataBuffer();
+
+      /** Constructor
+       *
+       * Creates a buffer that owns a copy of \c values
+       * \param values the values, as std::vector
+       */
+      PlotDataBuffer(const std::vector<double> &values);
+
+      /** Constructor
+       *
+       * Creates a buffer that takes over the contents of \c values, without copying them
+       * \param values the values, as std::vector
+       */
+      PlotDataBuffer(std::vector<double> &&values);
+
+      /** Constructor
+       *
+       * Creates a buffer that owns a copy of \c values, stored as float
+       * \param values the values, as std::vector
+       */
+      PlotDataBuffer(const std::vector<float> &values);
+
+      /** Constructor
+       *
+       * Creates a buffer that takes over the contents of \c values, without copying them, stored as float
+       * \param values the values, as std::vector
+       */
+      PlotDataBuffer(std::vector<float> &&values);
+
+      /** Constructor
+       *
+       * Creates a buffer that owns a copy of \c values, stored as 16-bit integers
+       * \param values the values, as std::vector
+       */
+      PlotDataBuffer(const std::vector<int16_t> &values);
+
+      /** Constructor
+       *
+       * Creates a buffer that takes over the contents of \c values, without copying them, stored as 16-bit integers
+       * \param values the values, as std::vector
+       */
+      PlotDataBuffer(std::vector<int16_t> &&values);
+
+      /** Constructor
+       *
+       * Creates a buffer that owns a copy of \c values, stored as 32-bit integers
+       * \param values the values, as std::vector
+       */
+      PlotDataBuffer(const std::vector<int32_t> &values);
+
+      /** Constructor
+       *
+       * Creates a buffer that takes over the contents of \c values, without copying them, stored as 32-bit integers
+       * \param values the values, as std::vector
+       */
+      PlotDataBuffer(std::vector<int32_t> &&values);
+
+      /** Constructor
+       *
+       * Creates a buffer that owns a copy of \c values
+       * \param values the values, as std::valarray
+       */
+      PlotDataBuffer(const std::valarray<double> &values);
+
+      /** Constructor
+       *
+       * Creates a read-only view on external memory. The memory must remain valid for as long as the buffer is in use.
+       * \param data pointer to the first value
+       * \param size the number of values
+       * \param stride the distance (in number of doubles) between consecutive values
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotDataBuffer(const double *data, std::size_t size, std::size_t stride = 1);
+
+      /** Constructor
+       *
+       * Creates a read-only view on external memory holding floats. The memory must remain valid for as long as the buffer is in use.
+       * \param data pointer to the first value
+       * \param size the number of values
+       * \param stride the distance (in number of floats) between consecutive values
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotDataBuffer(const float *data, std::size_t size, std::size_t stride = 1);
+
+      /** Constructor
+       *
+       * Creates a read-only view on external memory holding 16-bit integers. The memory must remain valid for as long as the buffer is in use.
+       * \param data pointer to the first value
+       * \param size the number of values
+       * \param stride the distance (in number of integers) between consecutive values
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotDataBuffer(const int16_t *data, std::size_t size, std::size_t stride = 1);
+
+      /** Constructor
+       *
+       * Creates a read-only view on external memory holding 32-bit integers. The memory must remain valid for as long as the buffer is in use.
+       * \param data pointer to the first value
+       * \param size the number of values
+       * \param stride the distance (in number of integers) between consecutive values
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotDataBuffer(const int32_t *data, std::size_t size, std::size_t stride = 1);
+
+      /** Constructor
+       *
+       * Creates a read-only view on external memory, which will be kept alive by holding on to a copy of \c data.
+       * \param data shared pointer to the first value
+       * \param size the number of values
+       * \param stride the distance (in number of doubles) between consecutive values
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotDataBuffer(std::shared_ptr<const double> data, std::size_t size, std::size_t stride = 1);
+
+      /** Constructor
+       *
+       * Creates a read-only view on external memory holding floats, which will be kept alive by holding on to a copy of \c data.
+       * \param data shared pointer to the first value
+       * \param size the number of values
+       * \param stride the distance (in number of floats) between consecutive values
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotDataBuffer(std::shared_ptr<const float> data, std::size_t size, std::size_t stride = 1);
+
+      /** Constructor
+       *
+       * Creates a read-only view on external memory holding 16-bit integers, which will be kept alive by holding on to a copy of \c data.
+       * \param data shared pointer to the first value
+       * \param size the number of values
+       * \param stride the distance (in number of integers) between consecutive values
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotDataBuffer(std::shared_ptr<const int16_t> data, std::size_t size, std::size_t stride = 1);
+
+      /** Constructor
+       *
+       * Creates a read-only view on external memory holding 32-bit integers, which will be kept alive by holding on to a copy of \c data.
+       * \param data shared pointer to the first value
+       * \param size the number of values
+       * \param stride the distance (in number of integers) between consecutive values
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotDataBuffer(std::shared_ptr<const int32_t> data, std::size_t size, std::size_t stride = 1);
+
+      /** Create a buffer with uniformly spaced values
+       *
+       * The values are not stored, but calculated when needed as \c start + \c i * \c step.
+       * \param start the first value
+       * \param step the difference between consecutive values
+       * \param size the number of values
+       * \return the new buffer
+       */
+      static PlotDataBuffer uniform(double start, double step, std::size_t size);
+
+      /** Get a value
+       *
+       * \param i the index of the value
+       * \return the value
+       */
+      double operator[](std::size_t i) const {
+        if (external)
+          return get_external(i * stride);
+        else if (uniform_values)
+          return uniform_start + i * uniform_step;
+
+        switch (sample_type) {
+          case SAMPLE_FLOAT:
+            return owned_float[i];
+          case SAMPLE_INT16:
+            return owned_int16[i];
+          case SAMPLE_INT32:
+            return owned_int32[i];
+          default:
+            return owned[i];
+        }
+      }
+
+      /**
+       *
+       * \return the number of values
+       */
+      std::size_t size() const {
+        if (!is_owned())
+          return view_size;
+
+        switch (sample_type) {
+          case SAMPLE_FLOAT:
+            return owned_float.size();
+          case SAMPLE_INT16:
+            return owned_int16.size();
+          case SAMPLE_INT32:
+            return owned_int32.size();
+          default:
+            return owned.size();
+        }
+      }
+
+      /**
+       *
+       * \return \c true if the buffer contains no values
+       */
+      bool empty() const {
+        return size() == 0;
+      }
+
+      /**
+       *
+       * \return the last value
+       */
+      double back() const {
+        return (*this)[size() - 1];
+      }
+
+      /**
+       *
+       * \return an iterator to the first value
+       */
+      const_iterator begin() const {
+        return const_iterator(this, 0);
+      }
+
+      /**
+       *
+       * \return an iterator past the last value
+       */
+      const_iterator end() const {
+        return const_iterator(this, size());
+      }
+
+      /**
+       *
+       * \return \c true if the values are stored in the buffer, \c false if it is a view on external memory or if its values are calculated
+       */
+      bool is_owned() const {
+        return external == nullptr && !uniform_values;
+      }
+
+      /**
+       *
+       * \return \c true if the values are calculated from a start value and a step, as is the case for buffers created with uniform()
+       */
+      bool is_uniform() const {
+        return uniform_values;
+      }
+
+      /**
+       *
+       * \return the first value, if is_uniform() returns \c true
+       */
+      double get_uniform_start() const {
+        return uniform_start;
+      }
+
+      /**
+       *
+       * \return the difference between consecutive values, if is_uniform() returns \c true
+       */
+      double get_uniform_step() const {
+        return uniform_step;
+      }
+
+      /**
+       *
+       * \return the type in which the values are stored
+       */
+      SampleType get_sample_type() const {
+        return sample_type;
+      }
+
+      /**
+       *
+       * \return \c true if the values are stored as contiguous doubles, in which case get_contiguous() never needs to copy them
+       */
+      bool is_contiguous() const {
+        return sample_type == SAMPLE_DOUBLE && !uniform_values && (external == nullptr || stride == 1);
+      }
+
+      /** Get a pointer to \c n contiguous values, starting at index \c first
+       *
+       * If the values are stored as contiguous doubles, a pointer into the buffer is returned,
+       * otherwise the values are converted to double and copied into \c scratch.
+       * \param first the index of the first value
+       * \param n the number of values
+       * \param scratch storage for the values, if a copy needs to be made
+       * \return a pointer to the values
+       */
+      const double *get_contiguous(std::size_t first, std::size_t n, std::vector<double> &scratch) const;
+
+      /** Pass the values in [\c first, \c last) of several buffers of the same size to a function, as arrays of contiguous doubles
+       *
+       * If all buffers store contiguous doubles, the function is called once, with pointers into the buffers.
+       * Otherwise the values are converted in chunks of GTKMM_PLPLOT_CONVERSION_CHUNK_SIZE, keeping the scratch buffers small.
+       * \param buffers the buffers
+       * \param first the index of the first value
+       * \param last one past the index of the last value
+       * \param connected \c true if consecutive chunks must share a value, to ensure that no segments of a polyline are lost
+       * \param function the function, which receives the number of values of the chunk, and a pointer to the values of each buffer, in the order of \c buffers
+       */
+      static void for_each_chunk(std::initializer_list<const PlotDataBuffer *> buffers, std::size_t first, std::size_t last, bool connected,
+                                 const std::function<void(std::size_t, const double * const *)> &function);
+
+      /** Find the smallest and the largest of the values in [\c first, \c last)
+       *
+       * How the values are stored is looked up only once, which makes this method considerably faster than a loop over operator[].
+       * Both indices refer to the first occurrence of the extreme value. NaN values are ignored, unless all values are NaN.
+       * \param first the index of the first value
+       * \param last one past the index of the last value, which must be greater than \c first
+       * \param imin the index of the smallest value
+       * \param imax the index of the largest value
+       */
+      void find_extremes(std::size_t first, std::size_t last, std::size_t &imin, std::size_t &imax) const;
+
+      /** Find the first value in (\c first, \c last) that is smaller than the value before it
+       *
+       * \param first the index of the first value
+       * \param last one past the index of the last value
+       * \return the index of that value, or \c last if the values are sorted in ascending order
+       */
+      std::size_t find_descending(std::size_t first, std::size_t last) const;
+
+      /** Find the position of a value in [\c first, \c last), which must be sorted in ascending order
+       *
+       * \param first the index of the first value
+       * \param last one past the index of the last value
+       * \param value the value to look for
+       * \param upper \c false to look for the first value that is not less than \c value, as std::lower_bound() does,
+       * \c true to look for the first value that is greater than \c value, as std::upper_bound() does
+       * \return the index of the value that was found, or \c last if there is none
+       */
+      std::size_t search_sorted(std::size_t first, std::size_t last, double value, bool upper) const;
+
+      /** Append \c n values that continue the uniformly spaced sequence
+       *
+       * Only buffers whose values are calculated can be extended this way.
+       * \param n the number of values
+       * \exception Gtk::PLplot::Exception
+       */
+      void extend(std::size_t n);
+
+      /** Append a value
+       *
+       * \param value the value
+       * \exception Gtk::PLplot::Exception
+       */
+      void push_back(double value);
+
+      /** Append several values
+       *
+       * \param values pointer to the values
+       * \param n the number of values
+       * \exception Gtk::PLplot::Exception
+       */
+      void append(const double *values, std::size_t n);
+
+      /** Change a value
+       *
+       * \param i the index of the value
+       * \param value the new value
+       * \exception Gtk::PLplot::Exception
+       */
+      void set(std::size_t i, double value);
+
+      /** Remove the first \c n values
+       *
+       * \param n the number of values to remove
+       * \exception Gtk::PLplot::Exception
+       */
+      void erase_front(std::size_t n);
+
+      /** Reserve room for \c n values
+       *
+       * \param n the number of values
+       * \exception Gtk::PLplot::Exception
+       */
+      void reserve(std::size_t n);
+    };
+  }
+}
+
+#endif
@@ -47,7 +47,7 @@ void PlotDataHistogram::set_expand_bins(bool _expand_bins) {
   if (_expand_bins == expand_bins)
     return;
   expand_bins = _expand_bins;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 bool PlotDataHistogram::get_expand_bins() {
@@ -58,7 +58,7 @@ void PlotDataHistogram::set_empty_bins(bool _empty_bins) {
   if (_empty_bins == empty_bins)
     return;
   empty_bins = _empty_bins;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 bool PlotDataHistogram::get_empty_bins() {
@@ -24,7 +24,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 using namespace Gtk::PLplot;
 
 double PlotDataHistogramBinned::get_new_datmin(
-  std::vector<double> data_x,
+  const std::vector<double> &data_x,
   bool centred) {
 
   if (!centred) {
@@ -35,7 +35,7 @@ double PlotDataHistogramBinned::get_new_datmin(
 }
 
 double PlotDataHistogramBinned::get_new_datmax(
-  std::vector<double> data_x,
+  const std::vector<double> &data_x,
   bool centred) {
 
   if (!centred) {
@@ -46,31 +46,40 @@ double PlotDataHistogramBinned::get_new_datmax(
 }
 
 PlotDataHistogramBinned::PlotDataHistogramBinned(
-  const std::vector<double> &_data_x,
-  const std::vector<double> &_data_y,
+  std::vector<double> &&_data_x,
+  std::vector<double> &&_data_y,
   bool _centred) :
   Glib::ObjectBase("GtkmmPlplotPlotDataHistogramBinned"),
   PlotDataHistogram(get_new_datmin(_data_x, _centred), get_new_datmax(_data_x, _centred), _data_x.size()),
-  data_x(_data_x),
-  data_y(_data_y),
+  data_x(std::move(_data_x)),
+  data_y(std::move(_data_y)),
   centred(_centred) {
 
   // arg sanity check
-  if (_data_x.size() < 3)
+  if (data_x.size() < 3)
     throw Exception("PlotDataHistogramBinned::PlotDataHistogramBinned -> data_x must contain at least three elements");
 
-  if (_data_x.size() != _data_y.size())
+  if (data_x.size() != data_y.size())
     throw Exception("PlotDataHistogramBinned::PlotDataHistogramBinned -> data_x and data_y must have the same size");
 
-  for (size_t i = 0 ; i < _data_x.size()-1 ; i++)
-    if (_data_x[i] >= _data_x[i+1])
+  for (size_t i = 0 ; i < data_x.size()-1 ; i++)
+    if (data_x[i] >= data_x[i+1])
       throw Exception("PlotDataHistogramBinned::PlotDataHistogramBinned -> data_x must be monotonic increasing");
 
-  if (std::count_if(_data_y.begin(), _data_y.end(), [](double y)->bool{return y < 0.0;}) > 0)
+  if (std::count_if(data_y.begin(), data_y.end(), [](double y)->bool{return y < 0.0;}) > 0)
     throw Exception("PlotDataHistogramBinned::PlotDataHistogramBinned -> data_y values must be greater than or equal to zero");
 
 }
 
+PlotDataHistogramBinned::PlotDataHistogramBinned(
+  const std::vector<double> &_data_x,
+  const std::vector<double> &_data_y,
+  bool _centred) :
+  PlotDataHistogramBinned(
+    std::vector<double>(_data_x),
+    std::vector<double>(_data_y),
+    _centred) {}
+
 PlotDataHistogramBinned::PlotDataHistogramBinned(
   const std::valarray<double> &_data_x,
   const std::valarray<double> &_data_y,
@@ -88,7 +97,7 @@ void PlotDataHistogramBinned::set_centred(bool _centred) {
   centred = _centred;
   datmin = get_new_datmin(data_x, centred);
   datmax = get_new_datmax(data_x, centred);
-  _signal_data_modified.emit();
+  notify_data_modified();
 }
 
 bool PlotDataHistogramBinned::get_centred() {
@@ -44,8 +44,8 @@ namespace Gtk {
       std::vector<double> data_x; ///< bin X-values, must be monotonicly increasing!
       std::vector<double> data_y; ///< bin Y-values (heights)
       bool centred; ///< if \c true, yhe bin boundaries are to be midway between the \c data_x values. If the values in \c data_x are equally spaced, the values are the center values of the bins.
-      static double get_new_datmin(std::vector<double> data_x, bool centred); ///< static method to calculate the data minumum
-      static double get_new_datmax(std::vector<double> data_x, bool centred); ///< static method to calculate the data maximum
+      static double get_new_datmin(const std::vector<double> &data_x, bool centred); ///< static method to calculate the data minumum
+      static double get_new_datmax(const std::vector<double> &data_x, bool centred); ///< static method to calculate the data maximum
     public:
       /** Constructor
        *
@@ -59,6 +59,19 @@ namespace Gtk {
                               const std::vector<double> &data_y,
                               bool centred = false);
 
+      /** Constructor
+       *
+       * This constructor initializes a new dataset for a PlotHistogram from binned data.
+       * The contents of \c data_x and \c data_y are moved into the dataset instead of being copied, leaving them empty.
+       * \param data_x the X-values of the bins, as std::vector
+       * \param data_y the Y-values of the bins, as std::vector
+       * \param centred if \c true, yhe bin boundaries are to be midway between the \c data_x values. If the values in \c data_x are equally spaced, the values are the center values of the bins.
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotDataHistogramBinned(std::vector<double> &&data_x,
+                              std::vector<double> &&data_y,
+                              bool centred = false);
+
       /** Constructor
        *
        * This constructor initializes a new dataset for a PlotHistogram from binned data.
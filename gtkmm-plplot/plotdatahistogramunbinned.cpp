@@ -24,7 +24,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 using namespace Gtk::PLplot;
 
 PlotDataHistogramUnbinned::PlotDataHistogramUnbinned(
-  const std::vector<double> &_data,
+  std::vector<double> &&_data,
   double _datmin,
   double _datmax,
   int _nbins) :
@@ -32,12 +32,23 @@ PlotDataHistogramUnbinned::PlotDataHistogramUnbinned(
   PlotDataHistogram(_datmin, _datmax, _nbins),
   x(nullptr),
   y(nullptr),
-  data(_data),
+  data(std::move(_data)),
   ignore_outliers(false) {
 
   rebin();
 }
 
+PlotDataHistogramUnbinned::PlotDataHistogramUnbinned(
+  const std::vector<double> &_data,
+  double _datmin,
+  double _datmax,
+  int _nbins) :
+  PlotDataHistogramUnbinned(
+    std::vector<double>(_data),
+    _datmin,
+    _datmax,
+    _nbins) {}
+
 PlotDataHistogramUnbinned::PlotDataHistogramUnbinned(
   const std::valarray<double> &_data,
   double _datmin,
@@ -59,7 +70,27 @@ PlotDataHistogramUnbinned::~PlotDataHistogramUnbinned() {
 void PlotDataHistogramUnbinned::add_datapoint(double value) {
   data.push_back(value);
   rebin();
-  _signal_data_modified.emit();
+  notify_data_modified();
+}
+
+void PlotDataHistogramUnbinned::add_datapoints(const double *values, std::size_t n) {
+  if (n == 0)
+    return;
+
+  data.insert(data.end(), values, values + n);
+  rebin();
+  notify_data_modified();
+}
+
+void PlotDataHistogramUnbinned::add_datapoints(const std::vector<double> &values) {
+  add_datapoints(values.data(), values.size());
+}
+
+void PlotDataHistogramUnbinned::add_datapoints(const std::valarray<double> &values) {
+  if (values.size() == 0)
+    return;
+
+  add_datapoints(&values[0], values.size());
 }
 
 void PlotDataHistogramUnbinned::set_data_minimum(double _datmin) {
@@ -70,7 +101,7 @@ void PlotDataHistogramUnbinned::set_data_minimum(double _datmin) {
 
   datmin = _datmin;
   rebin();
-  _signal_data_modified.emit();
+  notify_data_modified();
 }
 
 void PlotDataHistogramUnbinned::set_data_maximum(double _datmax) {
@@ -81,7 +112,7 @@ void PlotDataHistogramUnbinned::set_data_maximum(double _datmax) {
 
   datmax = _datmax;
   rebin();
-  _signal_data_modified.emit();
+  notify_data_modified();
 }
 
 void PlotDataHistogramUnbinned::set_nbins(int _nbins) {
@@ -92,7 +123,7 @@ void PlotDataHistogramUnbinned::set_nbins(int _nbins) {
 
   nbins = _nbins;
   rebin();
-  _signal_data_modified.emit();
+  notify_data_modified();
 }
 
 bool PlotDataHistogramUnbinned::get_ignore_outliers() {
@@ -104,7 +135,7 @@ void PlotDataHistogramUnbinned::set_ignore_outliers(bool _ignore_outliers) {
     return;
   ignore_outliers = _ignore_outliers;
   rebin();
-  _signal_data_modified.emit();
+  notify_data_modified();
 }
 
 void PlotDataHistogramUnbinned::rebin() {
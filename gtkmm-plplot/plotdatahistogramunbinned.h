@@ -61,6 +61,21 @@ namespace Gtk {
                                 double datmax,
                                 int nbins);
 
+      /** Constructor
+       *
+       * This constructor initializes a new dataset for a PlotHistogram from unbinned data.
+       * The contents of \c data are moved into the dataset instead of being copied, leaving it empty.
+       * \param data the unbinned data, as std::vector
+       * \param datmin left-hand edge of the lowest-valued bin
+       * \param datmax right-hand edge of the highest-valued bin
+       * \param nbins number of bins into which to divide the data (minimum = 3)
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotDataHistogramUnbinned(std::vector<double> &&data,
+                                double datmin,
+                                double datmax,
+                                int nbins);
+
       /** Constructor
        *
        * This constructor initializes a new dataset for a PlotHistogram from unbinned data.
@@ -88,6 +103,31 @@ namespace Gtk {
        */
       virtual void add_datapoint(double value);
 
+      /** Add several datapoints to the unbinned data
+       *
+       * Contrary to calling add_datapoint() repeatedly, the bins will be recalculated only once,
+       * after all values have been added.
+       * \param values pointer to \c n new values
+       * \param n the number of values to add
+       */
+      virtual void add_datapoints(const double *values, std::size_t n);
+
+      /** Add several datapoints to the unbinned data
+       *
+       * Contrary to calling add_datapoint() repeatedly, the bins will be recalculated only once,
+       * after all values have been added.
+       * \param values the new values, as std::vector
+       */
+      void add_datapoints(const std::vector<double> &values);
+
+      /** Add several datapoints to the unbinned data
+       *
+       * Contrary to calling add_datapoint() repeatedly, the bins will be recalculated only once,
+       * after all values have been added.
+       * \param values the new values, as std::valarray
+       */
+      void add_datapoints(const std::valarray<double> &values);
+
       /** Sets the left-hand edge of the lowest-valued bin
        *
        * This value must be less than the right-hand edge of the highest-valued bin (obtained using get_data_maximum())
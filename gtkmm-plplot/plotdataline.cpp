@@ -38,7 +38,7 @@ void PlotDataLine::set_color(Gdk::RGBA _color) {
   if (color == _color)
     return;
   color = _color;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 Gdk::RGBA PlotDataLine::get_color() {
@@ -49,7 +49,7 @@ void PlotDataLine::set_line_style(LineStyle _line_style) {
   if (line_style == _line_style)
     return;
   line_style = _line_style;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 LineStyle PlotDataLine::get_line_style() {
@@ -62,7 +62,7 @@ void PlotDataLine::set_line_width(double _line_width) {
   if (_line_width <= 0.0)
     throw Exception("Gtk::PLplot::PlotDataLine::set_line_width -> line_width must be strictly positive");
   line_width = _line_width;
-  _signal_changed.emit();
+  notify_changed();
 }
 
 double PlotDataLine::get_line_width() {
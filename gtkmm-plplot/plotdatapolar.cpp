@@ -22,15 +22,24 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 using namespace Gtk::PLplot;
 
 PlotDataPolar::PlotDataPolar(
-  const std::vector<double> &_x,
-  const std::vector<double> &_y,
+  std::vector<double> &&_x,
+  std::vector<double> &&_y,
   Gdk::RGBA _color,
   LineStyle _line_style,
   double _line_width) :
   Glib::ObjectBase("GtkmmPLplotPlotDataPolar"),
-  PlotData2D(_x, _y, _color, _line_style, _line_width) {
+  PlotData2D(std::move(_x), std::move(_y), _color, _line_style, _line_width) {
 }
 
+PlotDataPolar::PlotDataPolar(
+  const std::vector<double> &_x,
+  const std::vector<double> &_y,
+  Gdk::RGBA _color,
+  LineStyle _line_style,
+  double _line_width) :
+  PlotDataPolar(std::vector<double>(_x), std::vector<double>(_y),
+  _color, _line_style, _line_width) {}
+
 PlotDataPolar::PlotDataPolar(
   const std::valarray<double> &_x,
   const std::valarray<double> &_y,
@@ -44,13 +53,21 @@ PlotDataPolar::PlotDataPolar(
 PlotDataPolar::~PlotDataPolar() {}
 
 std::vector<double> PlotDataPolar::get_vector_r() {
-  return x;
+  return std::vector<double>(x.begin(), x.end());
 }
 
 std::vector<double> PlotDataPolar::get_vector_theta() {
+  return std::vector<double>(y.begin(), y.end());
+}
+
+const PlotDataBuffer &PlotDataPolar::get_data_r() const {
+  return x;
+}
+
+const PlotDataBuffer &PlotDataPolar::get_data_theta() const {
   return y;
 }
 
 void PlotDataPolar::get_max_r(double &rmax) {
-  rmax = *std::max_element(x.begin(), x.end());
+  rmax = extremes_x[1];
 }
@@ -63,6 +63,24 @@ namespace Gtk {
                     LineStyle line_style = CONTINUOUS,
                     double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
 
+      /** Constructor
+       *
+       * This constructor initializes a new dataset using two vectors, one for the R-values, and one for the θ-values.
+       * The contents of both vectors are moved into the dataset instead of being copied, leaving them empty.
+       * Optionally, one can also use the constructor to override the default color, line style and line width.
+       * \param R the R-values, as std::vector
+       * \param theta the θ-values, as std::vector
+       * \param color the line color, default is red
+       * \param line_style the line style, default is CONTINUOUS
+       * \param line_width the line width, default is 1.0
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotDataPolar(std::vector<double> &&R,
+                    std::vector<double> &&theta,
+                    Gdk::RGBA color = Gdk::RGBA("red"),
+                    LineStyle line_style = CONTINUOUS,
+                    double line_width = PLOTDATA_DEFAULT_LINE_WIDTH);
+
       /** Constructor
        *
        * This constructor initializes a new dataset using two valarrays, one for the R-values, and one for the θ-values.
@@ -96,6 +114,18 @@ namespace Gtk {
        */
       std::vector<double> get_vector_theta();
 
+      /** Get read-only access to the R-values, without copying them
+       *
+       * \returns a reference to the dataset R-values
+       */
+      const PlotDataBuffer &get_data_r() const;
+
+      /** Get read-only access to the θ-values, without copying them
+       *
+       * \returns a reference to the dataset θ-values
+       */
+      const PlotDataBuffer &get_data_theta() const;
+
       /** Get the R-data maximum
        *
        * \param rmax R maximum value
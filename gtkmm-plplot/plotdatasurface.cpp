@@ -20,6 +20,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <gtkmm-plplot/utils.h>
 #include <algorithm>
 #include <iostream>
+#include <cmath>
+#include <limits>
 #include <plConfig.h>
 
 #ifdef GTKMM_PLPLOT_PLPLOT_5_11_0
@@ -31,34 +33,134 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 using namespace Gtk::PLplot;
 
+//copy an array of arrays into a single contiguous block
+static std::vector<double> array2d_to_vector(double **_z, std::size_t nx, std::size_t ny) {
+  if (_z == nullptr) {
+    throw Exception("Gtk::PLplot::PlotDataSurface::PlotDataSurface -> z cannot be a null pointer");
+  }
+
+  std::vector<double> rv(nx * ny);
+  //this could easily segfault if bad input was provided
+  for (std::size_t i = 0 ; i < nx ; i++)
+    std::copy(_z[i], _z[i] + ny, rv.begin() + i * ny);
+  return rv;
+}
+
 PlotDataSurface::PlotDataSurface(
   const std::vector<double> &_x,
   const std::vector<double> &_y,
-  double **_z) :
+  std::vector<double> &&_z) :
 	Glib::ObjectBase("GtkmmPLplotPlotDataSurface"),
   PlotData(),
-  x(_x), y(_y)
+  x(_x), y(_y), z(std::move(_z)),
+  z_gathered_valid(false),
+  external(nullptr), row_stride(0), column_stride(0),
+  modified_region{0, 0, _x.size(), _y.size()},
+  extremes_z_valid(false),
+  pyramid_reduction(PYRAMID_MEAN),
+  pyramid_dirty{0, 0, 0, 0}
   {
-    //do some checks
-    //ensure there are at least two elements in the arrays
-    if (x.size() < 2 || y.size() < 2) {
-      throw Exception("Gtk::PLplot::PlotDataSurface::PlotDataSurface -> data arrays x and y must have at least two elements");
+    check_grid();
+
+    if (z.size() != x.size() * y.size()) {
+      throw Exception("Gtk::PLplot::PlotDataSurface::PlotDataSurface -> the number of elements of z does not match the dimensions of x and y");
     }
 
-    //ensure x and y are sorted in ascending order
-    if (!std::is_sorted(x.begin(), x.end(), std::less_equal<double>())) {
-      throw Exception("Gtk::PLplot::PlotDataSurface::PlotDataSurface -> data arrays x must consist of unique elements and be sorted in ascending order");
+    build_row_table();
+}
+
+PlotDataSurface::PlotDataSurface(
+  const std::vector<double> &_x,
+  const std::vector<double> &_y,
+  const double *_z,
+  std::size_t _row_stride,
+  std::size_t _column_stride) :
+	Glib::ObjectBase("GtkmmPLplotPlotDataSurface"),
+  PlotData(),
+  x(_x), y(_y),
+  z_gathered_valid(false),
+  external(_z), row_stride(_row_stride), column_stride(_column_stride),
+  modified_region{0, 0, _x.size(), _y.size()},
+  extremes_z_valid(false),
+  pyramid_reduction(PYRAMID_MEAN),
+  pyramid_dirty{0, 0, 0, 0}
+  {
+    check_grid();
+
+    if (external == nullptr) {
+      throw Exception("Gtk::PLplot::PlotDataSurface::PlotDataSurface -> z cannot be a null pointer");
     }
 
-    if (!std::is_sorted(y.begin(), y.end(), std::less_equal<double>())) {
-      throw Exception("Gtk::PLplot::PlotDataSurface::PlotDataSurface -> data arrays y must consist of unique elements and be sorted in ascending order");
+    if (row_stride == 0 || column_stride == 0) {
+      throw Exception("Gtk::PLplot::PlotDataSurface::PlotDataSurface -> strides must be strictly positive");
     }
 
-    //allocate memory for z. This could easily segfault if bad input was provided
-		if (_z)
-    	z = deep_copy_array2d(_z, x.size(), y.size());
+    build_row_table();
+}
+
+PlotDataSurface::PlotDataSurface(
+  const std::vector<double> &_x,
+  const std::vector<double> &_y,
+  std::shared_ptr<const double> _z,
+  std::size_t _row_stride,
+  std::size_t _column_stride) :
+  PlotDataSurface(_x, _y, _z.get(), _row_stride, _column_stride) {
+
+  shared = _z;
+}
+
+PlotDataSurface::PlotDataSurface(
+  unsigned int nx,
+  unsigned int ny,
+  const double *_z,
+  std::size_t _row_stride,
+  std::size_t _column_stride) :
+  PlotDataSurface(std::vector<double>(indgen(nx)),
+  std::vector<double>(indgen(ny)),
+  _z, _row_stride, _column_stride) {}
+
+void PlotDataSurface::check_grid() {
+  //ensure there are at least two elements in the arrays
+  if (x.size() < 2 || y.size() < 2) {
+    throw Exception("Gtk::PLplot::PlotDataSurface::PlotDataSurface -> data arrays x and y must have at least two elements");
+  }
+
+  //ensure x and y are sorted in ascending order
+  if (!std::is_sorted(x.begin(), x.end(), std::less_equal<double>())) {
+    throw Exception("Gtk::PLplot::PlotDataSurface::PlotDataSurface -> data arrays x must consist of unique elements and be sorted in ascending order");
+  }
+
+  if (!std::is_sorted(y.begin(), y.end(), std::less_equal<double>())) {
+    throw Exception("Gtk::PLplot::PlotDataSurface::PlotDataSurface -> data arrays y must consist of unique elements and be sorted in ascending order");
+  }
 }
 
+void PlotDataSurface::build_row_table() {
+  z_rows.resize(x.size());
+
+  //the rows of an external buffer are read in place, whatever the distance between their elements
+  if (external) {
+    for (std::size_t i = 0 ; i < x.size() ; i++)
+      z_rows[i] = external + i * row_stride;
+    return;
+  }
+
+  for (std::size_t i = 0 ; i < x.size() ; i++)
+    z_rows[i] = z.data() + i * y.size();
+}
+
+PlotDataSurface::PlotDataSurface(
+  const std::vector<double> &_x,
+  const std::vector<double> &_y,
+  const std::vector<double> &_z) :
+  PlotDataSurface(_x, _y, std::vector<double>(_z)) {}
+
+PlotDataSurface::PlotDataSurface(
+  const std::vector<double> &_x,
+  const std::vector<double> &_y,
+  double **_z) :
+  PlotDataSurface(_x, _y, array2d_to_vector(_z, _x.size(), _y.size())) {}
+
 PlotDataSurface::PlotDataSurface(
   const std::valarray<double> &_x,
   const std::valarray<double> &_y,
@@ -78,16 +180,30 @@ PlotDataSurface::PlotDataSurface(
 #ifdef GTKMM_PLPLOT_BOOST_ENABLED
 //the Boost constructors
 
+//copy a multi_array into a single contiguous block, honouring its storage order
+static std::vector<double> boost_multi_array_to_vector(const boost::multi_array<double, 2> &_z, std::size_t nx, std::size_t ny) {
+  if (_z.shape()[0] != nx || _z.shape()[1] != ny)
+    throw Exception("Gtk::PLplot::PlotDataSurface::PlotDataSurface -> dimensions of x and/or y do not match those of z");
+
+  //the common case: the memory layout of the multi_array already matches ours
+  if (_z.storage_order() == boost::c_storage_order())
+    return std::vector<double>(_z.data(), _z.data() + _z.num_elements());
+
+  std::vector<double> rv(nx * ny);
+  const auto base_x = _z.index_bases()[0];
+  const auto base_y = _z.index_bases()[1];
+  for (std::size_t i = 0 ; i < nx ; i++)
+    for (std::size_t j = 0 ; j < ny ; j++)
+      rv[i * ny + j] = _z[base_x + i][base_y + j];
+  return rv;
+}
+
 PlotDataSurface::PlotDataSurface(
   const std::vector<double> &_x,
   const std::vector<double> &_y,
   const boost::multi_array<double, 2> &_z) :
   PlotDataSurface(_x, _y,
-  nullptr) {
-    if (_z.shape()[0] != _x.size() || _z.shape()[1] != _y.size())
-      throw Exception("Gtk::PLplot::PlotDataSurface::PlotDataSurface -> dimensions of x and/or y do not match those of z");
-		z = boost_multi_array_to_array2d(_z);
-  }
+  boost_multi_array_to_vector(_z, _x.size(), _y.size())) {}
 
 PlotDataSurface::PlotDataSurface(
   const std::valarray<double> &_x,
@@ -105,9 +221,7 @@ PlotDataSurface::PlotDataSurface(
 
 #endif
 
-PlotDataSurface::~PlotDataSurface() {
-  free_array2d((void **) z, x.size());
-}
+PlotDataSurface::~PlotDataSurface() {}
 
 std::vector<double> PlotDataSurface::get_vector_x() {
   return x;
@@ -118,5 +232,201 @@ std::vector<double> PlotDataSurface::get_vector_y() {
 }
 
 double **PlotDataSurface::get_array2d_z() {
-	return deep_copy_array2d(z, x.size(), y.size());
+  const StridedArray2D values = get_strided_data_z();
+  double **rv = calloc_array2d(x.size(), y.size());
+  for (std::size_t i = 0 ; i < x.size() ; i++)
+    for (std::size_t j = 0 ; j < y.size() ; j++)
+      rv[i][j] = values(i, j);
+  return rv;
+}
+
+const std::vector<double> &PlotDataSurface::get_data_x() const {
+  return x;
+}
+
+const std::vector<double> &PlotDataSurface::get_data_y() const {
+  return y;
+}
+
+const double * const *PlotDataSurface::get_data_z() const {
+  if (!external || column_stride == 1)
+    return z_rows.data();
+
+  //PLplot expects contiguous rows, so they have to be gathered from the external buffer
+  if (!z_gathered_valid) {
+    const StridedArray2D values = get_strided_data_z();
+    z_gathered.resize(x.size() * y.size());
+    z_gathered_rows.resize(x.size());
+    for (std::size_t i = 0 ; i < x.size() ; i++) {
+      z_gathered_rows[i] = z_gathered.data() + i * y.size();
+      for (std::size_t j = 0 ; j < y.size() ; j++)
+        z_gathered[i * y.size() + j] = values(i, j);
+    }
+    z_gathered_valid = true;
+  }
+  return z_gathered_rows.data();
+}
+
+StridedArray2D PlotDataSurface::get_strided_data_z() const {
+  return StridedArray2D(z_rows.data(), external ? column_stride : 1);
+}
+
+void PlotDataSurface::external_data_modified() {
+  z_gathered_valid = false;
+  extremes_z_valid = false;
+  pyramid.clear();
+  region_modified(0, 0, x.size(), y.size());
+}
+
+void PlotDataSurface::check_region(const char *method, std::size_t ix0, std::size_t iy0, std::size_t nx, std::size_t ny) const {
+  if (ix0 > x.size() || nx > x.size() - ix0 || iy0 > y.size() || ny > y.size() - iy0) {
+    throw Exception(Glib::ustring("Gtk::PLplot::PlotDataSurface::") + method + " -> the region does not fit within the grid");
+  }
+}
+
+void PlotDataSurface::region_modified(std::size_t ix0, std::size_t iy0, std::size_t nx, std::size_t ny) {
+  //modifications that have not been reported yet are merged with this one
+  if (!get_data_modified_pending())
+    modified_region[0] = modified_region[2] = 0;
+  merge_grid_region(modified_region, ix0, iy0, nx, ny);
+  merge_grid_region(pyramid_dirty, ix0, iy0, nx, ny);
+  notify_data_modified();
+}
+
+void PlotDataSurface::external_data_modified(std::size_t ix0, std::size_t iy0, std::size_t nx, std::size_t ny) {
+  check_region("external_data_modified", ix0, iy0, nx, ny);
+
+  if (nx == 0 || ny == 0)
+    return;
+
+  z_gathered_valid = false;
+
+  //the previous values are gone, so there is no telling whether the extremes were among them
+  extremes_z_valid = false;
+  region_modified(ix0, iy0, nx, ny);
+}
+
+void PlotDataSurface::update_region(std::size_t ix0, std::size_t iy0, std::size_t nx, std::size_t ny, const double *values) {
+  if (external) {
+    throw Exception("Gtk::PLplot::PlotDataSurface::update_region -> cannot modify a view on external data, use external_data_modified instead");
+  }
+
+  if (values == nullptr) {
+    throw Exception("Gtk::PLplot::PlotDataSurface::update_region -> values cannot be a null pointer");
+  }
+
+  check_region("update_region", ix0, iy0, nx, ny);
+
+  if (nx == 0 || ny == 0)
+    return;
+
+  double new_min = std::numeric_limits<double>::infinity();
+  double new_max = -std::numeric_limits<double>::infinity();
+  bool extreme_replaced = false;
+
+  for (std::size_t i = 0 ; i < nx ; i++) {
+    double *row = z.data() + (ix0 + i) * y.size() + iy0;
+    const double *new_row = values + i * ny;
+    for (std::size_t j = 0 ; j < ny ; j++) {
+      //if a value that is being replaced was one of the extremes, they will have to be searched for again
+      if (extremes_z_valid && (row[j] == extremes_z[0] || row[j] == extremes_z[1]))
+        extreme_replaced = true;
+      row[j] = new_row[j];
+      if (!std::isnan(new_row[j])) {
+        new_min = std::min(new_min, new_row[j]);
+        new_max = std::max(new_max, new_row[j]);
+      }
+    }
+  }
+
+  if (extremes_z_valid) {
+    //a grid that had no defined values at all has no extremes to merge with either
+    if (extreme_replaced || std::isnan(extremes_z[0])) {
+      extremes_z_valid = false;
+    }
+    else if (new_min <= new_max) {
+      extremes_z[0] = std::min(extremes_z[0], new_min);
+      extremes_z[1] = std::max(extremes_z[1], new_max);
+    }
+  }
+
+  region_modified(ix0, iy0, nx, ny);
+}
+
+void PlotDataSurface::get_modified_region(std::size_t &ix0, std::size_t &iy0, std::size_t &nx, std::size_t &ny) const {
+  ix0 = modified_region[0];
+  iy0 = modified_region[1];
+  nx = modified_region[2] - modified_region[0];
+  ny = modified_region[3] - modified_region[1];
+}
+
+void PlotDataSurface::get_extremes_z(double &min, double &max) {
+  if (!extremes_z_valid) {
+    extremes_z[0] = std::numeric_limits<double>::infinity();
+    extremes_z[1] = -std::numeric_limits<double>::infinity();
+    const StridedArray2D values = get_strided_data_z();
+    for (std::size_t i = 0 ; i < x.size() ; i++) {
+      for (std::size_t j = 0 ; j < y.size() ; j++) {
+        const double value = values(i, j);
+        if (std::isnan(value))
+          continue;
+        extremes_z[0] = std::min(extremes_z[0], value);
+        extremes_z[1] = std::max(extremes_z[1], value);
+      }
+    }
+    //a grid without any defined values
+    if (extremes_z[0] > extremes_z[1])
+      extremes_z[0] = extremes_z[1] = std::numeric_limits<double>::quiet_NaN();
+    extremes_z_valid = true;
+  }
+
+  min = extremes_z[0];
+  max = extremes_z[1];
+}
+
+void PlotDataSurface::set_pyramid_reduction(PyramidReduction _pyramid_reduction) {
+  if (_pyramid_reduction == pyramid_reduction)
+    return;
+
+  pyramid_reduction = _pyramid_reduction;
+  pyramid.clear();
+
+  //the values that plots display change, even though the data does not
+  region_modified(0, 0, x.size(), y.size());
+}
+
+PyramidReduction PlotDataSurface::get_pyramid_reduction() const {
+  return pyramid_reduction;
+}
+
+unsigned int PlotDataSurface::get_pyramid_levels() const {
+  if (pyramid_reduction == PYRAMID_NONE)
+    return 1;
+
+  unsigned int levels = 1;
+  for (std::size_t nx = x.size(), ny = y.size() ; (nx + 1) / 2 >= 2 && (ny + 1) / 2 >= 2 ; nx = (nx + 1) / 2, ny = (ny + 1) / 2)
+    levels++;
+  return levels;
+}
+
+const SurfacePyramidLevel &PlotDataSurface::get_pyramid_level(unsigned int level) {
+  if (level >= get_pyramid_levels()) {
+    throw Exception("Gtk::PLplot::PlotDataSurface::get_pyramid_level -> level exceeds the number of levels of the pyramid");
+  }
+
+  if (pyramid.empty()) {
+    pyramid.push_back(std::unique_ptr<SurfacePyramidLevel>(new SurfacePyramidLevel(x, y, z_rows, get_strided_data_z().get_column_stride())));
+  }
+  else if (pyramid_dirty[0] < pyramid_dirty[2] && pyramid_dirty[1] < pyramid_dirty[3]) {
+    //level 0 is a view on our data, so it is up to date already. Every next level is affected by a rectangle that is half as large.
+    std::size_t ix0 = pyramid_dirty[0], iy0 = pyramid_dirty[1], ix1 = pyramid_dirty[2], iy1 = pyramid_dirty[3];
+    for (std::size_t k = 1 ; k < pyramid.size() ; k++)
+      pyramid[k]->reduce_region(*pyramid[k - 1], pyramid_reduction, ix0, iy0, ix1, iy1);
+  }
+  pyramid_dirty[0] = pyramid_dirty[2] = 0;
+
+  while (pyramid.size() <= level)
+    pyramid.push_back(std::unique_ptr<SurfacePyramidLevel>(new SurfacePyramidLevel(*pyramid.back(), pyramid_reduction)));
+
+  return *pyramid[level];
 }
@@ -23,9 +23,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
   #include <boost/multi_array.hpp>
 #endif
 #include <gtkmm-plplot/plotdata.h>
+#include <gtkmm-plplot/stridedarray2d.h>
+#include <gtkmm-plplot/surfacepyramidlevel.h>
 #include <gtkmm-plplot/enums.h>
 #include <vector>
 #include <valarray>
+#include <memory>
 
 namespace Gtk {
   namespace PLplot {
@@ -34,7 +37,15 @@ namespace Gtk {
      *
      *  Instances of this class will hold a single (and the only possible) dataset for
      *  a surface plot types like PlotContour and PlotContourShades. The input data can be provided
-     *  as std::vector (X and Y), std::valarray (X and Y), double** (Z, array of arrays) and boost:multi_array (Z).
+     *  as std::vector (X and Y), std::valarray (X and Y), std::vector (Z, contiguous), double** (Z, array of arrays) and boost:multi_array (Z).
+     *  Internally, the Z-values are always stored contiguously, and PLplot is handed a table of row pointers into this storage, which is built only once.
+     *  Alternatively, the dataset can be a view on an external, strided two-dimensional buffer, whose Z-values are read in place, whatever its layout.
+     *  The plots access such buffers through get_strided_data_z(), and only get_data_z() needs a contiguous copy of buffers whose elements are not
+     *  contiguous along the second dimension, such as column-major buffers.
+     *  Parts of the data can be replaced with update_region(), in which case the dataset keeps track of the rectangle of grid points that was modified,
+     *  allowing plots to update only the affected part of their cached geometry.
+     *  For grids with more points than the plot has pixels, the dataset lazily builds a display-resolution pyramid of SurfacePyramidLevel objects,
+     *  each of which has half the resolution of the previous one. PlotContour and PlotContourShades pick the level that matches the size of the plot and the current zoom.
      *  This datatype is demonstrated in \ref example7.
      */
     class PlotDataSurface : public PlotData {
@@ -43,17 +54,87 @@ namespace Gtk {
       PlotDataSurface() = delete; ///< no default constructor
       PlotDataSurface(const PlotDataSurface &) = delete; ///< no copy constructor
       PlotDataSurface &operator=(const PlotDataSurface &) = delete; ///< no assignment operator
+
+      /** Ensure that the X- and Y-grid coordinates are valid
+       *
+       * \exception Gtk::PLplot::Exception
+       */
+      void check_grid();
+
+      /** Fill up \c z_rows with pointers into either \c z or the external buffer
+       *
+       */
+      void build_row_table();
+
+      /** Check that a rectangle of grid points lies within the grid
+       *
+       * \param method the name of the calling method, used in the exception message
+       * \param ix0 the first index of the rectangle along the first dimension
+       * \param iy0 the first index of the rectangle along the second dimension
+       * \param nx the extent of the rectangle along the first dimension
+       * \param ny the extent of the rectangle along the second dimension
+       * \exception Gtk::PLplot::Exception
+       */
+      void check_region(const char *method, std::size_t ix0, std::size_t iy0, std::size_t nx, std::size_t ny) const;
+
+      /** Record that a rectangle of grid points was modified, and emit signal_data_modified
+       *
+       * If the emission of the signal is being postponed, the rectangle is merged with those that were recorded since.
+       * \param ix0 the first index of the rectangle along the first dimension
+       * \param iy0 the first index of the rectangle along the second dimension
+       * \param nx the extent of the rectangle along the first dimension
+       * \param ny the extent of the rectangle along the second dimension
+       */
+      void region_modified(std::size_t ix0, std::size_t iy0, std::size_t nx, std::size_t ny);
     protected:
       std::vector<double> x; ///< The X-grid coordinates of the dataset, which are assumed to correspond to the first dimension of Z
       std::vector<double> y; ///< The Y-grid coordinates of the dataset, which are assumed to correspond to the second dimension of Z
-      double **z; ///< The Z-values of the dataset. This is an array of arrays whose first dimension must correspond to the length of x, while the second must correspond to the length of y.
+      std::vector<double> z; ///< The Z-values of the dataset, stored contiguously: the value at grid point (i, j) is found at index i * y.size() + j. Empty if the dataset is a view on an external buffer.
+      std::vector<const double *> z_rows; ///< A table with pointers to the start of each row of the Z-values, whose elements are \c column_stride apart if the dataset is a view on an external buffer, and contiguous otherwise
+      mutable std::vector<double> z_gathered; ///< a contiguous copy of the external buffer, made by get_data_z() if the elements of its rows are not contiguous
+      mutable std::vector<const double *> z_gathered_rows; ///< a table with pointers to the start of each row of \c z_gathered
+      mutable bool z_gathered_valid; ///< \c false if \c z_gathered needs to be copied again before get_data_z() can return it
+      std::shared_ptr<const double> shared; ///< keeps the external buffer alive, if it was provided as a shared pointer
+      const double *external; ///< the external buffer this dataset is a view on, or \c nullptr if the Z-values are owned by the dataset
+      std::size_t row_stride; ///< the distance, in elements, between grid points (i, j) and (i + 1, j) in the external buffer
+      std::size_t column_stride; ///< the distance, in elements, between grid points (i, j) and (i, j + 1) in the external buffer
+      std::size_t modified_region[4]; ///< the rectangle of grid points that was modified most recently: first X-index, first Y-index, and one past the last X- and Y-index
+      double extremes_z[2]; ///< the cached minimum and maximum of the Z-values, ignoring NaN
+      bool extremes_z_valid; ///< \c false if \c extremes_z needs to be recalculated before it can be used
+      PyramidReduction pyramid_reduction; ///< how blocks of grid points are combined when building the pyramid
+      std::vector<std::unique_ptr<SurfacePyramidLevel>> pyramid; ///< the levels of the display-resolution pyramid that have been built so far
+      std::size_t pyramid_dirty[4]; ///< the rectangle of grid points that was modified since \c pyramid was last brought up to date, in the format used by merge_grid_region()
     public:
       /** Constructor
        *
        * Initializes a new dataset for a PlotContour.
        * \param x the X-grid coordinates of the dataset, provided as a std::vector. Have to match the first dimension of z
        * \param y the Y-grid coordinates of the dataset, provided as a std::vector. Have to match the second dimension of z
-       * \param z the actual surface data, provided as a dynamically allocated array of dynamically allocated arrays. The constructor will initialize its own deep-copy of this variable.
+       * \param z the actual surface data, provided as a contiguous std::vector of x.size() * y.size() elements, in which the value at grid point (i, j) is found at index i * y.size() + j
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotDataSurface(const std::vector<double> &x,
+                      const std::vector<double> &y,
+                      const std::vector<double> &z);
+
+      /** Constructor
+       *
+       * Initializes a new dataset for a PlotContour. The contents of \c z are moved into the dataset instead of being copied, leaving it empty.
+       * \param x the X-grid coordinates of the dataset, provided as a std::vector. Have to match the first dimension of z
+       * \param y the Y-grid coordinates of the dataset, provided as a std::vector. Have to match the second dimension of z
+       * \param z the actual surface data, provided as a contiguous std::vector of x.size() * y.size() elements, in which the value at grid point (i, j) is found at index i * y.size() + j
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotDataSurface(const std::vector<double> &x,
+                      const std::vector<double> &y,
+                      std::vector<double> &&z);
+
+      /** Constructor
+       *
+       * Initializes a new dataset for a PlotContour.
+       * \param x the X-grid coordinates of the dataset, provided as a std::vector. Have to match the first dimension of z
+       * \param y the Y-grid coordinates of the dataset, provided as a std::vector. Have to match the second dimension of z
+       * \param z the actual surface data, provided as a dynamically allocated array of dynamically allocated arrays. The constructor will copy its contents into contiguous storage.
        * \exception Gtk::PLplot::Exception
        */
       PlotDataSurface(const std::vector<double> &x,
@@ -65,7 +146,7 @@ namespace Gtk {
        * Initializes a new dataset for a PlotContour.
        * \param x the X-grid coordinates of the dataset, provided as a std::valarray. Have to match the first dimension of z
        * \param y the Y-grid coordinates of the dataset, provided as a std::valarray. Have to match the second dimension of z
-       * \param z the actual surface data, provided as a dynamically allocated array of dynamically allocated arrays. The constructor will initialize its own deep-copy of this variable.
+       * \param z the actual surface data, provided as a dynamically allocated array of dynamically allocated arrays. The constructor will copy its contents into contiguous storage.
        */
       PlotDataSurface(const std::valarray<double> &x,
                       const std::valarray<double> &y,
@@ -77,19 +158,74 @@ namespace Gtk {
        * set to a vector of the appropriate size with elements set to correspond to their array subscript.
        * \param nx the extent of z along the first dimension
        * \param ny the extent of z along the second dimension
-       * \param z the actual surface data, provided as a dynamically allocated array of dynamically allocated arrays. The constructor will initialize its own deep-copy of this variable.
+       * \param z the actual surface data, provided as a dynamically allocated array of dynamically allocated arrays. The constructor will copy its contents into contiguous storage.
        */
       PlotDataSurface(unsigned int nx,
                       unsigned int ny,
                       double **z);
 
+      /** Constructor
+       *
+       * Initializes a new dataset for a PlotContour that is a view on an external, strided two-dimensional buffer.
+       * The value at grid point (i, j) is read from z[i * row_stride + j * column_stride]: use a column stride of 1 for row-major buffers,
+       * and a row stride of 1 for column-major buffers. Padding can be accounted for by choosing the other stride accordingly.
+       * No copy is made: the memory must remain valid for as long as the dataset exists,
+       * and external_data_modified() must be called whenever its contents have been changed.
+       * \param x the X-grid coordinates of the dataset, provided as a std::vector. Have to match the first dimension of z
+       * \param y the Y-grid coordinates of the dataset, provided as a std::vector. Have to match the second dimension of z
+       * \param z pointer to the value at grid point (0, 0)
+       * \param row_stride the distance, in elements, between grid points (i, j) and (i + 1, j)
+       * \param column_stride the distance, in elements, between grid points (i, j) and (i, j + 1)
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotDataSurface(const std::vector<double> &x,
+                      const std::vector<double> &y,
+                      const double *z,
+                      std::size_t row_stride,
+                      std::size_t column_stride = 1);
+
+      /** Constructor
+       *
+       * Initializes a new dataset for a PlotContour that is a view on an external, strided two-dimensional buffer.
+       * This constructor behaves like the one that takes a raw pointer, but the dataset will keep a reference to the buffer,
+       * ensuring it remains valid for as long as the dataset exists.
+       * \param x the X-grid coordinates of the dataset, provided as a std::vector. Have to match the first dimension of z
+       * \param y the Y-grid coordinates of the dataset, provided as a std::vector. Have to match the second dimension of z
+       * \param z shared pointer to the value at grid point (0, 0)
+       * \param row_stride the distance, in elements, between grid points (i, j) and (i + 1, j)
+       * \param column_stride the distance, in elements, between grid points (i, j) and (i, j + 1)
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotDataSurface(const std::vector<double> &x,
+                      const std::vector<double> &y,
+                      std::shared_ptr<const double> z,
+                      std::size_t row_stride,
+                      std::size_t column_stride = 1);
+
+      /** Constructor
+       *
+       * Initializes a new dataset for a PlotContour that is a view on an external, strided two-dimensional buffer.
+       * The X- and Y-values will be set to a vector of the appropriate size with elements set to correspond to their array subscript.
+       * \param nx the extent of z along the first dimension
+       * \param ny the extent of z along the second dimension
+       * \param z pointer to the value at grid point (0, 0)
+       * \param row_stride the distance, in elements, between grid points (i, j) and (i + 1, j)
+       * \param column_stride the distance, in elements, between grid points (i, j) and (i, j + 1)
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotDataSurface(unsigned int nx,
+                      unsigned int ny,
+                      const double *z,
+                      std::size_t row_stride,
+                      std::size_t column_stride = 1);
+
 #ifdef GTKMM_PLPLOT_BOOST_ENABLED
       /** Constructor
        *
        * Initializes a new dataset for a PlotContour.
        * \param x the X-grid coordinates of the dataset, provided as a std::vector. Have to match the first dimension of z
        * \param y the Y-grid coordinates of the dataset, provided as a std::vector. Have to match the second dimension of z
-       * \param z the actual surface data, provided as a Boost \c multi_array.
+       * \param z the actual surface data, provided as a Boost \c multi_array. Its elements are copied into contiguous storage, using a single block copy if it uses C storage order. To avoid this copy altogether, pass its data() and strides() to the strided view constructor instead.
        */
       PlotDataSurface(const std::vector<double> &x,
                       const std::vector<double> &y,
@@ -100,7 +236,7 @@ namespace Gtk {
        * Initializes a new dataset for a PlotContour.
        * \param x the X-grid coordinates of the dataset, provided as a std::valarray. Have to match the first dimension of z
        * \param y the Y-grid coordinates of the dataset, provided as a std::valarray. Have to match the second dimension of z
-       * \param z the actual surface data, provided as a Boost \c multi_array.
+       * \param z the actual surface data, provided as a Boost \c multi_array. Its elements are copied into contiguous storage, using a single block copy if it uses C storage order. To avoid this copy altogether, pass its data() and strides() to the strided view constructor instead.
        */
       PlotDataSurface(const std::valarray<double> &x,
                       const std::valarray<double> &y,
@@ -110,7 +246,7 @@ namespace Gtk {
        *
        * Initializes a new dataset for a PlotContour.The X- and Y-values will be
        * set to a vector of the appropriate size with elements set to correspond to their array subscript.
-       * \param z the actual surface data, provided as a Boost \c multi_array.
+       * \param z the actual surface data, provided as a Boost \c multi_array. Its elements are copied into contiguous storage, using a single block copy if it uses C storage order. To avoid this copy altogether, pass its data() and strides() to the strided view constructor instead.
        */
       PlotDataSurface(const boost::multi_array<double, 2> &z);
 #endif
@@ -120,6 +256,87 @@ namespace Gtk {
        */
       virtual ~PlotDataSurface();
 
+      /** Inform the dataset that the external buffer it is a view on has been modified
+       *
+       * This method must be called by the owner of the buffer after each change, to ensure that the plot is updated.
+       */
+      void external_data_modified();
+
+      /** Inform the dataset that a rectangle of the external buffer it is a view on has been modified
+       *
+       * This method behaves like external_data_modified(), but allows plots to update only the part of their cached geometry that is affected by the change.
+       * \param ix0 the first index of the rectangle along the first dimension
+       * \param iy0 the first index of the rectangle along the second dimension
+       * \param nx the extent of the rectangle along the first dimension
+       * \param ny the extent of the rectangle along the second dimension
+       * \exception Gtk::PLplot::Exception
+       */
+      void external_data_modified(std::size_t ix0, std::size_t iy0, std::size_t nx, std::size_t ny);
+
+      /** Replace the Z-values of a rectangle of grid points
+       *
+       * The minimum and maximum of the Z-values are updated incrementally whenever possible, and signal_data_modified is emitted.
+       * Plots will then trace their contours again only for the part of the grid that is affected.
+       * This method cannot be used on datasets that are a view on an external buffer: modify the buffer and call external_data_modified() instead.
+       * \param ix0 the first index of the rectangle along the first dimension
+       * \param iy0 the first index of the rectangle along the second dimension
+       * \param nx the extent of the rectangle along the first dimension
+       * \param ny the extent of the rectangle along the second dimension
+       * \param values the new Z-values, as a contiguous array of nx * ny elements, in which the value for grid point (ix0 + i, iy0 + j) is found at index i * ny + j
+       * \exception Gtk::PLplot::Exception
+       */
+      void update_region(std::size_t ix0, std::size_t iy0, std::size_t nx, std::size_t ny, const double *values);
+
+      /** Get the rectangle of grid points that was modified most recently
+       *
+       * When several modifications were made while updates were frozen, this is the smallest rectangle that contains all of them.
+       * Modifications of the entire dataset, such as those reported through external_data_modified() without arguments, cover the entire grid.
+       * \param ix0 the first index of the rectangle along the first dimension
+       * \param iy0 the first index of the rectangle along the second dimension
+       * \param nx the extent of the rectangle along the first dimension
+       * \param ny the extent of the rectangle along the second dimension
+       */
+      void get_modified_region(std::size_t &ix0, std::size_t &iy0, std::size_t &nx, std::size_t &ny) const;
+
+      /** Get the minimum and maximum of the Z-values
+       *
+       * NaN values are ignored. The extremes are cached, and are only recalculated when a modification may have changed them.
+       * \param min the minimum of the Z-values
+       * \param max the maximum of the Z-values
+       */
+      void get_extremes_z(double &min, double &max);
+
+      /** Set how blocks of grid points are combined when building the display-resolution pyramid
+       *
+       * The default is PYRAMID_MEAN. PYRAMID_MIN and PYRAMID_MAX ensure that isolated troughs or peaks remain visible at any zoom level,
+       * while PYRAMID_NONE disables the pyramid, making plots always use the data at full resolution.
+       * \param reduction the new reduction
+       */
+      void set_pyramid_reduction(PyramidReduction reduction);
+
+      /** Get how blocks of grid points are combined when building the display-resolution pyramid
+       *
+       * \returns the current reduction
+       */
+      PyramidReduction get_pyramid_reduction() const;
+
+      /** Get the number of levels of the display-resolution pyramid
+       *
+       * Level 0 is the data at full resolution. Levels are added as long as both dimensions of the grid keep at least two grid points.
+       * \returns the number of levels, which is 1 if the pyramid is disabled
+       */
+      unsigned int get_pyramid_levels() const;
+
+      /** Get a level of the display-resolution pyramid
+       *
+       * Levels are built when they are first requested, and modifications of the data are applied to the levels that were built already when they are requested again.
+       * The returned reference remains valid until the entire dataset is reported as modified, or the reduction is changed.
+       * \param level the level, which must be smaller than get_pyramid_levels()
+       * \returns a reference to the level
+       * \exception Gtk::PLplot::Exception
+       */
+      const SurfacePyramidLevel &get_pyramid_level(unsigned int level);
+
       /**
        *
        * \returns a copy of the dataset X-values
@@ -137,6 +354,36 @@ namespace Gtk {
        * \returns a copy of the dataset Z-values
        */
       double **get_array2d_z();
+
+      /** Get read-only access to the X-grid coordinates, without copying them
+       *
+       * \returns a reference to the dataset X-values
+       */
+      const std::vector<double> &get_data_x() const;
+
+      /** Get read-only access to the Y-grid coordinates, without copying them
+       *
+       * \returns a reference to the dataset Y-values
+       */
+      const std::vector<double> &get_data_y() const;
+
+      /** Get read-only access to the Z-values, as an array of arrays
+       *
+       * The returned array of arrays remains owned by the dataset and must not be freed.
+       * Its rows point either into the storage of the dataset, or straight into the external buffer it is a view on.
+       * The only exception are views on buffers whose elements are not contiguous along the second dimension: these are copied into contiguous storage
+       * on the first call after each modification. Use get_strided_data_z() to avoid this copy.
+       * \returns the dataset Z-values
+       */
+      const double * const *get_data_z() const;
+
+      /** Get read-only access to the Z-values, without copying them
+       *
+       * Unlike get_data_z(), this method reads views on external buffers in place, whatever their layout.
+       * The returned view remains valid for as long as the dataset exists.
+       * \returns the dataset Z-values
+       */
+      StridedArray2D get_strided_data_z() const;
     };
   }
 }
@@ -0,0 +1,136 @@
+/*
+Copyright (C) 2016 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtkmm-plplot/plotdatawaterfall.h>
+#include <gtkmm-plplot/exception.h>
+#include <algorithm>
+
+using namespace Gtk::PLplot;
+
+PlotDataWaterfall::PlotDataWaterfall(
+  std::size_t _capacity,
+  std::size_t _ny,
+  double _y_first,
+  double _y_last,
+  double _x_step,
+  double _x_start) :
+  Glib::ObjectBase("GtkmmPLplotPlotDataWaterfall"),
+  PlotData(),
+  capacity(_capacity),
+  x_start(_x_start),
+  x_step(_x_step),
+  sequence(0) {
+
+  if (capacity < 2) {
+    throw Exception("Gtk::PLplot::PlotDataWaterfall::PlotDataWaterfall -> capacity must be at least 2");
+  }
+
+  if (_ny < 2) {
+    throw Exception("Gtk::PLplot::PlotDataWaterfall::PlotDataWaterfall -> ny must be at least 2");
+  }
+
+  if (_y_last <= _y_first) {
+    throw Exception("Gtk::PLplot::PlotDataWaterfall::PlotDataWaterfall -> y_last must be greater than y_first");
+  }
+
+  if (x_step <= 0.0) {
+    throw Exception("Gtk::PLplot::PlotDataWaterfall::PlotDataWaterfall -> x_step must be strictly positive");
+  }
+
+  y.resize(_ny);
+  for (std::size_t j = 0 ; j < _ny ; j++)
+    y[j] = _y_first + (_y_last - _y_first) * j / (_ny - 1);
+
+  z.resize(capacity * _ny);
+
+  //every row appears twice in the table, so the rows from oldest to newest are always found contiguously
+  z_rows.resize(2 * capacity);
+  for (std::size_t k = 0 ; k < 2 * capacity ; k++)
+    z_rows[k] = z.data() + (k % capacity) * _ny;
+}
+
+PlotDataWaterfall::~PlotDataWaterfall() {}
+
+void PlotDataWaterfall::store_row(const double *values) {
+  std::copy(values, values + y.size(), z.begin() + (sequence % capacity) * y.size());
+  sequence++;
+}
+
+void PlotDataWaterfall::push_row(const double *values) {
+  store_row(values);
+  notify_data_modified();
+}
+
+void PlotDataWaterfall::push_row(const std::vector<double> &values) {
+  if (values.size() != y.size()) {
+    throw Exception("Gtk::PLplot::PlotDataWaterfall::push_row -> the number of values does not match the number of Y-grid coordinates");
+  }
+  push_row(values.data());
+}
+
+void PlotDataWaterfall::push_rows(const double *values, std::size_t n) {
+  if (n == 0)
+    return;
+
+  //rows that would be evicted by the same call anyway can be skipped
+  if (n > capacity) {
+    sequence += n - capacity;
+    values += (n - capacity) * y.size();
+    n = capacity;
+  }
+
+  for (std::size_t i = 0 ; i < n ; i++)
+    store_row(values + i * y.size());
+
+  notify_data_modified();
+}
+
+std::size_t PlotDataWaterfall::get_capacity() const {
+  return capacity;
+}
+
+std::size_t PlotDataWaterfall::get_size() const {
+  return std::min(sequence, capacity);
+}
+
+std::size_t PlotDataWaterfall::get_sequence() const {
+  return sequence;
+}
+
+double PlotDataWaterfall::get_row_x(std::size_t row) const {
+  return x_start + row * x_step;
+}
+
+double PlotDataWaterfall::get_x_step() const {
+  return x_step;
+}
+
+const std::vector<double> &PlotDataWaterfall::get_data_y() const {
+  return y;
+}
+
+const double * const *PlotDataWaterfall::get_data_z() const {
+  //as long as the buffer is not full, the oldest row is found at its start
+  return z_rows.data() + (sequence > capacity ? sequence % capacity : 0);
+}
+
+const double *PlotDataWaterfall::get_row(std::size_t row) const {
+  if (row >= sequence || sequence - row > capacity) {
+    throw Exception("Gtk::PLplot::PlotDataWaterfall::get_row -> the row is not held by the dataset");
+  }
+  return z_rows[row % capacity];
+}
@@ -0,0 +1,162 @@
+/*
+Copyright (C) 2016 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GTKMM_PLPLOT_PLOTDATA_WATERFALL_H
+#define GTKMM_PLPLOT_PLOTDATA_WATERFALL_H
+
+#include <gtkmm-plplot/plotdata.h>
+#include <vector>
+
+namespace Gtk {
+  namespace PLplot {
+    /** \class PlotDataWaterfall plotdatawaterfall.h <gtkmm-plplot/plotdatawaterfall.h>
+     *  \brief a class that will hold a fixed number of the most recent rows of a continuously growing surface, such as a spectrogram
+     *
+     *  Instances of this class are meant for waterfall displays: rows of Z-values, for example the spectra produced by consecutive FFTs, are added one by one
+     *  with push_row(), and once the capacity chosen at construction time has been reached, each new row replaces the oldest one.
+     *  Row number \c s, counting from 0 for the first row that was ever pushed, is located at X-coordinate \c x_start + \c s * \c x_step,
+     *  while the Y-grid coordinates are evenly spaced and shared by all rows.
+     *  The Z-values are stored in a circular buffer, and a table with two pointers to each row allows get_data_z() to return the rows from oldest to newest
+     *  without copying or reordering anything, making the cost of adding a row independent of the capacity.
+     *  This dataset is meant to be plotted with PlotWaterfall.
+     */
+    class PlotDataWaterfall : public PlotData {
+    private:
+      PlotDataWaterfall() = delete; ///< no default constructor
+      PlotDataWaterfall(const PlotDataWaterfall &) = delete; ///< no copy constructor
+      PlotDataWaterfall &operator=(const PlotDataWaterfall &) = delete; ///< no assignment operator
+
+      /** Copy a row into the circular buffer, replacing the oldest one if the buffer is full
+       *
+       * This does not emit any signals.
+       * \param values pointer to the Z-values of the row
+       */
+      void store_row(const double *values);
+    protected:
+      std::size_t capacity; ///< the maximum number of rows that will be kept
+      double x_start; ///< the X-coordinate of the first row that was ever pushed
+      double x_step; ///< the distance between the X-coordinates of consecutive rows
+      std::vector<double> y; ///< the Y-grid coordinates, shared by all rows
+      std::vector<double> z; ///< the circular buffer with the Z-values: row number \c s is found at index (\c s % \c capacity) * \c y.size()
+      std::vector<const double *> z_rows; ///< 2 * \c capacity pointers, with element \c k pointing to the row at position \c k % \c capacity of the circular buffer
+      std::size_t sequence; ///< the total number of rows that were ever pushed
+    public:
+      /** Constructor
+       *
+       * Initializes a new, empty dataset.
+       * \param capacity the maximum number of rows that will be kept. Must be at least 2.
+       * \param ny the number of Z-values in each row. Must be at least 2.
+       * \param y_first the Y-coordinate of the first Z-value of each row
+       * \param y_last the Y-coordinate of the last Z-value of each row, which must be greater than \c y_first
+       * \param x_step the distance between the X-coordinates of consecutive rows, which must be strictly positive
+       * \param x_start the X-coordinate of the first row
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotDataWaterfall(std::size_t capacity,
+                        std::size_t ny,
+                        double y_first,
+                        double y_last,
+                        double x_step = 1.0,
+                        double x_start = 0.0);
+
+      /** Destructor
+       *
+       */
+      virtual ~PlotDataWaterfall();
+
+      /** Add a row to the dataset
+       *
+       * If the dataset already holds \c capacity rows, the oldest one will be discarded.
+       * After this method is called, the plot will be automatically updated to reflect the changes.
+       * \param values pointer to get_data_y().size() Z-values
+       */
+      void push_row(const double *values);
+
+      /** Add a row to the dataset
+       *
+       * If the dataset already holds \c capacity rows, the oldest one will be discarded.
+       * After this method is called, the plot will be automatically updated to reflect the changes.
+       * \param values the Z-values, which must contain get_data_y().size() elements
+       * \exception Gtk::PLplot::Exception
+       */
+      void push_row(const std::vector<double> &values);
+
+      /** Add several rows to the dataset
+       *
+       * Contrary to calling push_row() repeatedly, the plot will be updated only once, after all rows have been added.
+       * \param values pointer to \c n * get_data_y().size() Z-values, row after row
+       * \param n the number of rows to add
+       */
+      void push_rows(const double *values, std::size_t n);
+
+      /** Get the maximum number of rows that will be kept
+       *
+       * \returns the capacity
+       */
+      std::size_t get_capacity() const;
+
+      /** Get the number of rows that are currently held by the dataset
+       *
+       * \returns the number of rows, which will never exceed the capacity
+       */
+      std::size_t get_size() const;
+
+      /** Get the total number of rows that were ever added to the dataset
+       *
+       * The oldest row that is currently held has number get_sequence() - get_size().
+       * \returns the total number of rows
+       */
+      std::size_t get_sequence() const;
+
+      /** Get the X-coordinate of a row
+       *
+       * \param row the number of the row, counting from 0 for the first row that was ever pushed
+       * \returns the X-coordinate
+       */
+      double get_row_x(std::size_t row) const;
+
+      /** Get the distance between the X-coordinates of consecutive rows
+       *
+       * \returns the distance
+       */
+      double get_x_step() const;
+
+      /** Get read-only access to the Y-grid coordinates, without copying them
+       *
+       * \returns a reference to the dataset Y-values
+       */
+      const std::vector<double> &get_data_y() const;
+
+      /** Get read-only access to the Z-values, without copying them
+       *
+       * The returned array of arrays remains owned by the dataset and must not be freed. It remains valid until the next row is pushed.
+       * \returns the get_size() rows that are currently held, from oldest to newest
+       */
+      const double * const *get_data_z() const;
+
+      /** Get read-only access to the Z-values of a single row
+       *
+       * \param row the number of the row, counting from 0 for the first row that was ever pushed
+       * \returns pointer to the Z-values of the row
+       * \exception Gtk::PLplot::Exception
+       */
+      const double *get_row(std::size_t row) const;
+    };
+  }
+}
+
+#endif
@@ -77,7 +77,7 @@ void PlotHistogram::plot_data_modified() {
   plotted_range_y[0] = plot_data_range_y[0];
   plotted_range_y[1] = plot_data_range_y[1];
 
-  _signal_changed.emit();
+  notify_changed();
 }
 
 void PlotHistogram::add_data(PlotDataHistogram &data) {
@@ -86,8 +86,8 @@ void PlotHistogram::add_data(PlotDataHistogram &data) {
     throw Exception("Gtk::PLplot::PlotHistogram::add_data -> cannot add data when plot_data is not empty!");
 
   plot_data.push_back(&data);
-  data.signal_changed().connect([this](){_signal_changed.emit();});
-  data.signal_data_modified().connect([this](){plot_data_modified();});
+  data.signal_changed().connect([this](){notify_changed();});
+  data.signal_data_modified().connect([this](){notify_data_modified();});
 
   _signal_data_added.emit(&data);
 }
@@ -85,21 +85,18 @@ void PlotPolar::plot_data_modified() {
   //since we are dealing with polar coordinates, we really need to look only
   //at the maximum x (r here)
 
-  std::vector<double> vec_max_r;
+  max_r = 0.0;
 
   for (auto &iter : plot_data) {
     auto iter2 = dynamic_cast<PlotDataPolar*>(iter);
     double r;
     iter2->get_max_r(r);
-    vec_max_r.push_back(r);
+    max_r = std::max(max_r, r);
   }
 
-  if (vec_max_r.empty()) {
+  if (plot_data.empty()) {
     max_r = 1.0;
   }
-  else {
-    max_r = *std::max_element(vec_max_r.begin(), vec_max_r.end());
-  }
 
   plot_data_range_x[0] =
   plot_data_range_x[1] = max_r * M_SQRT2 * 1.3;
@@ -120,7 +117,7 @@ void PlotPolar::plot_data_modified() {
   plotted_range_y[0] = plot_data_range_y[0];
   plotted_range_y[1] = plot_data_range_y[1];
 
-  _signal_changed.emit();
+  notify_changed();
 }
 
 void PlotPolar::add_data(PlotDataPolar &data) {
@@ -130,14 +127,15 @@ void PlotPolar::add_data(PlotDataPolar &data) {
     throw Exception("Gtk::PLplot::PlotPolar::add_data -> Data has been added before to this plot");
 
   //throw error if any of the r values are negative
-  std::vector<double> x = data.get_vector_x();
-  if (std::count_if(x.begin(), x.end(), std::bind2nd(std::less<double>(), double(0.0))) > 0) {
+  double rmin, rmax, thetamin, thetamax;
+  data.get_extremes(rmin, rmax, thetamin, thetamax);
+  if (rmin < 0.0) {
     throw Exception("Gtkmm::Plplot::PlotPolar::add_data -> plot R-values must be  positive");
   }
 
   plot_data.push_back(&data);
-  data.signal_changed().connect([this](){_signal_changed.emit();});
-  data.signal_data_modified().connect([this](){plot_data_modified();});
+  data.signal_changed().connect([this](){notify_changed();});
+  data.signal_data_modified().connect([this](){notify_data_modified();});
 
   _signal_data_added.emit(&data);
 }
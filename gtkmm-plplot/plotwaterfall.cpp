@@ -0,0 +1,368 @@
+/*
+Copyright (C) 2016 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtkmm-plplot/plotwaterfall.h>
+#include <gtkmm-plplot/exception.h>
+#include <gtkmm-plplot/utils.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <plstream.h>
+
+#define PLOTWATERFALL_MAX_IMAGE_SIZE 32767
+
+using namespace Gtk::PLplot;
+
+PlotWaterfall::PlotWaterfall(
+  double _zmin,
+  double _zmax,
+  const Glib::ustring &_axis_title_x,
+  const Glib::ustring &_axis_title_y,
+  const Glib::ustring &_plot_title,
+  unsigned int _nlevels,
+  ColormapPalette _colormap_palette,
+  const double _plot_width_norm,
+  const double _plot_height_norm,
+  const double _plot_offset_horizontal_norm,
+  const double _plot_offset_vertical_norm) :
+  Glib::ObjectBase("GtkmmPLplotPlotWaterfall"),
+  Plot(_axis_title_x, _axis_title_y, _plot_title,
+  _plot_width_norm, _plot_height_norm,
+  _plot_offset_horizontal_norm,
+  _plot_offset_vertical_norm),
+  zmin(_zmin),
+  zmax(_zmax),
+  nlevels(_nlevels),
+  clevels(_nlevels),
+  colormap_palette(_colormap_palette),
+  showing_colorbar(true),
+  colorbar_title("Magnitude"),
+  image_sequence(0) {
+
+  if (!(zmax > zmin)) {
+    throw Exception("Gtk::PLplot::PlotWaterfall::PlotWaterfall -> zmax must be greater than zmin");
+  }
+
+  if (nlevels < 2) {
+    throw Exception("Gtk::PLplot::PlotWaterfall::PlotWaterfall -> nlevels must be greater than or equal to 2");
+  }
+
+  for (unsigned int i = 0 ; i < nlevels ; i++) {
+    clevels[i] = zmin + (zmax - zmin) * i / (double) (nlevels - 1);
+  }
+}
+
+PlotWaterfall::PlotWaterfall(
+  PlotDataWaterfall &_data,
+  double _zmin,
+  double _zmax,
+  const Glib::ustring &_axis_title_x,
+  const Glib::ustring &_axis_title_y,
+  const Glib::ustring &_plot_title,
+  unsigned int _nlevels,
+  ColormapPalette _colormap_palette,
+  const double _plot_width_norm,
+  const double _plot_height_norm,
+  const double _plot_offset_horizontal_norm,
+  const double _plot_offset_vertical_norm) :
+  PlotWaterfall(_zmin, _zmax,
+  _axis_title_x, _axis_title_y, _plot_title,
+  _nlevels, _colormap_palette,
+  _plot_width_norm, _plot_height_norm,
+  _plot_offset_horizontal_norm,
+  _plot_offset_vertical_norm) {
+
+  add_data(_data);
+}
+
+PlotWaterfall::~PlotWaterfall() {}
+
+void PlotWaterfall::plot_data_modified() {
+  auto data = dynamic_cast<PlotDataWaterfall*>(plot_data[0]);
+  const std::vector<double> &y = data->get_data_y();
+  const double step = data->get_x_step();
+  const double dy = (y.back() - y.front()) / (y.size() - 1);
+
+  //the plot only scrolls along with the incoming rows when the user has not zoomed in: the plotted range then still matches the previous range of the data
+  const bool zoomed = plotted_range_x[0] != plot_data_range_x[0] ||
+                      plotted_range_x[1] != plot_data_range_x[1] ||
+                      plotted_range_y[0] != plot_data_range_y[0] ||
+                      plotted_range_y[1] != plot_data_range_y[1];
+
+  //each row covers a cell of step by dy, centered on its coordinates.
+  //the X-range spans the full capacity, ending at the most recent row, so the plot scrolls at a constant rate.
+  const double last = data->get_row_x(data->get_sequence()) - 0.5 * step;
+
+  plot_data_range_x[0] = last - data->get_capacity() * step;
+  plot_data_range_x[1] = last;
+  plot_data_range_y[0] = y.front() - 0.5 * dy;
+  plot_data_range_y[1] = y.back() + 0.5 * dy;
+
+  //This function won't do anything as I am using the default implementation
+  //provided by Plot
+  coordinate_transform_world_to_plplot(
+    plot_data_range_x[0], plot_data_range_y[0],
+    plot_data_range_x[0], plot_data_range_y[0]
+  );
+  coordinate_transform_world_to_plplot(
+    plot_data_range_x[1], plot_data_range_y[1],
+    plot_data_range_x[1], plot_data_range_y[1]
+  );
+
+  if (!zoomed) {
+    plotted_range_x[0] = plot_data_range_x[0];
+    plotted_range_x[1] = plot_data_range_x[1];
+    plotted_range_y[0] = plot_data_range_y[0];
+    plotted_range_y[1] = plot_data_range_y[1];
+  }
+
+  notify_changed();
+}
+
+void PlotWaterfall::add_data(PlotDataWaterfall &data) {
+  //ensure plot_data is empty
+  if (!plot_data.empty())
+    throw Exception("Gtk::PLplot::PlotWaterfall::add_data -> cannot add data when plot_data is not empty!");
+
+  //the cached image has one pixel per value, and Cairo cannot create images that are larger than this in either dimension
+  if (data.get_capacity() > PLOTWATERFALL_MAX_IMAGE_SIZE || data.get_data_y().size() > PLOTWATERFALL_MAX_IMAGE_SIZE)
+    throw Exception("Gtk::PLplot::PlotWaterfall::add_data -> the capacity and the number of Y-grid coordinates of the dataset cannot exceed 32767");
+
+  plot_data.push_back(&data);
+  data.signal_changed().connect([this](){notify_changed();});
+  data.signal_data_modified().connect([this](){notify_data_modified();});
+
+  _signal_data_added.emit(&data);
+}
+
+void PlotWaterfall::set_range_z(double _zmin, double _zmax) {
+  if (!(_zmax > _zmin)) {
+    throw Exception("Gtk::PLplot::PlotWaterfall::set_range_z -> zmax must be greater than zmin");
+  }
+  if (_zmin == zmin && _zmax == zmax)
+    return;
+
+  zmin = _zmin;
+  zmax = _zmax;
+  for (unsigned int i = 0 ; i < nlevels ; i++) {
+    clevels[i] = zmin + (zmax - zmin) * i / (double) (nlevels - 1);
+  }
+  notify_changed();
+}
+
+void PlotWaterfall::get_range_z(double &_zmin, double &_zmax) {
+  _zmin = zmin;
+  _zmax = zmax;
+}
+
+void PlotWaterfall::set_nlevels(unsigned int _nlevels) {
+  if (_nlevels < 2) {
+    throw Exception("Gtk::PLplot::PlotWaterfall::set_nlevels -> nlevels must be greater than or equal to 2");
+  }
+
+  nlevels = _nlevels;
+  clevels.resize(nlevels);
+  for (unsigned int i = 0 ; i < nlevels ; i++) {
+    clevels[i] = zmin + (zmax - zmin) * i / (double) (nlevels - 1);
+  }
+  notify_changed();
+}
+
+unsigned int PlotWaterfall::get_nlevels() {
+  return nlevels;
+}
+
+void PlotWaterfall::set_colormap_palette(ColormapPalette _colormap_palette) {
+  if (_colormap_palette == colormap_palette)
+    return;
+  colormap_palette = _colormap_palette;
+  notify_changed();
+}
+
+ColormapPalette PlotWaterfall::get_colormap_palette() {
+  return colormap_palette;
+}
+
+void PlotWaterfall::show_colorbar() {
+  if (showing_colorbar)
+    return;
+  showing_colorbar = true;
+  notify_changed();
+}
+
+void PlotWaterfall::hide_colorbar() {
+  if (!showing_colorbar)
+    return;
+  showing_colorbar = false;
+  notify_changed();
+}
+
+bool PlotWaterfall::is_showing_colorbar() {
+  return showing_colorbar;
+}
+
+void PlotWaterfall::set_colorbar_title(Glib::ustring _colorbar_title) {
+  if (_colorbar_title == colorbar_title)
+    return;
+  colorbar_title = _colorbar_title;
+  notify_changed();
+}
+
+Glib::ustring PlotWaterfall::get_colorbar_title() {
+  return colorbar_title;
+}
+
+void PlotWaterfall::draw_plot(const Cairo::RefPtr<Cairo::Context> &cr, const int width, const int height) {
+  if (!shown)
+    return;
+
+  draw_plot_init(cr, width, height);
+
+  pls->adv(0);
+  pls->vpor(0.1, 0.9, 0.1, 0.9);
+  pls->wind(plotted_range_x[0], plotted_range_x[1],
+            plotted_range_y[0], plotted_range_y[1]);
+
+  //set the label color
+  change_plstream_color(pls, titles_color);
+
+  //draw the labels
+  pls->lab(axis_title_x.c_str(), axis_title_y.c_str(), plot_title.c_str());
+
+  //draw the actual plot
+  change_plstream_colormap(pls, colormap_palette);
+
+  draw_image(cr);
+
+  //draw colorbar if requested
+  if (showing_colorbar)
+    draw_colorbar(cr, pls);
+
+  //plot the box with its axes
+  change_plstream_color(pls, axes_color);
+  pls->box("bcnst", 0.0, 0, "bcnstv", 0.0, 0);
+
+  cr->restore();
+
+  coordinate_transform_plplot_to_cairo(plotted_range_x[0], plotted_range_y[0],
+                                      cairo_range_x[0], cairo_range_y[0]);
+  coordinate_transform_plplot_to_cairo(plotted_range_x[1], plotted_range_y[1],
+                                      cairo_range_x[1], cairo_range_y[1]);
+}
+
+void PlotWaterfall::draw_image(const Cairo::RefPtr<Cairo::Context> &cr) {
+  auto data = dynamic_cast<PlotDataWaterfall*>(plot_data[0]);
+  const std::vector<double> &y = data->get_data_y();
+  const std::size_t capacity = data->get_capacity();
+  const std::size_t sequence = data->get_sequence();
+  const std::size_t oldest = sequence - data->get_size();
+
+  if (sequence == 0)
+    return;
+
+  const std::vector<double> key = {
+    zmin, zmax, static_cast<double>(nlevels), static_cast<double>(colormap_palette)
+  };
+
+  //the image is stored transposed, just like the dataset: each of its rows holds the pixels of one row of Z-values,
+  //and row s of the dataset is found in row s % capacity of the image. Rows that are already in the image never need to be rendered again.
+  std::size_t first = std::max(image_sequence, oldest);
+
+  if (!image || key != image_key || image_sequence > sequence) {
+    image = Cairo::ImageSurface::create(Cairo::FORMAT_ARGB32, y.size(), capacity);
+    image_key = key;
+    first = oldest;
+  }
+
+  if (first < sequence) {
+    //the same colors as the colorbar, which PLplot picks from the palette loaded by change_plstream_colormap()
+    const std::vector<uint32_t> lut = cmap1_lookup_table(colormap_palette, nlevels - 1);
+
+    image->flush();
+    unsigned char *image_data = image->get_data();
+    const int stride = image->get_stride();
+
+    for (std::size_t s = first ; s < sequence ; s++) {
+      const double *values = data->get_row(s);
+      uint32_t *row = reinterpret_cast<uint32_t *>(image_data + (s % capacity) * stride);
+      map_values_to_shades(values, y.size(), zmin, zmax, nlevels, lut, row);
+    }
+
+    image->mark_dirty();
+  }
+  image_sequence = sequence;
+
+  //the plot window, in the coordinates of cr, which has been translated to the top left corner of the plot by draw_plot_init()
+  double nxmin, nxmax, nymin, nymax;
+  double wxmin, wxmax, wymin, wymax;
+  pls->gvpd(nxmin, nxmax, nymin, nymax);
+  pls->gvpw(wxmin, wxmax, wymin, wymax);
+
+  const double left = plot_width * nxmin;
+  const double right = plot_width * nxmax;
+  const double top = plot_height * (1.0 - nymax);
+  const double bottom = plot_height * (1.0 - nymin);
+
+  //the mapping from world coordinates to those of cr
+  const double ax = (right - left) / (wxmax - wxmin);
+  const double bx = left - wxmin * ax;
+  const double ay = -(bottom - top) / (wymax - wymin);
+  const double by = top + wymax * (bottom - top) / (wymax - wymin);
+
+  const double step = data->get_x_step();
+  const double dy = (y.back() - y.front()) / (y.size() - 1);
+
+  cr->save();
+  cr->rectangle(left, top, right - left, bottom - top);
+  cr->clip();
+
+  auto pattern = Cairo::SurfacePattern::create(image);
+  pattern->set_filter(Cairo::FILTER_NEAREST);
+
+  //the retained rows occupy at most two pieces of the image: the oldest ones up to its last row, followed by the newest ones from its first row on
+  for (std::size_t s = oldest ; s < sequence ; ) {
+    const std::size_t row_first = s % capacity;
+    const std::size_t count = std::min(sequence - s, capacity - row_first);
+    //the row of the dataset that would be found in the first row of the image
+    const std::size_t base = s - row_first;
+
+    cr->save();
+    cairo_matrix_t matrix;
+    cairo_matrix_init(&matrix, 0.0, ay * dy, ax * step, 0.0,
+                      ax * (data->get_row_x(base) - 0.5 * step) + bx,
+                      ay * (y.front() - 0.5 * dy) + by);
+    cairo_transform(cr->cobj(), &matrix);
+    cr->set_source(pattern);
+    cr->rectangle(0.0, row_first, y.size(), count);
+    cr->fill();
+    cr->restore();
+
+    s += count;
+  }
+
+  cr->restore();
+}
+
+void PlotWaterfall::draw_colorbar(
+  const Cairo::RefPtr<Cairo::Context> &cr,
+  plstream *pls) {
+
+  pls->psty(SOLID);
+
+  //the image has no edges between its shades, so neither has the colorbar
+  draw_plstream_colorbar(pls, colormap_palette, axes_color, clevels, colorbar_title, false, 0, 0.0);
+}
@@ -0,0 +1,227 @@
+/*
+Copyright (C) 2016 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GTKMMPLPLOT_PLOT_WATERFALL_H
+#define GTKMMPLPLOT_PLOT_WATERFALL_H
+
+#include <gtkmm-plplot/plot.h>
+#include <gtkmm-plplot/regionselection.h>
+#include <gtkmm-plplot/plotdatawaterfall.h>
+#include <gtkmm-plplot/enums.h>
+
+namespace Gtk {
+  namespace PLplot {
+    /** \class PlotWaterfall plotwaterfall.h <gtkmm-plplot/plotwaterfall.h>
+     *  \brief a class for scrolling waterfall plots, such as spectrograms
+     *
+     *  A class for plotting the rows of a PlotDataWaterfall dataset as a raster image that scrolls along the X-axis as new rows come in.
+     *  Construction requires a single PlotDataWaterfall dataset, and no datasets may be added afterwards.
+     *  As the cached image holds one pixel per value, neither the capacity of the dataset nor its number of Y-grid coordinates may exceed 32767, the largest image size supported by Cairo.
+     *  Each row is mapped onto the colormap palette once, when it is first drawn, and stored in a cached image that is used as a circular buffer just like the dataset itself:
+     *  redrawing the plot after a row has been pushed therefore only requires that one row to be rendered, after which the image is painted in at most two pieces.
+     *  The Z-range of the colormap is fixed, and is set at construction time or with set_range_z(), ensuring that incoming rows never require the image to be rendered again.
+     *  The plotted X-range covers the full capacity of the dataset, ending at its most recent row.
+     *  After zooming in, the plotted range no longer follows the incoming rows, until it is reset to the full range of the data by double-clicking.
+     *  Important is that whenever a property is changed, \c signal_changed() is emitted, which will eventually
+     *  be picked up by the \c canvas that will hold the plot.
+     */
+    class PlotWaterfall : public Plot, public RegionSelection {
+    private:
+      PlotWaterfall() = delete; ///< no default constructor
+      PlotWaterfall(const PlotWaterfall &) = delete; ///< no copy constructor
+      PlotWaterfall &operator=(const PlotWaterfall &) = delete; ///< no assignment operator
+
+      /** Render the rows that are missing from the cached image, and paint it onto the plot window
+       *
+       * \param cr the cairo context to draw to.
+       */
+      void draw_image(const Cairo::RefPtr<Cairo::Context> &cr);
+    protected:
+      double zmin; ///< the Z-value that is mapped onto the start of the colormap palette
+      double zmax; ///< the Z-value that is mapped onto the end of the colormap palette
+      unsigned int nlevels; ///< the number of edges of the shades the colormap palette is divided into
+      std::vector<double> clevels; ///< the edges of the shades, spread evenly between \c zmin and \c zmax, as shown by the colorbar
+      ColormapPalette colormap_palette; ///< The colormap that will be used to render the rows.
+      bool showing_colorbar; ///< \c true will draw a colorbar, \c false will not.
+      Glib::ustring colorbar_title; ///< the title of the colorbar
+      Cairo::RefPtr<Cairo::ImageSurface> image; ///< the cached image, which holds one row of pixels for each row of the dataset, at the same position of the circular buffer
+      std::vector<double> image_key; ///< the Z-range, levels and palette \c image was rendered with
+      std::size_t image_sequence; ///< the number of rows of the dataset that have been rendered into \c image
+
+      virtual void plot_data_modified() override; ///< a method that will update the \c _range variables when datasets are added, modified or removed.
+
+      /** Constructor
+       *
+       * This protected constructor is meant to be used in derived classes only to circumvent the problem of calling add_data() in a constructor which calls PlotWaterfall's public constructor.
+       * \param zmin the Z-value that is mapped onto the start of the colormap palette
+       * \param zmax the Z-value that is mapped onto the end of the colormap palette
+       * \param axis_title_x X-axis title
+       * \param axis_title_y Y-axis title
+       * \param plot_title plot title
+       * \param nlevels the number of edges of the shades the colormap palette is divided into
+       * \param colormap_palette the colormap palette that will be used to render the rows
+       * \param plot_width_norm the normalized plot width, calculated relative to the canvas width
+       * \param plot_height_norm the normalized plot height, calculated relative to the canvas height
+       * \param plot_offset_horizontal_norm the normalized horizontal offset from the canvas top left corner, calculated relative to the canvas width
+       * \param plot_offset_vertical_norm the normalized vertical offset from the canvas top left corner, calculated relative to the canvas height
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotWaterfall(double zmin,
+                    double zmax,
+                    const Glib::ustring &axis_title_x,
+                    const Glib::ustring &axis_title_y,
+                    const Glib::ustring &plot_title,
+                    unsigned int nlevels,
+                    ColormapPalette colormap_palette,
+                    const double plot_width_norm,
+                    const double plot_height_norm,
+                    const double plot_offset_horizontal_norm,
+                    const double plot_offset_vertical_norm);
+
+      /** Add a single PlotDataWaterfall dataset to the plot
+       *
+       * \param data dataset to be added to the plot
+       * \exception Gtk::PLplot::Exception
+       */
+      virtual void add_data(PlotDataWaterfall &data);
+    public:
+      /** Constructor
+       *
+       * This class provides a single public constructor, which takes an existing PlotDataWaterfall dataset to construct a plot.
+       * Optionally, the constructor takes additional arguments to set the axes and plot titles, as well as normalized coordinates that will determine the position and dimensions of the plot within the canvas.
+       * The default corresponds to the plot taking up the full canvas space.
+       * \param data a PlotDataWaterfall object containing a plot dataset, with a capacity and a number of Y-grid coordinates of at most 32767
+       * \param zmin the Z-value that is mapped onto the start of the colormap palette
+       * \param zmax the Z-value that is mapped onto the end of the colormap palette
+       * \param axis_title_x X-axis title
+       * \param axis_title_y Y-axis title
+       * \param plot_title plot title
+       * \param nlevels the number of edges of the shades the colormap palette is divided into
+       * \param colormap_palette the colormap palette that will be used to render the rows
+       * \param plot_width_norm the normalized plot width, calculated relative to the canvas width
+       * \param plot_height_norm the normalized plot height, calculated relative to the canvas height
+       * \param plot_offset_horizontal_norm the normalized horizontal offset from the canvas top left corner, calculated relative to the canvas width
+       * \param plot_offset_vertical_norm the normalized vertical offset from the canvas top left corner, calculated relative to the canvas height
+       * \exception Gtk::PLplot::Exception
+       */
+      PlotWaterfall(PlotDataWaterfall &data,
+                    double zmin,
+                    double zmax,
+                    const Glib::ustring &axis_title_x = "X-axis",
+                    const Glib::ustring &axis_title_y = "Y-axis",
+                    const Glib::ustring &plot_title = "",
+                    unsigned int nlevels = 65,
+                    ColormapPalette colormap_palette = BLUE_YELLOW,
+                    const double plot_width_norm = 1.0,
+                    const double plot_height_norm = 1.0,
+                    const double plot_offset_horizontal_norm = 0.0,
+                    const double plot_offset_vertical_norm = 0.0);
+
+      /** Destructor
+       *
+       */
+      virtual ~PlotWaterfall();
+
+      /** Changes the Z-range that is mapped onto the colormap palette
+       *
+       * Values outside of this range get the color of the nearest end of the palette. Changing the range requires all rows to be rendered again.
+       * \param zmin the Z-value that is mapped onto the start of the colormap palette
+       * \param zmax the Z-value that is mapped onto the end of the colormap palette
+       * \exception Gtk::PLplot::Exception
+       */
+      void set_range_z(double zmin, double zmax);
+
+      /** Get the Z-range that is mapped onto the colormap palette
+       *
+       * \param zmin the Z-value that is mapped onto the start of the colormap palette
+       * \param zmax the Z-value that is mapped onto the end of the colormap palette
+       */
+      void get_range_z(double &zmin, double &zmax);
+
+      /** Sets the number of edges of the shades the colormap palette is divided into
+       *
+       * \param nlevels The new number of levels, which must be at least 2
+       * \exception Gtk::PLplot::Exception
+       */
+      void set_nlevels(unsigned int nlevels);
+
+      /** Get the number of edges of the shades the colormap palette is divided into
+       *
+       * \returns The number of levels
+       */
+      unsigned int get_nlevels();
+
+      /** Changes the colormap palette
+       *
+       * \param colormap The new colormap palette
+       */
+      void set_colormap_palette(ColormapPalette colormap);
+
+      /** Get the current colormap palette
+       *
+       * \returns the current colormap palette
+       */
+      ColormapPalette get_colormap_palette();
+
+      /** Show the colorbar
+       *
+       */
+      void show_colorbar();
+
+      /** Hides the colorbar
+       *
+       */
+      void hide_colorbar();
+
+      /** Returns whether or not the colorbar is currently showing
+       *
+       */
+      bool is_showing_colorbar();
+
+      /** Set the colorbar title
+       *
+       */
+      void set_colorbar_title(Glib::ustring colorbar_title);
+
+      /** Get the currently used colorbar title
+       *
+       */
+      Glib::ustring get_colorbar_title();
+
+      /** Method to draw the colorbar
+       *
+       * This method is virtual allowing inheriting classes to implement their own method with the same signature.
+       * \param cr the cairo context to draw to.
+       * \param pls the PLplot plstream object that will do the actual plotting on the Cairo context
+       */
+      virtual void draw_colorbar(const Cairo::RefPtr<Cairo::Context> &cr, plstream *pls);
+
+      /** Method to draw the plot with all of its datasets
+       *
+       * This method is virtual allowing inheriting classes to implement their own method with the same signature.
+       * \param cr the cairo context to draw to.
+       * \param width the width of the Canvas widget
+       * \param height the height of the Canvas widget
+       */
+      virtual void draw_plot(const Cairo::RefPtr<Cairo::Context> &cr, const int width, const int height) override;
+
+      friend class Canvas;
+    };
+  }
+}
+
+#endif
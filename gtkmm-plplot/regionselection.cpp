@@ -29,6 +29,9 @@ RegionSelection::RegionSelection() :
   region_zoom_scale_factor(2.0),
   region_selection_color(Gdk::RGBA("Black")),
   region_selection_width(2.0),
+  region_crosshair(false),
+  region_crosshair_color(Gdk::RGBA("Black")),
+  region_crosshair_width(1.0),
   plotted_range_x{0.1, 1.0},
   plotted_range_y{0.1, 1.0},
   plot_data_range_x{0.1, 1.0},
@@ -246,6 +249,33 @@ void RegionSelection::set_region_selection_width(double _region_selection_width)
   region_selection_width = _region_selection_width;
 }
 
+bool RegionSelection::get_region_crosshair() {
+  return region_crosshair;
+}
+
+void RegionSelection::set_region_crosshair(bool _region_crosshair) {
+  region_crosshair = _region_crosshair;
+}
+
+Gdk::RGBA RegionSelection::get_region_crosshair_color() {
+  return region_crosshair_color;
+}
+
+void RegionSelection::set_region_crosshair_color(Gdk::RGBA _region_crosshair_color) {
+  region_crosshair_color = _region_crosshair_color;
+}
+
+double RegionSelection::get_region_crosshair_width() {
+  return region_crosshair_width;
+}
+
+void RegionSelection::set_region_crosshair_width(double _region_crosshair_width) {
+  if (_region_crosshair_width <= 0.0) {
+    throw Exception("Gtk::PLplot::RegionSelection::set_region_crosshair_width -> invalid width provided");
+  }
+  region_crosshair_width = _region_crosshair_width;
+}
+
 void RegionSelection::coordinate_transform_plplot_to_cairo(
   double x_pl, double y_pl,
   double &x_cr, double &y_cr) {
@@ -357,5 +387,5 @@ void RegionSelection::set_region(double xmin, double xmax, double ymin, double y
   plotted_range_y[0] = ymin;
   plotted_range_y[1] = ymax;
 
-  dynamic_cast<Plot *>(this)->signal_changed().emit();
+  dynamic_cast<Plot *>(this)->notify_changed();
 }
@@ -54,6 +54,9 @@ namespace Gtk {
       double region_zoom_scale_factor; ///< scale factor that will be used for scroll wheel based zooming
       Gdk::RGBA region_selection_color; ///< color that will be used to draw the selection box
       double region_selection_width; ///< width of the selection box frame
+      bool region_crosshair; ///< \c true indicates that a crosshair will follow the cursor when it is moved within the plot box, \c false means no crosshair will be drawn. The default is \c false
+      Gdk::RGBA region_crosshair_color; ///< color that will be used to draw the crosshair
+      double region_crosshair_width; ///< width of the crosshair lines
     protected:
       double cairo_range_x[2]; ///< the current range shown on the plot for the X-axis in Cairo coordinates
       double cairo_range_y[2]; ///< the current range shown on the plot for the Y-axis in Cairo coordinates
@@ -314,6 +317,52 @@ namespace Gtk {
        */
       void set_region_selection_width(double line_width);
 
+      /** Get whether a crosshair follows the cursor within the plot box
+       *
+       * The crosshair is drawn by the Canvas on top of the plot and does not require the plot to be redrawn.
+       * \return \c true if a crosshair is drawn, \c false if not
+       * \since 2.4
+       */
+      bool get_region_crosshair();
+
+      /** Sets whether a crosshair follows the cursor within the plot box
+       *
+       * \param crosshair pass \c true if a crosshair has to be drawn, \c false if not
+       * \since 2.4
+       */
+      void set_region_crosshair(bool crosshair = true);
+
+      /** Gets the currently used crosshair color
+       *
+       * The default color is black
+       * \return the currently used crosshair color
+       * \since 2.4
+       */
+      Gdk::RGBA get_region_crosshair_color();
+
+      /** Sets the crosshair color
+       *
+       * \param color the new crosshair color
+       * \since 2.4
+       */
+      void set_region_crosshair_color(Gdk::RGBA color);
+
+      /** Gets the currently used crosshair line width
+       *
+       * The default width is 1.0
+       * \return the currently used crosshair line width
+       * \since 2.4
+       */
+      double get_region_crosshair_width();
+
+      /** Sets the crosshair line width
+       *
+       * \param line_width the new crosshair line width
+       * \exception Gtk::PLplot::Exception
+       * \since 2.4
+       */
+      void set_region_crosshair_width(double line_width);
+
       /** Get whether plotdata can be panned on the plot by clicking the left mouse button and the shift key
        *
        * \return \c true if plotdate is draggable in the plot, \c false if not
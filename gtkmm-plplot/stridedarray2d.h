@@ -0,0 +1,75 @@
+/*
+Copyright (C) 2016 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GTKMM_PLPLOT_STRIDED_ARRAY_2D_H
+#define GTKMM_PLPLOT_STRIDED_ARRAY_2D_H
+
+#include <cstddef>
+
+namespace Gtk {
+  namespace PLplot {
+    /** \class StridedArray2D stridedarray2d.h <gtkmm-plplot/stridedarray2d.h>
+     *  \brief a read-only view on a two-dimensional array of doubles with an arbitrary memory layout
+     *
+     *  The rows of the array are found through a table of pointers, and the elements within each row are separated by a fixed stride,
+     *  which makes it possible to read row-major, column-major and padded buffers in place. An ordinary array of arrays has a column stride of 1,
+     *  and converts implicitly to this class. Instances do not own any memory, and are cheap to copy.
+     *  The element accessor is defined in this header, allowing it to be inlined in the loops that read entire grids.
+     */
+    class StridedArray2D {
+    protected:
+      const double * const *rows; ///< the table with pointers to the first element of each row
+      std::size_t column_stride; ///< the distance, in elements, between consecutive elements of a row
+    public:
+      /** Constructor
+       *
+       * \param rows the table with pointers to the first element of each row, which must remain valid for as long as the view is used
+       * \param column_stride the distance, in elements, between consecutive elements of a row
+       */
+      StridedArray2D(const double * const *rows, std::size_t column_stride = 1) :
+        rows(rows), column_stride(column_stride) {}
+
+      /** Get an element of the array
+       *
+       * \param i the index along the first dimension
+       * \param j the index along the second dimension
+       * \returns the element
+       */
+      double operator()(std::size_t i, std::size_t j) const {
+        return rows[i][j * column_stride];
+      }
+
+      /** Get the table with pointers to the first element of each row
+       *
+       * \returns the table
+       */
+      const double * const *get_rows() const {
+        return rows;
+      }
+
+      /** Get the distance between consecutive elements of a row
+       *
+       * \returns the distance, in elements
+       */
+      std::size_t get_column_stride() const {
+        return column_stride;
+      }
+    };
+  }
+}
+
+#endif
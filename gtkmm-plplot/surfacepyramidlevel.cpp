@@ -0,0 +1,111 @@
+/*
+Copyright (C) 2016 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtkmm-plplot/surfacepyramidlevel.h>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+using namespace Gtk::PLplot;
+
+// the coordinates of each block of (at most) two consecutive grid points are their mean
+static std::vector<double> reduce_coordinates(const std::vector<double> &finer) {
+  std::vector<double> rv((finer.size() + 1) / 2);
+  for (std::size_t i = 0 ; i < rv.size() ; i++) {
+    if (2 * i + 1 < finer.size())
+      rv[i] = (finer[2 * i] + finer[2 * i + 1]) / 2.0;
+    else
+      rv[i] = finer[2 * i];
+  }
+  return rv;
+}
+
+SurfacePyramidLevel::SurfacePyramidLevel(const std::vector<double> &_x,
+                                         const std::vector<double> &_y,
+                                         const std::vector<const double *> &_z_rows,
+                                         std::size_t _column_stride) :
+  x(_x), y(_y), z_rows(_z_rows), column_stride(_column_stride) {}
+
+SurfacePyramidLevel::SurfacePyramidLevel(const SurfacePyramidLevel &finer, PyramidReduction reduction) :
+  x(reduce_coordinates(finer.x)),
+  y(reduce_coordinates(finer.y)),
+  z(x.size() * y.size()),
+  z_rows(x.size()),
+  column_stride(1) {
+
+  for (std::size_t i = 0 ; i < x.size() ; i++)
+    z_rows[i] = z.data() + i * y.size();
+
+  std::size_t ix0 = 0, iy0 = 0, ix1 = finer.x.size(), iy1 = finer.y.size();
+  reduce_region(finer, reduction, ix0, iy0, ix1, iy1);
+}
+
+void SurfacePyramidLevel::reduce_region(const SurfacePyramidLevel &finer, PyramidReduction reduction,
+                                        std::size_t &ix0, std::size_t &iy0, std::size_t &ix1, std::size_t &iy1) {
+  //the blocks containing the modified grid points
+  ix0 /= 2;
+  iy0 /= 2;
+  ix1 = std::min((ix1 + 1) / 2, x.size());
+  iy1 = std::min((iy1 + 1) / 2, y.size());
+
+  const std::size_t finer_nx = finer.x.size();
+  const std::size_t finer_ny = finer.y.size();
+  const StridedArray2D finer_z = finer.get_data_z();
+
+  for (std::size_t i = ix0 ; i < ix1 ; i++) {
+    double *row = z.data() + i * y.size();
+    for (std::size_t j = iy0 ; j < iy1 ; j++) {
+      double sum = 0.0;
+      double min = std::numeric_limits<double>::infinity();
+      double max = -std::numeric_limits<double>::infinity();
+      unsigned int n = 0;
+
+      for (std::size_t fi = 2 * i ; fi < std::min(2 * i + 2, finer_nx) ; fi++) {
+        for (std::size_t fj = 2 * j ; fj < std::min(2 * j + 2, finer_ny) ; fj++) {
+          const double value = finer_z(fi, fj);
+          if (std::isnan(value))
+            continue;
+          sum += value;
+          min = std::min(min, value);
+          max = std::max(max, value);
+          n++;
+        }
+      }
+
+      if (n == 0)
+        row[j] = std::numeric_limits<double>::quiet_NaN();
+      else if (reduction == PYRAMID_MIN)
+        row[j] = min;
+      else if (reduction == PYRAMID_MAX)
+        row[j] = max;
+      else
+        row[j] = sum / n;
+    }
+  }
+}
+
+const std::vector<double> &SurfacePyramidLevel::get_data_x() const {
+  return x;
+}
+
+const std::vector<double> &SurfacePyramidLevel::get_data_y() const {
+  return y;
+}
+
+StridedArray2D SurfacePyramidLevel::get_data_z() const {
+  return StridedArray2D(z_rows.data(), column_stride);
+}
@@ -0,0 +1,101 @@
+/*
+Copyright (C) 2016 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GTKMM_PLPLOT_SURFACE_PYRAMID_LEVEL_H
+#define GTKMM_PLPLOT_SURFACE_PYRAMID_LEVEL_H
+
+#include <gtkmm-plplot/enums.h>
+#include <gtkmm-plplot/stridedarray2d.h>
+#include <vector>
+#include <cstddef>
+
+namespace Gtk {
+  namespace PLplot {
+    /** \class SurfacePyramidLevel surfacepyramidlevel.h <gtkmm-plplot/surfacepyramidlevel.h>
+     *  \brief a single level of the display-resolution pyramid of a PlotDataSurface
+     *
+     *  Level 0 of the pyramid is a view on the Z-values of the dataset itself. Every next level combines blocks of 2 by 2 grid points of the previous one
+     *  into a single grid point, whose coordinates are the mean of those of the block, and whose Z-value is the mean, minimum or maximum of theirs, ignoring NaN.
+     *  Plots use the coarsest level that still has at least one grid point per device pixel, saving them from contouring or shading detail that cannot be seen.
+     *  Instances of this class are created and kept up to date by PlotDataSurface, and are obtained through PlotDataSurface::get_pyramid_level().
+     */
+    class SurfacePyramidLevel {
+    private:
+      SurfacePyramidLevel(const SurfacePyramidLevel &) = delete; ///< no copy constructor
+      SurfacePyramidLevel &operator=(const SurfacePyramidLevel &) = delete; ///< no assignment operator
+    protected:
+      std::vector<double> x; ///< the X-grid coordinates
+      std::vector<double> y; ///< the Y-grid coordinates
+      std::vector<double> z; ///< the Z-values, stored contiguously, or empty if this level is a view on the dataset
+      std::vector<const double *> z_rows; ///< a table with pointers to the start of each row of the Z-values
+      std::size_t column_stride; ///< the distance, in elements, between consecutive Z-values of a row, which is 1 unless this level is a view on a strided dataset
+    public:
+      /** Constructor
+       *
+       * Creates level 0 of a pyramid, which is a view on the Z-values of a dataset.
+       * \param x the X-grid coordinates of the dataset
+       * \param y the Y-grid coordinates of the dataset
+       * \param z_rows the table of pointers to the rows of the Z-values of the dataset
+       * \param column_stride the distance, in elements, between consecutive Z-values of a row of the dataset
+       */
+      SurfacePyramidLevel(const std::vector<double> &x,
+                          const std::vector<double> &y,
+                          const std::vector<const double *> &z_rows,
+                          std::size_t column_stride = 1);
+
+      /** Constructor
+       *
+       * Creates the level that follows \c finer in a pyramid.
+       * \param finer the previous level of the pyramid
+       * \param reduction how the Z-values of each block of grid points are combined
+       */
+      SurfacePyramidLevel(const SurfacePyramidLevel &finer, PyramidReduction reduction);
+
+      /** Recalculate the grid points that depend on a rectangle of modified grid points of the previous level
+       *
+       * \param finer the previous level of the pyramid
+       * \param reduction how the Z-values of each block of grid points are combined
+       * \param ix0 the first index of the rectangle along the first dimension of \c finer. Will be set to the first index of the affected rectangle of this level.
+       * \param iy0 the first index of the rectangle along the second dimension of \c finer. Will be set to the first index of the affected rectangle of this level.
+       * \param ix1 one past the last index of the rectangle along the first dimension of \c finer. Will be set to one past the last index of the affected rectangle of this level.
+       * \param iy1 one past the last index of the rectangle along the second dimension of \c finer. Will be set to one past the last index of the affected rectangle of this level.
+       */
+      void reduce_region(const SurfacePyramidLevel &finer, PyramidReduction reduction,
+                         std::size_t &ix0, std::size_t &iy0, std::size_t &ix1, std::size_t &iy1);
+
+      /** Get read-only access to the X-grid coordinates
+       *
+       * \returns a reference to the X-grid coordinates
+       */
+      const std::vector<double> &get_data_x() const;
+
+      /** Get read-only access to the Y-grid coordinates
+       *
+       * \returns a reference to the Y-grid coordinates
+       */
+      const std::vector<double> &get_data_y() const;
+
+      /** Get read-only access to the Z-values
+       *
+       * \returns the Z-values, as an array of get_data_x().size() by get_data_y().size() elements
+       */
+      StridedArray2D get_data_z() const;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,75 @@
+/*
+Copyright (C) 2015 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GTKMMPLPLOT_UPDATE_GUARD_H
+#define GTKMMPLPLOT_UPDATE_GUARD_H
+
+#include <exception>
+#include <glib.h>
+
+namespace Gtk {
+  namespace PLplot {
+    /** \class UpdateGuard updateguard.h <gtkmm-plplot/updateguard.h>
+     *  \brief freezes updates of a Canvas, Plot or PlotData for as long as it is in scope
+     *
+     *  The constructor calls \c freeze_updates() on the instance it was passed, while the destructor calls the matching \c thaw_updates().
+     *  This ensures that all changes made within a scope result in a single update, and that updates are thawed even if an exception is thrown along the way.
+     *  Since destructors must not throw, an exception thrown by the postponed updates themselves is caught and reported with \c g_warning().
+     *  Call \c thaw_updates() explicitly instead of relying on the guard if such exceptions need to be handled.
+     *  \code
+     *  {
+     *    Gtk::PLplot::UpdateGuard<Gtk::PLplot::PlotData2D> guard(data);
+     *    for (int i = 0 ; i < 10000 ; i++)
+     *      data.add_datapoint(i, i * i);
+     *  } // the plot ranges are updated here, followed by a single redraw
+     *  \endcode
+     */
+    template <class T>
+    class UpdateGuard {
+    private:
+      T &object; ///< the instance whose updates are frozen
+      UpdateGuard(const UpdateGuard &) = delete; ///< no copy constructor
+      UpdateGuard &operator=(const UpdateGuard &) = delete; ///< no assignment operator
+    public:
+      /** Constructor
+       *
+       * \param _object the Canvas, Plot or PlotData instance whose updates will be frozen
+       */
+      explicit UpdateGuard(T &_object) : object(_object) {
+        object.freeze_updates();
+      }
+
+      /** Destructor
+       *
+       * Thaws the updates, which will trigger the postponed signals when this is the outermost guard.
+       * Exceptions thrown while doing so are caught, and reported as warnings.
+       */
+      ~UpdateGuard() {
+        try {
+          object.thaw_updates();
+        }
+        catch (std::exception &e) {
+          g_warning("Exception caught when thawing updates: %s", e.what());
+        }
+        catch (...) {
+          g_warning("Exception caught when thawing updates!");
+        }
+      }
+    };
+  }
+}
+#endif
@@ -19,7 +19,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <string>
 #include <cstdlib>
 #include <cstring>
+#include <cstdio>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <mutex>
 #include <plstream.h>
+#include <cmath>
+#include <glib.h>
+
+#define UTILS_CMAP1_NCOLORS 128
+#define UTILS_SHADES_CHUNK_SIZE 256
 
 static std::vector<Glib::ustring> _colormaps = {
   "cmap1_default.pal",
@@ -51,8 +62,178 @@ void Gtk::PLplot::change_plstream_color(plstream *pls, Gdk::RGBA color, bool act
     pls->col0(index);
 }
 
+namespace {
+  //the colors of a cmap1 palette, in the form accepted by plscmap1a()
+  struct Cmap1Colors {
+    std::vector<PLINT> r;
+    std::vector<PLINT> g;
+    std::vector<PLINT> b;
+    std::vector<PLFLT> a;
+  };
+
+  //a control point of a palette file, with the color in HLS space
+  struct Cmap1ControlPoint {
+    double pos;
+    double h;
+    double l;
+    double s;
+    double a;
+    bool alt_hue_path;
+  };
+}
+
+static std::map<Gtk::PLplot::ColormapPalette, Cmap1Colors> _cmap1_colors;
+static std::mutex _cmap1_colors_mutex;
+
+//look for a palette file in the same places as PLplot does
+static bool open_palette_file(const std::string &filename, std::ifstream &file) {
+  std::vector<std::string> dirs;
+  const char *dir;
+  if ((dir = std::getenv("PLPLOT_LIB")) != nullptr)
+    dirs.push_back(std::string(dir) + "/");
+  dirs.push_back("");
+  if ((dir = std::getenv("PLPLOT_HOME")) != nullptr)
+    dirs.push_back(std::string(dir) + "/lib/");
+  dirs.push_back(GTKMM_PLPLOT_PLPLOT_DATA_DIR "/");
+
+  for (auto &dir : dirs) {
+    file.open(dir + filename);
+    if (file.is_open())
+      return true;
+    file.clear();
+  }
+  return false;
+}
+
+//parse a palette file, following the formats accepted by plspal1()
+static bool read_palette_file(const std::string &filename, std::vector<Cmap1ControlPoint> &points) {
+  std::ifstream file;
+  if (!open_palette_file(filename, file))
+    return false;
+
+  std::string line;
+  if (!std::getline(file, line))
+    return false;
+
+  //version 2 files start with a header, older ones contain RGB colors written as #rrggbb
+  bool version2 = false;
+  bool rgb = true;
+  if (line.compare(0, 3, "v2 ") == 0) {
+    version2 = true;
+    if (line.compare(3, 3, "hls") == 0)
+      rgb = false;
+    else if (line.compare(3, 3, "rgb") != 0)
+      return false;
+    if (!std::getline(file, line))
+      return false;
+  }
+
+  int npoints = 0;
+  if (!(std::istringstream(line) >> npoints) || npoints < 2)
+    return false;
+
+  points.resize(npoints);
+  for (auto &point : points) {
+    if (!std::getline(file, line))
+      return false;
+    double c1, c2, c3;
+    int alt_hue_path = 0;
+    if (version2) {
+      if (!(std::istringstream(line) >> point.pos >> c1 >> c2 >> c3 >> point.a >> alt_hue_path))
+        return false;
+    }
+    else {
+      unsigned int r, g, b;
+      if (std::sscanf(line.c_str(), "#%2x%2x%2x", &r, &g, &b) != 3)
+        return false;
+      std::istringstream stream(line.size() > 7 ? line.substr(7) : std::string());
+      if (!(stream >> point.pos))
+        return false;
+      stream >> alt_hue_path;
+      c1 = r / 255.0;
+      c2 = g / 255.0;
+      c3 = b / 255.0;
+      point.a = 1.0;
+    }
+    if (rgb) {
+      plrgbhls(c1, c2, c3, &point.h, &point.l, &point.s);
+    }
+    else {
+      point.h = c1;
+      point.l = c2;
+      point.s = c3;
+    }
+    point.alt_hue_path = alt_hue_path != 0;
+  }
+
+  if (points.front().pos != 0.0 || points.back().pos != 1.0)
+    return false;
+  for (std::size_t i = 1 ; i < points.size() ; i++)
+    if (points[i].pos < points[i - 1].pos)
+      return false;
+
+  return true;
+}
+
+//interpolate the control points the way plscmap1la() does
+static Cmap1Colors interpolate_palette(const std::vector<Cmap1ControlPoint> &points) {
+  Cmap1Colors colors;
+  colors.r.resize(UTILS_CMAP1_NCOLORS);
+  colors.g.resize(UTILS_CMAP1_NCOLORS);
+  colors.b.resize(UTILS_CMAP1_NCOLORS);
+  colors.a.resize(UTILS_CMAP1_NCOLORS);
+
+  for (int n = 0 ; n < UTILS_CMAP1_NCOLORS ; n++) {
+    const double pos = n / (double) (UTILS_CMAP1_NCOLORS - 1);
+    std::size_t i = 0;
+    while (i < points.size() - 2 && pos > points[i + 1].pos)
+      i++;
+    const Cmap1ControlPoint &p0 = points[i];
+    const Cmap1ControlPoint &p1 = points[i + 1];
+    const double dp = p1.pos - p0.pos;
+    const double delta = dp > 0.0 ? (pos - p0.pos) / dp : 0.0;
+
+    double dh = p1.h - p0.h;
+    if (p0.alt_hue_path)
+      dh += dh > 0.0 ? -360.0 : 360.0;
+    double h = p0.h + dh * delta;
+    while (h >= 360.0)
+      h -= 360.0;
+    while (h < 0.0)
+      h += 360.0;
+    const double l = p0.l + (p1.l - p0.l) * delta;
+    const double s = p0.s + (p1.s - p0.s) * delta;
+
+    double r, g, b;
+    plhlsrgb(h, l, s, &r, &g, &b);
+    colors.r[n] = std::max(0, std::min(255, (int) (256.0 * r)));
+    colors.g[n] = std::max(0, std::min(255, (int) (256.0 * g)));
+    colors.b[n] = std::max(0, std::min(255, (int) (256.0 * b)));
+    colors.a[n] = p0.a + (p1.a - p0.a) * delta;
+  }
+  return colors;
+}
+
+//the palettes are read once, and shared by all streams
+static const Cmap1Colors &get_cmap1_colors(Gtk::PLplot::ColormapPalette colormap) {
+  std::lock_guard<std::mutex> lock(_cmap1_colors_mutex);
+
+  auto iter = _cmap1_colors.find(colormap);
+  if (iter != _cmap1_colors.end())
+    return iter->second;
+
+  std::vector<Cmap1ControlPoint> points;
+  if (!read_palette_file(_colormaps[colormap], points)) {
+    g_warning("Gtk::PLplot::change_plstream_colormap -> could not read %s, using a gray scale instead", _colormaps[colormap].c_str());
+    points = {{0.0, 0.0, 0.0, 0.0, 1.0, false}, {1.0, 0.0, 1.0, 0.0, 1.0, false}};
+  }
+  return _cmap1_colors[colormap] = interpolate_palette(points);
+}
+
 void Gtk::PLplot::change_plstream_colormap(plstream *pls, Gtk::PLplot::ColormapPalette colormap) {
-  pls->spal1(_colormaps[colormap].c_str(), true);
+  //the palette is interpolated here rather than by plspal1(), so that cmap1_lookup_table() can pick exactly the same colors
+  const Cmap1Colors &colors = get_cmap1_colors(colormap);
+  pls->scmap1a(colors.r.data(), colors.g.data(), colors.b.data(), colors.a.data(), UTILS_CMAP1_NCOLORS);
 }
 
 double **Gtk::PLplot::deep_copy_array2d(double **input, int nx, int ny) {
@@ -71,6 +252,149 @@ void Gtk::PLplot::free_array2d(void **input, int nx) {
   free(input);
 }
 
+std::vector<std::uint32_t> Gtk::PLplot::cmap1_lookup_table(ColormapPalette colormap, unsigned int ncolors) {
+  const Cmap1Colors &colors = get_cmap1_colors(colormap);
+
+  std::vector<std::uint32_t> lut(ncolors + 1, 0);
+  for (unsigned int k = 0 ; k < ncolors ; k++) {
+    //same selection as plcol1()
+    const double position = ncolors > 1 ? k / (double) (ncolors - 1) : 0.0;
+    const int index = std::min<int>(position * UTILS_CMAP1_NCOLORS, UTILS_CMAP1_NCOLORS - 1);
+    const std::uint32_t alpha = std::lround(colors.a[index] * 255.0);
+    lut[k + 1] = alpha << 24 |
+                 (colors.r[index] * alpha / 255) << 16 |
+                 (colors.g[index] * alpha / 255) << 8 |
+                 (colors.b[index] * alpha / 255);
+  }
+  return lut;
+}
+
+//the element of the lookup table for a value, computed without branches so that the loops calling this function can be vectorized.
+//NaN fails both comparisons and ends up in the transparent element
+static inline std::int32_t shade_index(double value, double zmin, double inverse_step, double max_shade) {
+  double t = (value - zmin) * inverse_step;
+  t = t >= 0.0 ? t : (t < 0.0 ? 0.0 : -1.0);
+  t = t < max_shade ? t : max_shade;
+  return static_cast<std::int32_t>(t + 1.0);
+}
+
+void Gtk::PLplot::map_values_to_shades(const double *values, std::size_t n, double zmin, double zmax, unsigned int nlevels, const std::vector<std::uint32_t> &lut, std::uint32_t *pixels) {
+  //the levels are spread evenly between zmin and zmax, so finding the shade of a value takes only a multiplication
+  const double inverse_step = (nlevels - 1) / (zmax - zmin);
+  const double max_shade = nlevels - 2;
+  std::int32_t shades[UTILS_SHADES_CHUNK_SIZE];
+
+  //whole chunks: the shades are computed in a loop with a fixed trip count, which is vectorized with SIMD instructions,
+  //after which the colors are gathered from the lookup table
+  std::size_t first = 0;
+  for ( ; first + UTILS_SHADES_CHUNK_SIZE <= n ; first += UTILS_SHADES_CHUNK_SIZE) {
+    const double *chunk = values + first;
+#pragma omp simd
+    for (int c = 0 ; c < UTILS_SHADES_CHUNK_SIZE ; c++)
+      shades[c] = shade_index(chunk[c], zmin, inverse_step, max_shade);
+
+    for (int c = 0 ; c < UTILS_SHADES_CHUNK_SIZE ; c++)
+      pixels[first + c] = lut[shades[c]];
+  }
+
+  //the remaining values
+  for ( ; first < n ; first++)
+    pixels[first] = lut[shade_index(values[first], zmin, inverse_step, max_shade)];
+}
+
+void Gtk::PLplot::draw_plstream_colorbar(plstream *pls, ColormapPalette colormap, Gdk::RGBA color, const std::vector<double> &levels, const Glib::ustring &title,
+                                          bool shade_labels, int contour_color, double contour_width) {
+  change_plstream_colormap(pls, colormap);
+
+  change_plstream_color(pls, color, false, GTKMM_PLPLOT_DEFAULT_COLOR_INDEX);
+
+  // Smaller text
+  pls->schr(0.0, 0.75);
+  // Small ticks on the vertical axis
+  pls->smaj(0.0, 0.5);
+  pls->smin(0.0, 0.5);
+
+  const char *axis_opts[] = {
+    "bcvtm",
+  };
+  PLINT num_values[] = {
+    static_cast<PLINT>(levels.size()),
+  };
+  const double *values[] = {
+    levels.data(),
+  };
+  double axis_ticks[] = {
+    0.0,
+  };
+  PLINT axis_subticks[] = {
+    0,
+  };
+  double colorbar_width, colorbar_height;
+  PLINT label_opts[] = {
+    PL_COLORBAR_LABEL_BOTTOM,
+  };
+  const char *labels[] = {
+    title.c_str(),
+  };
+  pls->colorbar(
+    &colorbar_width,
+    &colorbar_height,
+    PL_COLORBAR_SHADE | (shade_labels ? PL_COLORBAR_SHADE_LABEL : 0), //options
+    0, //position
+    0.005, //X offset
+    0.0, //Y offset
+    0.0375, //X length
+    0.875, //Y length
+    0, //background color
+    0, //bounding box color
+    1, //bounding box style
+    0.0, //low end color bar cap
+    0.0, //high end color bar cap
+    contour_color, //contour color
+    contour_width, //contour width
+    1, //number of labels
+    label_opts,//label options
+    labels,//label text
+    1,//number of axes
+    axis_opts,//axes options
+    axis_ticks,//major tick mark spacings
+    axis_subticks,//number of subticks
+    num_values,//number of contour levels
+    values //contour levels
+  );
+
+  // Reset text and tick sizes
+  pls->schr( 0.0, 1.0 );
+  pls->smaj( 0.0, 1.0 );
+  pls->smin( 0.0, 1.0 );
+}
+
+void Gtk::PLplot::merge_grid_region(std::size_t region[4], std::size_t ix0, std::size_t iy0, std::size_t nx, std::size_t ny) {
+  if (region[0] >= region[2] || region[1] >= region[3]) {
+    region[0] = ix0;
+    region[1] = iy0;
+    region[2] = ix0 + nx;
+    region[3] = iy0 + ny;
+    return;
+  }
+  region[0] = std::min(region[0], ix0);
+  region[1] = std::min(region[1], iy0);
+  region[2] = std::max(region[2], ix0 + nx);
+  region[3] = std::max(region[3], iy0 + ny);
+}
+
+void Gtk::PLplot::pyramid_grid_region(const std::size_t region[4], unsigned int level, std::size_t level_region[4]) {
+  if (region[0] >= region[2] || region[1] >= region[3]) {
+    std::fill(level_region, level_region + 4, 0);
+    return;
+  }
+  //each level combines blocks of 2 by 2 grid points of the previous one
+  level_region[0] = region[0] >> level;
+  level_region[1] = region[1] >> level;
+  level_region[2] = ((region[2] - 1) >> level) + 1;
+  level_region[3] = ((region[3] - 1) >> level) + 1;
+}
+
 double **Gtk::PLplot::calloc_array2d(int nx, int ny) {
   double **rv= (double **) malloc(sizeof(double *) * nx);
   for (int i = 0 ; i < nx ; i++) {
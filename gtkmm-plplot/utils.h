@@ -24,7 +24,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #endif
 #include <vector>
 #include <valarray>
+#include <cstdint>
 #include <gdkmm/rgba.h>
+#include <glibmm/ustring.h>
 #include <gtkmm-plplot/enums.h>
 
 #define GTKMM_PLPLOT_DEFAULT_COLOR_INDEX 2
@@ -57,12 +59,52 @@ namespace Gtk {
 
     /** Changes the current colormap palette of the plstream
      *
-     * Convenience function that allows me to change PLplot's colormap palette for PlotDataContour
+     * Convenience function that allows me to change PLplot's colormap palette for PlotDataContour.
+     * The palette file is read once, from the same locations plspal1() searches, and the colormap is then set with plscmap1a().
      * \param pls a pointer to a plstream object
      * \param colormap the new colormap
      */
     void change_plstream_colormap(plstream *pls, ColormapPalette colormap);
 
+    /** Build a lookup table with the colors of a colormap palette
+     *
+     * The colors are picked from the palette as loaded by change_plstream_colormap(), the same way plshades() picks the colors of its shades, and are stored as premultiplied ARGB values,
+     * as used by Cairo::FORMAT_ARGB32 images. Element 0 of the table is transparent, and is meant for undefined values.
+     * \param colormap the colormap palette
+     * \param ncolors the number of colors to pick from the colormap
+     * \returns the lookup table, containing \c ncolors + 1 elements
+     */
+    std::vector<std::uint32_t> cmap1_lookup_table(ColormapPalette colormap, unsigned int ncolors);
+
+    /** Map Z-values onto the shades of a colormap palette, as premultiplied ARGB values
+     *
+     * The shades lie between \c nlevels edges that are spread evenly between \c zmin and \c zmax, and their colors are taken from a lookup table built by cmap1_lookup_table() with \c nlevels - 1 colors.
+     * Values outside of the range get the shade at the nearest end, while undefined values (NaN) become transparent.
+     * \param values the Z-values
+     * \param n the number of Z-values
+     * \param zmin the Z-value of the first edge
+     * \param zmax the Z-value of the last edge
+     * \param nlevels the number of edges
+     * \param lut the lookup table
+     * \param pixels the array that will receive the \c n colors
+     */
+    void map_values_to_shades(const double *values, std::size_t n, double zmin, double zmax, unsigned int nlevels, const std::vector<std::uint32_t> &lut, std::uint32_t *pixels);
+
+    /** Draw a vertical colorbar with the shades of a colormap palette, to the right of the current plot window
+     *
+     * The fill pattern should be selected beforehand with plpsty(), while the sizes of the text and the ticks are reset to their defaults afterwards.
+     * \param pls a pointer to a plstream object
+     * \param colormap the colormap palette of the shades
+     * \param color the color of the axis and the labels
+     * \param levels the edges of the shades
+     * \param title the title that will be written below the colorbar
+     * \param shade_labels \c true will put the labels at the edges of the shades, \c false will let PLplot choose them
+     * \param contour_color the index of the color of the lines separating the shades in PLplot's colormap, or 0 for none
+     * \param contour_width the width of the lines separating the shades, or 0.0 for none
+     */
+    void draw_plstream_colorbar(plstream *pls, ColormapPalette colormap, Gdk::RGBA color, const std::vector<double> &levels, const Glib::ustring &title,
+                                bool shade_labels, int contour_color, double contour_width);
+
     /** Allocates a an array of arrays
      *
      * All elements will be initialized to zero.
@@ -92,6 +134,25 @@ namespace Gtk {
      */
     void free_array2d(void **input, int nx);
 
+    /** Grow a rectangle of grid points so that it also contains another one
+     *
+     * Rectangles are stored as their first X- and Y-index, followed by one past their last X- and Y-index. An empty rectangle is simply replaced.
+     * \param region the rectangle that will be grown
+     * \param ix0 the first index of the other rectangle along the first dimension
+     * \param iy0 the first index of the other rectangle along the second dimension
+     * \param nx the extent of the other rectangle along the first dimension
+     * \param ny the extent of the other rectangle along the second dimension
+     */
+    void merge_grid_region(std::size_t region[4], std::size_t ix0, std::size_t iy0, std::size_t nx, std::size_t ny);
+
+    /** Find the grid points of a level of the display-resolution pyramid of a PlotDataSurface that depend on a rectangle of grid points of the data at full resolution
+     *
+     * \param region the rectangle of grid points at full resolution, in the format used by merge_grid_region()
+     * \param level the level of the pyramid
+     * \param level_region the rectangle of grid points of the level, in the format used by merge_grid_region()
+     */
+    void pyramid_grid_region(const std::size_t region[4], unsigned int level, std::size_t level_region[4]);
+
 #ifdef GTKMM_PLPLOT_BOOST_ENABLED
     /** Copy a Boost two dimensional multi array to dynamically allocated array of dynamically allocated arrays.
      *
@@ -0,0 +1,112 @@
+/*
+Copyright (C) 2017 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtkmm-plplot.h"
+#include <gtkmm/application.h>
+#include <glibmm/miscutils.h>
+#include <glibmm/main.h>
+#include <gtkmm/window.h>
+#include <gtkmm/grid.h>
+#include <gtkmm/label.h>
+#include <gtkmm/switch.h>
+#include <cmath>
+#include <random>
+
+#ifndef M_PI
+#define M_PI (3.14159265358979323846)
+#endif
+
+namespace Test13 {
+  class Window : public Gtk::Window {
+  private:
+    std::mt19937 gen;
+    std::normal_distribution<> noise;
+    double time;
+    Gtk::Grid grid;
+    Gtk::Label running_label;
+    Gtk::Switch running_switch;
+    Gtk::PLplot::PlotData2DStrip plot_data;
+    Gtk::PLplot::Plot2D plot;
+    Gtk::PLplot::Canvas canvas;
+
+    // a noisy sine, sampled every millisecond
+    bool push_datapoints() {
+      if (!running_switch.get_active())
+        return true;
+
+      double x[20], y[20];
+      for (int i = 0 ; i < 20 ; i++) {
+        time += 0.001;
+        x[i] = time;
+        y[i] = std::sin(2.0 * M_PI * time) + 0.1 * noise(gen);
+      }
+      // the oldest datapoints are dropped once the capacity has been reached
+      plot_data.add_datapoints(x, y, 20);
+      return true;
+    }
+  public:
+    Window() :
+      gen(1234),
+      noise(0, 1),
+      time(0.001),
+      running_label("Running"),
+      plot_data(5000, std::vector<double>{0.0, 0.001}, std::vector<double>{0.0, std::sin(2.0 * M_PI * 0.001)}, Gdk::RGBA("blue")),
+      plot(plot_data, "Time (s)", "Signal", "Strip chart of the last 5000 datapoints"),
+      canvas(plot) {
+
+      plot.hide_legend();
+
+      set_default_size(720, 580);
+      Gdk::Geometry geometry;
+      geometry.min_aspect = geometry.max_aspect = double(720)/double(580);
+      set_geometry_hints(*this, geometry, Gdk::HINT_ASPECT);
+      set_title("Gtkmm-PLplot test13");
+
+      grid.set_column_spacing(5);
+      grid.set_row_spacing(5);
+
+      running_label.set_halign(Gtk::ALIGN_END);
+      running_label.set_hexpand(true);
+      grid.attach(running_label, 0, 0, 1, 1);
+      running_switch.set_active(true);
+      running_switch.set_halign(Gtk::ALIGN_START);
+      running_switch.set_hexpand(true);
+      grid.attach(running_switch, 1, 0, 1, 1);
+
+      canvas.set_hexpand(true);
+      canvas.set_vexpand(true);
+      grid.attach(canvas, 0, 1, 2, 1);
+
+      // 20 new datapoints every 20 ms
+      Glib::signal_timeout().connect(sigc::mem_fun(*this, &Window::push_datapoints), 20);
+
+      add(grid);
+      set_border_width(10);
+      grid.show_all();
+    }
+    virtual ~Window() {}
+  };
+}
+
+int main(int argc, char **argv) {
+  Glib::set_application_name("gtkmm-plplot-test13");
+  Glib::RefPtr<Gtk::Application> app = Gtk::Application::create(argc, argv, "eu.tomschoonjans.gtkmm-plplot-test13");
+
+  Test13::Window *window = new Test13::Window();
+
+  return app->run(*window);
+}
@@ -0,0 +1,154 @@
+/*
+Copyright (C) 2017 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/* This test checks that dividing the grid into tiles does not change the contour lines:
+ * the lines traced and stitched with several tile sizes are compared with those traced using a single tile,
+ * both from scratch and after modifying a part of the grid. */
+
+#include "gtkmm-plplot.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI (3.14159265358979323846)
+#endif
+
+namespace Test14 {
+  // the contour lines of a single level, summarized in a way that does not depend on where closed lines start, or in which direction lines run
+  struct LevelSummary {
+    std::vector<std::pair<bool, double>> lines; // closed or not, and the length, of each line
+  };
+
+  static std::vector<LevelSummary> summarize(const std::vector<Gtk::PLplot::ContourLine> &lines, const std::vector<double> &levels) {
+    std::vector<LevelSummary> summary(levels.size());
+    for (auto &line : lines) {
+      auto level = std::find(levels.begin(), levels.end(), line.get_level()) - levels.begin();
+      const std::vector<double> &x = line.get_x();
+      const std::vector<double> &y = line.get_y();
+      double length = 0.0;
+      for (std::size_t i = 1 ; i < x.size() ; i++)
+        length += std::hypot(x[i] - x[i - 1], y[i] - y[i - 1]);
+      summary[level].lines.emplace_back(line.is_closed(), length);
+    }
+    for (auto &level : summary)
+      std::sort(level.lines.begin(), level.lines.end());
+    return summary;
+  }
+
+  static bool compare(const std::vector<LevelSummary> &reference, const std::vector<LevelSummary> &tiled, const std::vector<double> &levels, const char *description) {
+    bool rv = true;
+    for (std::size_t level = 0 ; level < levels.size() ; level++) {
+      const auto &a = reference[level].lines;
+      const auto &b = tiled[level].lines;
+      if (a.size() != b.size()) {
+        std::cerr << description << ": level " << levels[level] << " has " << b.size() << " lines instead of " << a.size() << std::endl;
+        rv = false;
+        continue;
+      }
+      for (std::size_t i = 0 ; i < a.size() ; i++) {
+        if (a[i].first != b[i].first || std::fabs(a[i].second - b[i].second) > 1E-9 * std::max(1.0, a[i].second)) {
+          std::cerr << description << ": level " << levels[level] << " line " << i << " differs" << std::endl;
+          rv = false;
+        }
+      }
+    }
+    return rv;
+  }
+
+  class Grid {
+  private:
+    std::vector<std::vector<double>> storage;
+  public:
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<const double *> z;
+
+    Grid(std::size_t nx, std::size_t ny) : storage(nx, std::vector<double>(ny)), x(nx), y(ny), z(nx) {
+      for (std::size_t i = 0 ; i < nx ; i++)
+        x[i] = -3.0 + 6.0 * i / (nx - 1);
+      for (std::size_t j = 0 ; j < ny ; j++)
+        y[j] = -2.0 + 4.0 * j / (ny - 1);
+      for (std::size_t i = 0 ; i < nx ; i++) {
+        for (std::size_t j = 0 ; j < ny ; j++) {
+          storage[i][j] = std::sin(2.0 * x[i]) * std::cos(3.0 * y[j]) + std::exp(-x[i] * x[i] - y[j] * y[j]);
+        }
+        z[i] = storage[i].data();
+      }
+      // a hole of undefined values, which interrupts the contour lines
+      for (std::size_t i = nx / 3 ; i < nx / 3 + 5 ; i++)
+        for (std::size_t j = ny / 2 ; j < ny / 2 + 7 ; j++)
+          storage[i][j] = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // add a bump to a rectangle of grid points
+    void modify(std::size_t ix0, std::size_t iy0, std::size_t nx, std::size_t ny) {
+      for (std::size_t i = ix0 ; i < ix0 + nx ; i++)
+        for (std::size_t j = iy0 ; j < iy0 + ny ; j++)
+          storage[i][j] += 0.5 * std::sin(M_PI * (i - ix0) / (nx - 1)) * std::sin(M_PI * (j - iy0) / (ny - 1));
+    }
+  };
+}
+
+int main(int argc, char **argv) {
+  using namespace Test14;
+
+  const std::size_t nx = 301, ny = 203;
+  Grid grid(nx, ny);
+
+  std::vector<double> levels;
+  for (int i = 0 ; i <= 20 ; i++)
+    levels.push_back(-1.5 + 3.5 * i / 20.0);
+
+  // a single tile covers the whole grid
+  Gtk::PLplot::ContourTiles untiled(std::max(nx, ny));
+  untiled.reset(nx, ny, levels);
+  auto reference = summarize(untiled.get_lines(grid.z.data(), grid.x, grid.y), levels);
+
+  bool ok = true;
+
+  const std::size_t tile_sizes[] = {2, 5, 16, 64};
+  std::vector<Gtk::PLplot::ContourTiles *> tiled;
+  for (auto tile_size : tile_sizes) {
+    auto tiles = new Gtk::PLplot::ContourTiles(tile_size);
+    tiles->reset(nx, ny, levels);
+    ok &= compare(reference, summarize(tiles->get_lines(grid.z.data(), grid.x, grid.y), levels), levels,
+                  ("tile size " + std::to_string(tile_size)).c_str());
+    tiled.push_back(tiles);
+  }
+
+  // modify a part of the grid: the tiled caches only trace the tiles touching it again
+  const std::size_t ix0 = 100, iy0 = 60, region_nx = 40, region_ny = 30;
+  grid.modify(ix0, iy0, region_nx, region_ny);
+  reference = summarize(Gtk::PLplot::trace_contour_lines(grid.z.data(), grid.x, grid.y, levels), levels);
+
+  for (std::size_t i = 0 ; i < tiled.size() ; i++) {
+    tiled[i]->invalidate(ix0, iy0, region_nx, region_ny);
+    ok &= compare(reference, summarize(tiled[i]->get_lines(grid.z.data(), grid.x, grid.y), levels), levels,
+                  ("modified grid, tile size " + std::to_string(tile_sizes[i])).c_str());
+    delete tiled[i];
+  }
+
+  std::cout << (ok ? "tiled and untiled contour lines are identical" : "tiled and untiled contour lines differ") << std::endl;
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
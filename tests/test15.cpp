@@ -0,0 +1,122 @@
+/*
+Copyright (C) 2017 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtkmm-plplot.h"
+#include <gtkmm/application.h>
+#include <glibmm/miscutils.h>
+#include <gtkmm/window.h>
+#include <gtkmm/grid.h>
+#include <gtkmm/label.h>
+#include <gtkmm/comboboxtext.h>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace Test15 {
+  class Window : public Gtk::Window {
+  private:
+    Gtk::Grid grid;
+    Gtk::Label rendering_label;
+    Gtk::ComboBoxText rendering_combo;
+    Gtk::Label colormap_label;
+    Gtk::ComboBoxText colormap_combo;
+    Gtk::PLplot::PlotDataSurface *plot_data;
+    Gtk::PLplot::PlotContourShades *plot;
+    Gtk::PLplot::Canvas canvas;
+
+    // a grid with many more points than the plot has pixels
+    static Gtk::PLplot::PlotDataSurface *create_data(std::size_t nx, std::size_t ny) {
+      std::vector<double> x(nx), y(ny), z(nx * ny);
+      for (std::size_t i = 0 ; i < nx ; i++)
+        x[i] = -4.0 + 8.0 * i / (nx - 1);
+      for (std::size_t j = 0 ; j < ny ; j++)
+        y[j] = -3.0 + 6.0 * j / (ny - 1);
+      for (std::size_t i = 0 ; i < nx ; i++)
+        for (std::size_t j = 0 ; j < ny ; j++)
+          z[i * ny + j] = std::sin(x[i] * y[j]) * std::exp(-0.1 * (x[i] * x[i] + y[j] * y[j]));
+      return Gtk::manage(new Gtk::PLplot::PlotDataSurface(x, y, std::move(z)));
+    }
+  public:
+    Window() :
+      rendering_label("Rendering"),
+      colormap_label("Colormap"),
+      plot_data(create_data(2000, 1500)),
+      plot(Gtk::manage(new Gtk::PLplot::PlotContourShades(*plot_data, "X-axis", "Y-axis", "sin(xy) exp(-(x#u2#d + y#u2#d)/10)", 21))),
+      canvas(*plot) {
+
+      // draw the shades as a single image: polygons would take a long time with this many grid points
+      plot->set_shades_rendering(Gtk::PLplot::SHADES_RASTER);
+
+      set_default_size(720, 580);
+      Gdk::Geometry geometry;
+      geometry.min_aspect = geometry.max_aspect = double(720)/double(580);
+      set_geometry_hints(*this, geometry, Gdk::HINT_ASPECT);
+      set_title("Gtkmm-PLplot test15");
+
+      grid.set_column_spacing(5);
+      grid.set_row_spacing(5);
+
+      // switching between both renderings shows that the image uses the same colors as the polygons and the colorbar
+      rendering_label.set_halign(Gtk::ALIGN_END);
+      rendering_label.set_hexpand(true);
+      grid.attach(rendering_label, 0, 0, 1, 1);
+      rendering_combo.append("Polygons");
+      rendering_combo.append("Raster image");
+      rendering_combo.set_active(plot->get_shades_rendering());
+      rendering_combo.set_halign(Gtk::ALIGN_START);
+      rendering_combo.signal_changed().connect([this](){
+        plot->set_shades_rendering(static_cast<Gtk::PLplot::ShadesRendering>(rendering_combo.get_active_row_number()));
+      });
+      grid.attach(rendering_combo, 1, 0, 1, 1);
+
+      colormap_label.set_halign(Gtk::ALIGN_END);
+      colormap_label.set_hexpand(true);
+      grid.attach(colormap_label, 2, 0, 1, 1);
+      colormap_combo.append("Default");
+      colormap_combo.append("Blue - Red");
+      colormap_combo.append("Blue - Yellow");
+      colormap_combo.append("Gray");
+      colormap_combo.append("High frequencies");
+      colormap_combo.append("Low frequencies");
+      colormap_combo.append("Radar");
+      colormap_combo.set_active(plot->get_colormap_palette());
+      colormap_combo.set_halign(Gtk::ALIGN_START);
+      colormap_combo.signal_changed().connect([this](){
+        plot->set_colormap_palette(static_cast<Gtk::PLplot::ColormapPalette>(colormap_combo.get_active_row_number()));
+      });
+      grid.attach(colormap_combo, 3, 0, 1, 1);
+
+      canvas.set_hexpand(true);
+      canvas.set_vexpand(true);
+      grid.attach(canvas, 0, 1, 4, 1);
+
+      add(grid);
+      set_border_width(10);
+      grid.show_all();
+    }
+    virtual ~Window() {}
+  };
+}
+
+int main(int argc, char **argv) {
+  Glib::set_application_name("gtkmm-plplot-test15");
+  Glib::RefPtr<Gtk::Application> app = Gtk::Application::create(argc, argv, "eu.tomschoonjans.gtkmm-plplot-test15");
+
+  Test15::Window *window = new Test15::Window();
+
+  return app->run(*window);
+}
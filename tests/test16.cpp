@@ -0,0 +1,172 @@
+/*
+Copyright (C) 2017 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtkmm-plplot.h"
+#include <gtkmm/application.h>
+#include <glibmm/miscutils.h>
+#include <glibmm/main.h>
+#include <gtkmm/window.h>
+#include <gtkmm/grid.h>
+#include <gtkmm/label.h>
+#include <gtkmm/comboboxtext.h>
+#include <gtkmm/switch.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI (3.14159265358979323846)
+#endif
+
+#define TEST16_NX 600
+#define TEST16_NY 400
+#define TEST16_BUMP_RADIUS 30
+
+namespace Test16 {
+  class Window : public Gtk::Window {
+  private:
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> background;
+    std::vector<double> values;
+    double angle;
+    std::size_t bump_i;
+    std::size_t bump_j;
+    Gtk::Grid grid;
+    Gtk::Label running_label;
+    Gtk::Switch running_switch;
+    Gtk::Label rendering_label;
+    Gtk::ComboBoxText rendering_combo;
+    Gtk::PLplot::PlotDataSurface plot_data;
+    Gtk::PLplot::PlotContourShades plot;
+    Gtk::PLplot::Canvas canvas;
+
+    static std::vector<double> create_grid(std::size_t n, double first, double last) {
+      std::vector<double> rv(n);
+      for (std::size_t i = 0 ; i < n ; i++)
+        rv[i] = first + (last - first) * i / (n - 1);
+      return rv;
+    }
+
+    // a pattern that spans [-1, 1], with its extremes at the corners, where the bump never comes
+    std::vector<double> create_background() {
+      std::vector<double> rv(TEST16_NX * TEST16_NY);
+      for (std::size_t i = 0 ; i < TEST16_NX ; i++)
+        for (std::size_t j = 0 ; j < TEST16_NY ; j++)
+          rv[i * TEST16_NY + j] = 0.5 * std::cos(x[i]) * std::cos(y[j]);
+      rv.front() = -1.0;
+      rv.back() = 1.0;
+      return rv;
+    }
+
+    // move the bump along a circle, replacing only the rectangle of grid points that covers both its old and its new position.
+    // as the extremes of the data do not change, the plot only needs to trace and render that part of the grid again
+    bool move_bump() {
+      if (!running_switch.get_active())
+        return true;
+
+      angle += 0.05;
+      const std::size_t new_i = TEST16_NX / 2 + std::lround(0.3 * TEST16_NX * std::cos(angle));
+      const std::size_t new_j = TEST16_NY / 2 + std::lround(0.3 * TEST16_NY * std::sin(angle));
+
+      const std::size_t ix0 = std::min(bump_i, new_i) - TEST16_BUMP_RADIUS;
+      const std::size_t iy0 = std::min(bump_j, new_j) - TEST16_BUMP_RADIUS;
+      const std::size_t nx = std::max(bump_i, new_i) + TEST16_BUMP_RADIUS + 1 - ix0;
+      const std::size_t ny = std::max(bump_j, new_j) + TEST16_BUMP_RADIUS + 1 - iy0;
+
+      values.resize(nx * ny);
+      for (std::size_t i = 0 ; i < nx ; i++) {
+        for (std::size_t j = 0 ; j < ny ; j++) {
+          const double di = static_cast<double>(ix0 + i) - new_i;
+          const double dj = static_cast<double>(iy0 + j) - new_j;
+          const double r2 = (di * di + dj * dj) / (TEST16_BUMP_RADIUS * TEST16_BUMP_RADIUS);
+          values[i * ny + j] = background[(ix0 + i) * TEST16_NY + iy0 + j] + (r2 < 1.0 ? 0.5 * std::cos(0.5 * M_PI * std::sqrt(r2)) : 0.0);
+        }
+      }
+      plot_data.update_region(ix0, iy0, nx, ny, values.data());
+
+      bump_i = new_i;
+      bump_j = new_j;
+      return true;
+    }
+  public:
+    Window() :
+      x(create_grid(TEST16_NX, -M_PI, M_PI)),
+      y(create_grid(TEST16_NY, -M_PI, M_PI)),
+      background(create_background()),
+      angle(0.0),
+      bump_i(TEST16_NX / 2 + std::lround(0.3 * TEST16_NX)),
+      bump_j(TEST16_NY / 2),
+      running_label("Running"),
+      rendering_label("Rendering"),
+      plot_data(x, y, background),
+      plot(plot_data, "X-axis", "Y-axis", "A bump moving over a fixed background", 11),
+      canvas(plot) {
+
+      plot.set_shades_rendering(Gtk::PLplot::SHADES_RASTER);
+      plot.hide_labels();
+
+      set_default_size(720, 580);
+      Gdk::Geometry geometry;
+      geometry.min_aspect = geometry.max_aspect = double(720)/double(580);
+      set_geometry_hints(*this, geometry, Gdk::HINT_ASPECT);
+      set_title("Gtkmm-PLplot test16");
+
+      grid.set_column_spacing(5);
+      grid.set_row_spacing(5);
+
+      running_label.set_halign(Gtk::ALIGN_END);
+      running_label.set_hexpand(true);
+      grid.attach(running_label, 0, 0, 1, 1);
+      running_switch.set_active(true);
+      running_switch.set_halign(Gtk::ALIGN_START);
+      grid.attach(running_switch, 1, 0, 1, 1);
+
+      rendering_label.set_halign(Gtk::ALIGN_END);
+      rendering_label.set_hexpand(true);
+      grid.attach(rendering_label, 2, 0, 1, 1);
+      rendering_combo.append("Polygons");
+      rendering_combo.append("Raster image");
+      rendering_combo.set_active(plot.get_shades_rendering());
+      rendering_combo.set_halign(Gtk::ALIGN_START);
+      rendering_combo.signal_changed().connect([this](){
+        plot.set_shades_rendering(static_cast<Gtk::PLplot::ShadesRendering>(rendering_combo.get_active_row_number()));
+      });
+      grid.attach(rendering_combo, 3, 0, 1, 1);
+
+      canvas.set_hexpand(true);
+      canvas.set_vexpand(true);
+      grid.attach(canvas, 0, 1, 4, 1);
+
+      Glib::signal_timeout().connect(sigc::mem_fun(*this, &Window::move_bump), 40);
+
+      add(grid);
+      set_border_width(10);
+      grid.show_all();
+    }
+    virtual ~Window() {}
+  };
+}
+
+int main(int argc, char **argv) {
+  Glib::set_application_name("gtkmm-plplot-test16");
+  Glib::RefPtr<Gtk::Application> app = Gtk::Application::create(argc, argv, "eu.tomschoonjans.gtkmm-plplot-test16");
+
+  Test16::Window *window = new Test16::Window();
+
+  return app->run(*window);
+}
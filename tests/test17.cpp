@@ -0,0 +1,141 @@
+/*
+Copyright (C) 2017 Tom Schoonjans
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtkmm-plplot.h"
+#include <gtkmm/application.h>
+#include <glibmm/miscutils.h>
+#include <glibmm/main.h>
+#include <gtkmm/window.h>
+#include <gtkmm/grid.h>
+#include <gtkmm/label.h>
+#include <gtkmm/comboboxtext.h>
+#include <gtkmm/switch.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI (3.14159265358979323846)
+#endif
+
+#define TEST17_NBINS 512
+#define TEST17_ROWS_PER_TICK 2
+
+namespace Test17 {
+  class Window : public Gtk::Window {
+  private:
+    std::mt19937 gen;
+    std::uniform_real_distribution<> noise;
+    double time;
+    std::vector<double> rows;
+    Gtk::Grid grid;
+    Gtk::Label running_label;
+    Gtk::Switch running_switch;
+    Gtk::Label colormap_label;
+    Gtk::ComboBoxText colormap_combo;
+    Gtk::PLplot::PlotDataWaterfall plot_data;
+    Gtk::PLplot::PlotWaterfall plot;
+    Gtk::PLplot::Canvas canvas;
+
+    // the spectrum of a tone whose frequency sweeps up and down, on top of a noise floor, in dB
+    bool push_rows() {
+      if (!running_switch.get_active())
+        return true;
+
+      for (int row = 0 ; row < TEST17_ROWS_PER_TICK ; row++) {
+        time += plot_data.get_x_step();
+        const double tone = 250.0 + 150.0 * std::sin(2.0 * M_PI * time / 10.0);
+        for (int bin = 0 ; bin < TEST17_NBINS ; bin++) {
+          const double frequency = 500.0 * bin / (TEST17_NBINS - 1);
+          const double distance = (frequency - tone) / 5.0;
+          rows[row * TEST17_NBINS + bin] = 10.0 * std::log10(std::exp(-distance * distance) + 1E-5 * noise(gen) + 1E-6);
+        }
+      }
+      // the plot is updated only once for both rows
+      plot_data.push_rows(rows.data(), TEST17_ROWS_PER_TICK);
+      return true;
+    }
+  public:
+    Window() :
+      gen(1234),
+      noise(0.0, 1.0),
+      time(0.0),
+      rows(TEST17_ROWS_PER_TICK * TEST17_NBINS),
+      running_label("Running"),
+      colormap_label("Colormap"),
+      plot_data(1000, TEST17_NBINS, 0.0, 500.0, 0.02),
+      plot(plot_data, -60.0, 0.0, "Time (s)", "Frequency (Hz)", "Spectrogram: zoom in to stop scrolling, double-click to resume"),
+      canvas(plot) {
+
+      plot.set_colorbar_title("dB");
+
+      set_default_size(720, 580);
+      Gdk::Geometry geometry;
+      geometry.min_aspect = geometry.max_aspect = double(720)/double(580);
+      set_geometry_hints(*this, geometry, Gdk::HINT_ASPECT);
+      set_title("Gtkmm-PLplot test17");
+
+      grid.set_column_spacing(5);
+      grid.set_row_spacing(5);
+
+      running_label.set_halign(Gtk::ALIGN_END);
+      running_label.set_hexpand(true);
+      grid.attach(running_label, 0, 0, 1, 1);
+      running_switch.set_active(true);
+      running_switch.set_halign(Gtk::ALIGN_START);
+      grid.attach(running_switch, 1, 0, 1, 1);
+
+      colormap_label.set_halign(Gtk::ALIGN_END);
+      colormap_label.set_hexpand(true);
+      grid.attach(colormap_label, 2, 0, 1, 1);
+      colormap_combo.append("Default");
+      colormap_combo.append("Blue - Red");
+      colormap_combo.append("Blue - Yellow");
+      colormap_combo.append("Gray");
+      colormap_combo.append("High frequencies");
+      colormap_combo.append("Low frequencies");
+      colormap_combo.append("Radar");
+      colormap_combo.set_active(plot.get_colormap_palette());
+      colormap_combo.set_halign(Gtk::ALIGN_START);
+      colormap_combo.signal_changed().connect([this](){
+        plot.set_colormap_palette(static_cast<Gtk::PLplot::ColormapPalette>(colormap_combo.get_active_row_number()));
+      });
+      grid.attach(colormap_combo, 3, 0, 1, 1);
+
+      canvas.set_hexpand(true);
+      canvas.set_vexpand(true);
+      grid.attach(canvas, 0, 1, 4, 1);
+
+      // 100 rows per second
+      Glib::signal_timeout().connect(sigc::mem_fun(*this, &Window::push_rows), 20);
+
+      add(grid);
+      set_border_width(10);
+      grid.show_all();
+    }
+    virtual ~Window() {}
+  };
+}
+
+int main(int argc, char **argv) {
+  Glib::set_application_name("gtkmm-plplot-test17");
+  Glib::RefPtr<Gtk::Application> app = Gtk::Application::create(argc, argv, "eu.tomschoonjans.gtkmm-plplot-test17");
+
+  Test17::Window *window = new Test17::Window();
+
+  return app->run(*window);
+}